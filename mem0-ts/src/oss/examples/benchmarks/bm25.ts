@@ -0,0 +1,101 @@
+/**
+ * BM25Index vs. rebuilding the naive BM25 model per query.
+ *
+ * The naive path is what a store without an index had to do: recompute
+ * document frequencies over the whole corpus, count term frequency with a
+ * linear scan per query term, and sort every document. The index pays for
+ * postings on add and only scores documents that share a query term.
+ *
+ * Usage: npx ts-node src/oss/examples/benchmarks/bm25.ts [documents]
+ */
+import { BM25Index } from "../../src/utils/bm25";
+import { lemmatizeForBm25 } from "../../src/utils/lemmatization";
+
+const QUERIES = 200;
+const TOP_K = 10;
+
+const WORDS = (
+  "alice bob berlin lisbon cello guitar espresso tea running hiking dog " +
+  "cat project falcon deadline meeting doctor allergy peanut vegetarian " +
+  "flight hotel birthday gift book movie series python rust garden"
+).split(" ");
+
+function randomText(words: number): string {
+  return Array.from(
+    { length: words },
+    () => WORDS[Math.floor(Math.random() * WORDS.length)],
+  ).join(" ");
+}
+
+function tokenize(text: string): string[] {
+  return lemmatizeForBm25(text).split(/\s+/).filter(Boolean);
+}
+
+function naiveSearch(documents: string[][], query: string[]): number[] {
+  const k1 = 1.5;
+  const b = 0.75;
+  const N = documents.length;
+  const avg = documents.reduce((sum, d) => sum + d.length, 0) / N;
+  const df = new Map<string, number>();
+  for (const doc of documents) {
+    for (const term of new Set(doc)) df.set(term, (df.get(term) || 0) + 1);
+  }
+  const scores = documents.map((doc, i) => {
+    let score = 0;
+    for (const term of query) {
+      const tf = doc.filter((t) => t === term).length;
+      const n = df.get(term) || 0;
+      const idf = Math.log((N - n + 0.5) / (n + 0.5) + 1);
+      score +=
+        (idf * tf * (k1 + 1)) / (tf + k1 * (1 - b + (b * doc.length) / avg));
+    }
+    return { i, score };
+  });
+  return scores
+    .sort((x, y) => y.score - x.score)
+    .slice(0, TOP_K)
+    .map((s) => s.i);
+}
+
+export function benchmarkBm25(documents = 20_000) {
+  const corpus = Array.from({ length: documents }, () =>
+    tokenize(randomText(12 + Math.floor(Math.random() * 20))),
+  );
+  const queries = Array.from({ length: QUERIES }, () =>
+    tokenize(randomText(4)),
+  );
+
+  let start = performance.now();
+  const index = new BM25Index();
+  corpus.forEach((terms, i) => index.add(`m${i}`, terms));
+  const buildMs = performance.now() - start;
+
+  start = performance.now();
+  for (const query of queries) index.search(query, TOP_K);
+  const indexedMs = (performance.now() - start) / QUERIES;
+
+  // The naive model is rebuilt per query; a handful is enough to measure.
+  const naiveRuns = Math.min(QUERIES, 10);
+  start = performance.now();
+  for (const query of queries.slice(0, naiveRuns)) naiveSearch(corpus, query);
+  const naiveMs = (performance.now() - start) / naiveRuns;
+
+  start = performance.now();
+  for (let i = 0; i < 1000; i++) {
+    index.remove(`m${i}`);
+    index.add(`m${i}`, corpus[i]);
+  }
+  const churnUs = ((performance.now() - start) / 1000) * 1000;
+
+  console.log(`documents=${documents} queries=${QUERIES} topK=${TOP_K}`);
+  console.log(`index build      ${buildMs.toFixed(0)} ms`);
+  console.log(`indexed search   ${indexedMs.toFixed(2)} ms/query`);
+  console.log(`naive rebuild    ${naiveMs.toFixed(2)} ms/query`);
+  console.log(`speedup          ${(naiveMs / indexedMs).toFixed(1)}x`);
+  console.log(`remove+add       ${churnUs.toFixed(1)} us/doc`);
+}
+
+if (require.main === module) {
+  const documents = Number(process.argv[2]) || 20_000;
+  benchmarkBm25(documents);
+}
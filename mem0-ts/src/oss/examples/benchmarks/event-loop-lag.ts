@@ -0,0 +1,104 @@
+/**
+ * Event-loop lag under a mixed add/search load, with and without the
+ * worker-thread pool (`MemoryConfig.workerThreads`).
+ *
+ * Each "add" runs the CPU stages of add() (lemmatization + entity
+ * extraction) over a long conversation; each "search" runs a vector scan
+ * over the SQLite store. Lag is sampled with perf_hooks while both run
+ * concurrently.
+ *
+ * Usage: npx ts-node src/oss/examples/benchmarks/event-loop-lag.ts [vectors]
+ */
+import os from "os";
+import { monitorEventLoopDelay } from "perf_hooks";
+import { CpuWorkerPool, runOnPool } from "../../src/utils/cpu_pool";
+import { MemoryVectorStore } from "../../src/vector_stores/memory";
+
+const DIM = 256;
+const ROUNDS = 20;
+const CONCURRENCY = 4;
+
+const SENTENCES = [
+  "Alice moved to Berlin last spring and started working at Acme Robotics.",
+  'Her team is shipping a project called "Blue Falcon" before the summer.',
+  "She prefers running along the river on weekends with her dog Max.",
+  "Bob recommended the book Thinking, Fast and Slow during the offsite.",
+];
+
+function conversation(lines: number): string[] {
+  return Array.from({ length: lines }, (_, i) => SENTENCES[i % 4]);
+}
+
+async function runLoad(pool: CpuWorkerPool | undefined, vectors: number) {
+  const store = new MemoryVectorStore({
+    dimension: DIM,
+    dbPath: ":memory:",
+    workerPool: pool,
+  });
+  const batch = 5000;
+  for (let offset = 0; offset < vectors; offset += batch) {
+    const n = Math.min(batch, vectors - offset);
+    await store.insert(
+      Array.from({ length: n }, () =>
+        Array.from({ length: DIM }, () => Math.random()),
+      ),
+      Array.from({ length: n }, (_, i) => `m${offset + i}`),
+      Array.from({ length: n }, () => ({ data: "x", user_id: "u1" })),
+    );
+  }
+
+  const texts = conversation(400);
+  const query = Array.from({ length: DIM }, () => Math.random());
+
+  const histogram = monitorEventLoopDelay({ resolution: 5 });
+  histogram.enable();
+  const start = performance.now();
+
+  // Yield between rounds like separate requests would; inline tasks resolve
+  // synchronously and would otherwise never let the lag timer fire.
+  const tick = () => new Promise((resolve) => setImmediate(resolve));
+  const worker = async () => {
+    for (let i = 0; i < ROUNDS; i++) {
+      await tick();
+      await Promise.all([
+        runOnPool(pool, { type: "lemmatize", texts }),
+        runOnPool(pool, { type: "extractEntities", texts }),
+        store.search(query, 10, { user_id: "u1" }),
+      ]);
+    }
+  };
+  await Promise.all(Array.from({ length: CONCURRENCY }, worker));
+  await tick();
+
+  histogram.disable();
+  return {
+    seconds: (performance.now() - start) / 1000,
+    p50: histogram.percentile(50) / 1e6,
+    p99: histogram.percentile(99) / 1e6,
+    max: histogram.max / 1e6,
+  };
+}
+
+export async function benchmarkEventLoopLag(vectors = 50_000) {
+  const threads = Math.max(1, os.cpus().length - 1);
+  const report = (label: string, r: Awaited<ReturnType<typeof runLoad>>) =>
+    console.log(
+      `${label.padEnd(16)} wall=${r.seconds.toFixed(1)}s ` +
+        `lag p50=${r.p50.toFixed(1)}ms p99=${r.p99.toFixed(1)}ms ` +
+        `max=${r.max.toFixed(1)}ms`,
+    );
+
+  report("inline", await runLoad(undefined, vectors));
+
+  const pool = new CpuWorkerPool(threads);
+  try {
+    report(`workers (${threads})`, await runLoad(pool, vectors));
+  } finally {
+    await pool.close();
+  }
+}
+
+if (require.main === module) {
+  const vectors = Number(process.argv[2]) || 50_000;
+  benchmarkEventLoopLag(vectors);
+}
@@ -0,0 +1,129 @@
+/**
+ * Import benchmark for verbatim adds (`add(..., { infer: false })`).
+ *
+ * Compares the batched write path used by `createMemories` (one
+ * `MemoryVectorStore.insert` transaction on a cached statement plus one
+ * `batchAddHistory` transaction) with the previous per-text path (compile the
+ * upsert, run it in its own transaction, then write one history row).
+ * Embeddings are precomputed so only the local write path is measured.
+ *
+ * Usage: npx ts-node src/oss/examples/benchmarks/import.ts [rows] [batch]
+ */
+import fs from "fs";
+import os from "os";
+import path from "path";
+import { randomUUID } from "crypto";
+import Database from "better-sqlite3";
+import { SQLiteManager } from "../../src/storage/SQLiteManager";
+import { MemoryVectorStore } from "../../src/vector_stores/memory";
+
+const DIM = 256;
+
+interface Row {
+  id: string;
+  vector: number[];
+  payload: Record<string, any>;
+}
+
+function makeRows(count: number): Row[] {
+  const createdAt = new Date().toISOString();
+  return Array.from({ length: count }, (_, i) => ({
+    id: randomUUID(),
+    vector: Array.from({ length: DIM }, () => Math.random()),
+    payload: {
+      data: `imported fact number ${i} about the user`,
+      textLemmatized: `import fact number ${i} about user`,
+      user_id: "importer",
+      createdAt,
+    },
+  }));
+}
+
+/** The pre-batching insert: compile the upsert and commit once per text. */
+function previousInsert(db: Database.Database, row: Row): void {
+  const stmt = db.prepare(
+    `INSERT INTO vectors (id, vector, payload) VALUES (?, ?, ?)
+     ON CONFLICT(id) DO UPDATE SET vector = excluded.vector, payload = excluded.payload`,
+  );
+  db.transaction(() => {
+    stmt.run(
+      row.id,
+      Buffer.from(new Float32Array(row.vector).buffer),
+      JSON.stringify(row.payload),
+    );
+  })();
+}
+
+async function run(
+  label: string,
+  count: number,
+  write: (store: MemoryVectorStore, history: SQLiteManager) => Promise<void>,
+): Promise<number> {
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mem0-bench-"));
+  const store = new MemoryVectorStore({
+    collectionName: "bench",
+    dimension: DIM,
+    dbPath: path.join(dir, "vector_store.db"),
+  });
+  const history = new SQLiteManager(path.join(dir, "history.db"));
+
+  const start = performance.now();
+  await write(store, history);
+  const seconds = (performance.now() - start) / 1000;
+  const rate = count / seconds;
+  console.log(
+    `${label.padEnd(24)} ${rate.toFixed(0).padStart(8)} rows/s ` +
+      `(${count} rows in ${seconds.toFixed(2)}s)`,
+  );
+
+  history.close();
+  fs.rmSync(dir, { recursive: true, force: true });
+  return rate;
+}
+
+export async function benchmarkImport(count = 20_000, batch = 100) {
+  const rows = makeRows(count);
+
+  const previous = await run("per text (previous)", count, async (store, h) => {
+    const db = (store as any).db as Database.Database;
+    for (const row of rows) {
+      previousInsert(db, row);
+      await h.addHistory(
+        row.id,
+        null,
+        row.payload.data,
+        "ADD",
+        row.payload.createdAt,
+      );
+    }
+  });
+
+  const label = `batched (${batch} per add)`;
+  const batched = await run(label, count, async (store, history) => {
+    for (let offset = 0; offset < count; offset += batch) {
+      const chunk = rows.slice(offset, offset + batch);
+      await store.insert(
+        chunk.map((r) => r.vector),
+        chunk.map((r) => r.id),
+        chunk.map((r) => r.payload),
+      );
+      await history.batchAddHistory(
+        chunk.map((r) => ({
+          memoryId: r.id,
+          previousValue: null,
+          newValue: r.payload.data,
+          action: "ADD",
+          createdAt: r.payload.createdAt,
+        })),
+      );
+    }
+  });
+
+  console.log(`speedup: ${(batched / previous).toFixed(1)}x`);
+}
+
+if (require.main === module) {
+  const count = Number(process.argv[2]) || 20_000;
+  const batch = Number(process.argv[3]) || 100;
+  benchmarkImport(count, batch);
+}
@@ -0,0 +1,133 @@
+/**
+ * Keyword search benchmark for the SQLite-backed MemoryVectorStore.
+ *
+ * Compares the FTS5 index used by `keywordSearch` with the previous
+ * full-table scan (parse every payload, tokenize every document, score in JS).
+ *
+ * Usage: npx ts-node src/oss/examples/benchmarks/keyword-search.ts [count]
+ */
+import fs from "fs";
+import os from "os";
+import path from "path";
+import Database from "better-sqlite3";
+import { MemoryVectorStore } from "../../src/vector_stores/memory";
+
+const DIM = 8;
+const BATCH = 5000;
+const QUERIES = 50;
+
+const VOCAB = Array.from({ length: 5000 }, (_, i) => `term${i}`);
+
+function randomText(words: number): string {
+  const out: string[] = [];
+  for (let i = 0; i < words; i++) {
+    // Skewed draw so some terms are common and most are rare, like real text
+    const idx = Math.floor(Math.pow(Math.random(), 3) * VOCAB.length);
+    out.push(VOCAB[idx]);
+  }
+  return out.join(" ");
+}
+
+function percentile(samples: number[], p: number): number {
+  const sorted = [...samples].sort((a, b) => a - b);
+  return sorted[Math.min(sorted.length - 1, Math.floor(p * sorted.length))];
+}
+
+/** The pre-index implementation: read and score every row in JS. */
+function fullScan(dbPath: string, query: string, topK: number): number {
+  const db = new Database(dbPath, { readonly: true });
+  const terms = query.toLowerCase().split(/\s+/).filter(Boolean);
+  const rows = db.prepare(`SELECT id, payload FROM vectors`).all() as any[];
+  const docs = rows.map((row) => {
+    const payload = JSON.parse(row.payload);
+    const text: string = payload.textLemmatized || payload.data || "";
+    return { id: row.id, tokens: text.toLowerCase().split(/\s+/) };
+  });
+  db.close();
+
+  const N = docs.length;
+  const avg = docs.reduce((sum, d) => sum + d.tokens.length, 0) / N;
+  const idf = new Map<string, number>();
+  for (const term of terms) {
+    const df = docs.filter((d) => d.tokens.includes(term)).length;
+    idf.set(term, Math.log((N - df + 0.5) / (df + 0.5) + 1));
+  }
+  const scored = docs.map((d) => {
+    let score = 0;
+    for (const term of terms) {
+      const tf = d.tokens.filter((t) => t === term).length;
+      const norm = 0.25 + (0.75 * d.tokens.length) / avg; // k1=1.5, b=0.75
+      score += (idf.get(term)! * tf * 2.5) / (tf + 1.5 * norm);
+    }
+    return { id: d.id, score };
+  });
+  scored.sort((a, b) => b.score - a.score);
+  return scored.slice(0, topK).length;
+}
+
+export async function benchmarkKeywordSearch(count = 100_000) {
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), "mem0-bench-"));
+  const dbPath = path.join(dir, "vector_store.db");
+  const store = new MemoryVectorStore({
+    collectionName: "bench",
+    dimension: DIM,
+    dbPath,
+  });
+
+  console.log(`Inserting ${count} memories...`);
+  const insertStart = performance.now();
+  for (let offset = 0; offset < count; offset += BATCH) {
+    const n = Math.min(BATCH, count - offset);
+    const vectors = Array.from({ length: n }, () =>
+      Array.from({ length: DIM }, () => Math.random()),
+    );
+    const ids = Array.from({ length: n }, (_, i) => `mem-${offset + i}`);
+    const payloads = ids.map((_, i) => ({
+      data: "benchmark memory",
+      textLemmatized: randomText(12),
+      user_id: `user-${(offset + i) % 100}`,
+    }));
+    await store.insert(vectors, ids, payloads);
+  }
+  console.log(
+    `Insert: ${((performance.now() - insertStart) / 1000).toFixed(1)}s`,
+  );
+
+  const queries = Array.from({ length: QUERIES }, () => randomText(3));
+
+  const indexed: number[] = [];
+  const filtered: number[] = [];
+  for (const q of queries) {
+    let t = performance.now();
+    await store.keywordSearch(q, 60);
+    indexed.push(performance.now() - t);
+
+    t = performance.now();
+    await store.keywordSearch(q, 60, { user_id: "user-7" });
+    filtered.push(performance.now() - t);
+  }
+
+  // The full scan is orders of magnitude slower; a handful of runs is enough.
+  const scan: number[] = [];
+  for (const q of queries.slice(0, 3)) {
+    const t = performance.now();
+    fullScan(dbPath, q, 60);
+    scan.push(performance.now() - t);
+  }
+
+  const report = (label: string, samples: number[]) =>
+    console.log(
+      `${label.padEnd(24)} p50=${percentile(samples, 0.5).toFixed(2)}ms ` +
+        `p95=${percentile(samples, 0.95).toFixed(2)}ms (n=${samples.length})`,
+    );
+  report("fts5", indexed);
+  report("fts5 + user filter", filtered);
+  report("full scan (previous)", scan);
+
+  fs.rmSync(dir, { recursive: true, force: true });
+}
+
+if (require.main === module) {
+  const count = Number(process.argv[2]) || 100_000;
+  benchmarkKeywordSearch(count);
+}
@@ -165,6 +165,8 @@ export class ConfigManager {
       })(),
       disableHistory:
         userConfig.disableHistory || DEFAULT_MEMORY_CONFIG.disableHistory,
+      workerThreads: userConfig.workerThreads,
+      searchCache: userConfig.searchCache,
     };
 
     // Validate the merged config
@@ -59,11 +59,14 @@ import {
   PerformanceSlowQueryTrigger,
   ScaleThresholdTrigger,
 } from "../utils/notices";
-import { lemmatizeForBm25 } from "../utils/lemmatization";
+import { ExtractedEntity } from "../utils/entity_extraction";
+import { CpuWorkerPool, runOnPool } from "../utils/cpu_pool";
 import {
-  extractEntities,
-  extractEntitiesBatch,
-} from "../utils/entity_extraction";
+  SearchCacheStats,
+  SearchCoalescer,
+  makeSearchKey,
+  scopeOf,
+} from "../utils/search_cache";
 import {
   scoreAndRank,
   getBm25Params,
@@ -168,6 +171,8 @@ export class Memory {
   private _initPromise: Promise<void>;
   private _initError?: Error;
   private _entityStore?: VectorStore;
+  private _cpuPool?: CpuWorkerPool;
+  private _searchCache?: SearchCoalescer<MemoryItem[]>;
 
   constructor(config: Partial<MemoryConfig> = {}) {
     // Merge and validate config
@@ -198,6 +203,16 @@ export class Memory {
     this.apiVersion = this.config.version || "v1.0";
     this.telemetryId = "anonymous";
 
+    if (this.config.workerThreads && this.config.workerThreads > 0) {
+      this._cpuPool = new CpuWorkerPool(this.config.workerThreads);
+    }
+    if (this.config.searchCache?.enabled) {
+      this._searchCache = new SearchCoalescer(
+        this.config.searchCache.ttlMs,
+        this.config.searchCache.maxEntries,
+      );
+    }
+
     // Auto-detect embedding dimension (if needed), create vector store,
     // and initialize it. All public methods await this before proceeding.
     this._initPromise = this._autoInitialize().catch((error) => {
@@ -226,7 +241,7 @@ export class Memory {
 
     this.vectorStore = VectorStoreFactory.create(
       this.config.vectorStore.provider,
-      this.config.vectorStore.config,
+      this._withWorkerPool(this.config.vectorStore.config),
     );
 
     // The vector store constructor may fire initialize() asynchronously
@@ -275,13 +290,46 @@ export class Memory {
       }
       this._entityStore = VectorStoreFactory.create(
         this.config.vectorStore.provider,
-        entityConfig,
+        this._withWorkerPool(entityConfig),
       );
       await this._entityStore.initialize();
     }
     return this._entityStore;
   }
 
+  private _listedRows(
+    listed: unknown,
+  ): Array<{ id: string; payload: Record<string, any> }> {
+    return (
+      Array.isArray(listed) && Array.isArray(listed[0]) ? listed[0] : listed
+    ) as Array<{ id: string; payload: Record<string, any> }>;
+  }
+
+  /**
+   * Hand the worker pool to the in-process SQLite store, the only provider
+   * that scores vectors on this thread.
+   */
+  private _withWorkerPool(
+    config: MemoryConfig["vectorStore"]["config"],
+  ): MemoryConfig["vectorStore"]["config"] {
+    if (!this._cpuPool || this.config.vectorStore.provider !== "memory") {
+      return config;
+    }
+    return { ...config, workerPool: this._cpuPool };
+  }
+
+  /** Lemmatize texts for BM25, on the worker pool when configured. */
+  private async _lemmatize(texts: string[]): Promise<string[]> {
+    return runOnPool(this._cpuPool, { type: "lemmatize", texts });
+  }
+
+  /** Extract entities per text, on the worker pool when configured. */
+  private async _extractEntities(
+    texts: string[],
+  ): Promise<ExtractedEntity[][]> {
+    return runOnPool(this._cpuPool, { type: "extractEntities", texts });
+  }
+
   /**
    * Normalize a filters object for entity-store scoping: keeps only
    * user_id/agent_id/run_id keys whose values are defined.
@@ -310,12 +358,7 @@ export class Memory {
     >();
     let rows: Array<{ id: string; payload: Record<string, any> }> = [];
     try {
-      const listed = await entityStore.list(filters, 10000);
-      rows = (
-        Array.isArray(listed) && Array.isArray(listed[0])
-          ? listed[0]
-          : (listed as any)
-      ) as Array<{ id: string; payload: Record<string, any> }>;
+      rows = this._listedRows(await entityStore.list(filters, 10000));
     } catch (e) {
       console.debug(
         `Exact entity lookup failed, falling back to semantic dedup: ${e}`,
@@ -335,17 +378,20 @@ export class Memory {
   }
 
   /**
-   * Remove `memoryId` from every entity record scoped to `filters`.
-   * If an entity's `linkedMemoryIds` becomes empty after removal, the
-   * entity record itself is deleted. Errors on individual entities are
-   * swallowed so one bad record does not break the whole operation.
-   *
-   * No-op if the entity store has not been initialized yet.
+   * Remove `memoryIds` from every entity record that links to them. Stores
+   * with `listByLinkedMemory` answer this from an index kept next to the
+   * entities; otherwise every entity record scoped to `filters` is scanned.
+   * An entity record is deleted only once none of its `linkedMemoryIds`
+   * remain, so entities shared with memories outside the removed set
+   * survive. Errors on individual entities are swallowed so one bad record
+   * does not break the whole operation.
    */
-  private async _removeMemoryFromEntityStore(
-    memoryId: string,
+  private async _removeMemoriesFromEntityStore(
+    memoryIds: string[],
     filters: Record<string, any>,
   ): Promise<void> {
+    if (memoryIds.length === 0) return;
+
     let entityStore: VectorStore;
     try {
       entityStore = await this.getEntityStore();
@@ -356,63 +402,91 @@ export class Memory {
 
     let rows: Array<{ id: string; payload: Record<string, any> }> = [];
     try {
-      const listed = await entityStore.list(filters, 10000);
-      rows = (
-        Array.isArray(listed) && Array.isArray(listed[0])
-          ? listed[0]
-          : (listed as any)
-      ) as Array<{ id: string; payload: Record<string, any> }>;
+      if (typeof entityStore.listByLinkedMemory === "function") {
+        const byId = new Map<string, (typeof rows)[number]>();
+        for (const memoryId of memoryIds) {
+          for (const row of await entityStore.listByLinkedMemory(memoryId)) {
+            byId.set(row.id, row);
+          }
+        }
+        rows = Array.from(byId.values());
+      } else {
+        rows = this._listedRows(await entityStore.list(filters, 10000));
+      }
     } catch (e) {
       console.debug(`Entity store list failed during cleanup: ${e}`);
       return;
     }
 
+    const removed = new Set(memoryIds);
     for (const row of rows) {
       try {
-        const payload = row.payload || {};
-        const linked: string[] = Array.isArray(payload.linkedMemoryIds)
-          ? payload.linkedMemoryIds
-          : [];
-        if (!linked.includes(memoryId)) continue;
-
-        const remaining = linked.filter((id) => id !== memoryId);
-        if (remaining.length === 0) {
-          try {
-            await entityStore.delete(row.id);
-          } catch (e) {
-            console.debug(`Entity delete failed for id=${row.id}: ${e}`);
-          }
-        } else {
-          const newPayload = { ...payload, linkedMemoryIds: remaining };
-          // entityStore.update requires a vector — re-embed entity text.
-          const entityText =
-            typeof payload.data === "string" ? payload.data : "";
-          if (!entityText) {
-            // Can't re-embed without text; skip gracefully.
-            console.debug(
-              `Entity id=${row.id} missing 'data'; skipping update during cleanup`,
-            );
-            continue;
-          }
-          let vec: number[];
-          try {
-            vec = await this.embedder.embed(entityText);
-          } catch (e) {
-            console.debug(`Entity re-embed failed for '${entityText}': ${e}`);
-            continue;
-          }
-          try {
-            await entityStore.update(row.id, vec, newPayload);
-          } catch (e) {
-            console.debug(`Entity update failed for id=${row.id}: ${e}`);
-          }
-        }
+        await this._unlinkEntity(entityStore, row, removed);
       } catch (e) {
         console.debug(`Entity cleanup error for id=${row?.id}: ${e}`);
       }
     }
   }
 
+  /**
+   * Drop `removed` memory ids from one entity record, deleting the record
+   * once no memory links to it. Stores with `updatePayload` keep the
+   * existing vector; others need the entity text re-embedded.
+   */
+  private async _unlinkEntity(
+    entityStore: VectorStore,
+    row: { id: string; payload: Record<string, any> },
+    removed: Set<string>,
+  ): Promise<void> {
+    const payload = row.payload || {};
+    const linked: string[] = Array.isArray(payload.linkedMemoryIds)
+      ? payload.linkedMemoryIds
+      : [];
+    const remaining = linked.filter((id) => !removed.has(id));
+    if (remaining.length === linked.length) return;
+
+    if (remaining.length === 0) {
+      try {
+        await entityStore.delete(row.id);
+      } catch (e) {
+        console.debug(`Entity delete failed for id=${row.id}: ${e}`);
+      }
+      return;
+    }
+
+    const newPayload = { ...payload, linkedMemoryIds: remaining };
+    if (typeof entityStore.updatePayload === "function") {
+      try {
+        await entityStore.updatePayload(row.id, newPayload);
+      } catch (e) {
+        console.debug(`Entity update failed for id=${row.id}: ${e}`);
+      }
+      return;
+    }
+
+    // entityStore.update requires a vector — re-embed entity text.
+    const entityText = typeof payload.data === "string" ? payload.data : "";
+    if (!entityText) {
+      // Can't re-embed without text; skip gracefully.
+      console.debug(
+        `Entity id=${row.id} missing 'data'; skipping update during cleanup`,
+      );
+      return;
+    }
+    let vec: number[];
+    try {
+      vec = await this.embedder.embed(entityText);
+    } catch (e) {
+      console.debug(`Entity re-embed failed for '${entityText}': ${e}`);
+      return;
+    }
+    try {
+      await entityStore.update(row.id, vec, newPayload);
+    } catch (e) {
+      console.debug(`Entity update failed for id=${row.id}: ${e}`);
+    }
+  }
+
   /**
    * Extract entities from `text` and link them to `memoryId` in the
    * entity store, scoped to `filters` (user_id / agent_id / run_id).
@@ -427,7 +501,7 @@ export class Memory {
     filters: Record<string, any>,
   ): Promise<void> {
     try {
-      const entities = extractEntities(text);
+      const [entities] = await this._extractEntities([text]);
       if (entities.length === 0) return;
 
       const entityStore = await this.getEntityStore();
@@ -726,12 +800,17 @@ export class Memory {
     const final_parsedMessages = await parse_vision_messages(parsedMessages);
 
     // Add to vector store
-    const vectorStoreResult = await this.addToVectorStore(
-      final_parsedMessages,
-      metadata,
-      filters,
-      infer,
-    );
+    let vectorStoreResult: MemoryItem[];
+    try {
+      vectorStoreResult = await this.addToVectorStore(
+        final_parsedMessages,
+        metadata,
+        filters,
+        infer,
+      );
+    } finally {
+      this._searchCache?.invalidate(scopeOf(filters));
+    }
 
     if (temporalUsageNotice) {
       await this._displayTemporalUsageNotice({
@@ -766,23 +845,15 @@ export class Memory {
     infer: boolean,
   ): Promise<MemoryItem[]> {
     if (!infer) {
-      const returnedMemories: MemoryItem[] = [];
-      for (const message of messages) {
-        if (message.role === "system") {
-          continue;
-        }
-        const memoryId = await this.createMemory(
-          message.content as string,
-          {},
-          metadata,
-        );
-        returnedMemories.push({
-          id: memoryId,
-          memory: message.content as string,
-          metadata: { event: "ADD" },
-        });
-      }
-      return returnedMemories;
+      const texts = messages
+        .filter((message) => message.role !== "system")
+        .map((message) => message.content as string);
+      const memoryIds = await this.createMemories(texts, metadata);
+      return memoryIds.map((id, i) => ({
+        id,
+        memory: texts[i],
+        metadata: { event: "ADD" },
+      }));
     }
 
     // === V3 PHASED BATCH PIPELINE ===
@@ -933,6 +1004,10 @@ export class Memory {
       payload: Record<string, any>;
     }> = [];
     const seenHashes = new Set<string>();
+    const lemmatizedTexts = await this._lemmatize(memTexts);
+    const lemmatizedByText = new Map(
+      memTexts.map((text, i) => [text, lemmatizedTexts[i]]),
+    );
 
     for (const mem of extractedMemories) {
       const text = mem.text;
@@ -944,7 +1019,7 @@ export class Memory {
       }
       seenHashes.add(memHash);
 
-      const textLemmatized = lemmatizeForBm25(text);
+      const textLemmatized = lemmatizedByText.get(text)!;
       const memoryId = uuidv4();
       const now = new Date().toISOString();
 
@@ -1057,7 +1132,7 @@ export class Memory {
     // Phase 7: Batch entity linking
     try {
       const allTexts = records.map((r) => r.text);
-      const allEntities = extractEntitiesBatch(allTexts);
+      const allEntities = await this._extractEntities(allTexts);
 
       // 7a: Global dedup — collect unique entities across all memories
       const globalEntities: Record<
@@ -1349,10 +1424,80 @@ export class Memory {
     }
 
     const searchStartMs = Date.now();
+    const results = this._searchCache
+      ? await this._searchCache.run(
+          makeSearchKey(query, effectiveFilters, topK, threshold, explain),
+          scopeOf(effectiveFilters),
+          () =>
+            this._searchMemories(
+              query,
+              effectiveFilters,
+              topK,
+              threshold,
+              explain,
+            ),
+        )
+      : await this._searchMemories(
+          query,
+          effectiveFilters,
+          topK,
+          threshold,
+          explain,
+        );
 
+    const result = {
+      results,
+    };
+    const searchElapsedMs = Date.now() - searchStartMs;
+    if (temporalUsageNotice) {
+      await this._displayTemporalUsageNotice({
+        triggerFunction: "search",
+        triggerSource: temporalUsageNotice.triggerSource,
+        triggerReason: temporalUsageNotice.triggerReason,
+      });
+    } else {
+      const scaleThresholdNotice = detectScaleThresholdFromTopK(topK);
+      if (scaleThresholdNotice) {
+        await this._displayScaleThresholdNotice({
+          triggerFunction: "search",
+          ...scaleThresholdNotice,
+        });
+      } else {
+        const performanceSlowQueryNotice = detectPerformanceSlowQuery(
+          searchElapsedMs,
+          topK,
+          results.length,
+        );
+        if (performanceSlowQueryNotice) {
+          await this._displayPerformanceSlowQueryNotice({
+            triggerFunction: "search",
+            triggerReason: "slow_query",
+            ...performanceSlowQueryNotice,
+          });
+        } else {
+          await this._displayFirstRunNotice("search");
+        }
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Steps 1-9 of search(): hybrid retrieval, scoring and formatting for
+   * already-validated filters.
+   */
+  private async _searchMemories(
+    query: string,
+    effectiveFilters: Record<string, any>,
+    topK: number,
+    threshold: number,
+    explain: boolean,
+  ): Promise<MemoryItem[]> {
     // Step 1: Preprocess query
-    const queryLemmatized = lemmatizeForBm25(query);
-    const queryEntities = extractEntities(query);
+    const [[queryLemmatized], [queryEntities]] = await Promise.all([
+      this._lemmatize([query]),
+      this._extractEntities([query]),
+    ]);
 
     // Step 2: Embed query
     const queryEmbedding = await this.embedder.embed(query);
@@ -1526,41 +1671,7 @@ export class Memory {
         };
       });
 
-    const result = {
-      results,
-    };
-    const searchElapsedMs = Date.now() - searchStartMs;
-    if (temporalUsageNotice) {
-      await this._displayTemporalUsageNotice({
-        triggerFunction: "search",
-        triggerSource: temporalUsageNotice.triggerSource,
-        triggerReason: temporalUsageNotice.triggerReason,
-      });
-    } else {
-      const scaleThresholdNotice = detectScaleThresholdFromTopK(topK);
-      if (scaleThresholdNotice) {
-        await this._displayScaleThresholdNotice({
-          triggerFunction: "search",
-          ...scaleThresholdNotice,
-        });
-      } else {
-        const performanceSlowQueryNotice = detectPerformanceSlowQuery(
-          searchElapsedMs,
-          topK,
-          results.length,
-        );
-        if (performanceSlowQueryNotice) {
-          await this._displayPerformanceSlowQueryNotice({
-            triggerFunction: "search",
-            triggerReason: "slow_query",
-            ...performanceSlowQueryNotice,
-          });
-        } else {
-          await this._displayFirstRunNotice("search");
-        }
-      }
-    }
-    return result;
+    return results;
   }
 
   async update(memoryId: string, data: string): Promise<{ message: string }> {
@@ -1619,8 +1730,13 @@ export class Memory {
 
     const [memories] = await this.vectorStore.list(filters);
     for (const memory of memories) {
-      await this.deleteMemory(memory.id);
+      await this.deleteMemory(memory.id, false);
     }
+    await this._removeMemoriesFromEntityStore(
+      memories.map((m) => m.id),
+      filters,
+    );
+    this._searchCache?.invalidate(scopeOf(filters));
 
     const result = { message: "Memories deleted successfully!" };
     if (memories.length > 0) {
@@ -1646,6 +1762,7 @@ export class Memory {
   async reset(): Promise<void> {
     await this._ensureInitialized();
     await this._captureEvent("reset");
+    this._searchCache?.invalidate();
     await this.db.reset();
 
     // Check provider before attempting deleteCol
@@ -1695,6 +1812,20 @@ export class Memory {
     await this._displayFirstRunNotice("reset");
   }
 
+  /** Dedup counters for the search cache, if `searchCache` is enabled. */
+  searchCacheStats(): SearchCacheStats | undefined {
+    return this._searchCache?.stats();
+  }
+
+  /**
+   * Stop the worker threads started for `workerThreads`. Idle workers never
+   * keep the process alive, so this is only needed to release them early.
+   */
+  async close(): Promise<void> {
+    await this._cpuPool?.close();
+    this._cpuPool = undefined;
+  }
+
   async getAll(config: GetAllMemoryOptions): Promise<SearchResult> {
     // Reject top-level entity params - must use filters instead
     rejectTopLevelEntityParams(config as Record<string, any>, "getAll");
@@ -1776,33 +1907,62 @@ export class Memory {
     return result;
   }
 
-  private async createMemory(
-    data: string,
-    existingEmbeddings: Record<string, number[]>,
+  /**
+   * Store texts verbatim as new memories: one embedBatch call, one bulk
+   * vector insert and one batched history write, instead of a round trip
+   * per text.
+   */
+  private async createMemories(
+    texts: string[],
     metadata: Record<string, any>,
-  ): Promise<string> {
-    const memoryId = uuidv4();
-    const embedding =
-      existingEmbeddings[data] || (await this.embedder.embed(data));
+  ): Promise<string[]> {
+    if (texts.length === 0) return [];
+
+    let embeddings: number[][];
+    try {
+      embeddings = await this.embedder.embedBatch(texts);
+    } catch {
+      embeddings = [];
+      for (const text of texts) {
+        embeddings.push(await this.embedder.embed(text));
+      }
+    }
+    const lemmatized = await this._lemmatize(texts);
 
-    const memoryMetadata = {
+    const createdAt = new Date().toISOString();
+    const memoryIds = texts.map(() => uuidv4());
+    const payloads = texts.map((data, i) => ({
       ...metadata,
       data,
       hash: createHash("md5").update(data).digest("hex"),
-      textLemmatized: lemmatizeForBm25(data),
-      createdAt: new Date().toISOString(),
-    };
+      textLemmatized: lemmatized[i],
+      createdAt,
+    }));
 
-    await this.vectorStore.insert([embedding], [memoryId], [memoryMetadata]);
-    await this.db.addHistory(
+    await this.vectorStore.insert(embeddings, memoryIds, payloads);
+
+    const historyRecords = memoryIds.map((memoryId, i) => ({
       memoryId,
-      null,
-      data,
-      "ADD",
-      memoryMetadata.createdAt,
-    );
+      previousValue: null,
+      newValue: texts[i],
+      action: "ADD",
+      createdAt,
+    }));
+    if (typeof this.db.batchAddHistory === "function") {
+      await this.db.batchAddHistory(historyRecords);
+    } else {
+      for (const hr of historyRecords) {
+        await this.db.addHistory(
+          hr.memoryId,
+          null,
+          hr.newValue,
+          "ADD",
+          createdAt,
+        );
+      }
+    }
 
-    return memoryId;
+    return memoryIds;
   }
 
   private async updateMemory(
@@ -1820,12 +1980,13 @@ export class Memory {
     const embedding =
       existingEmbeddings[data] || (await this.embedder.embed(data));
 
+    const [textLemmatized] = await this._lemmatize([data]);
     const newMetadata = {
       ...existingMemory.payload,
       ...metadata,
       data,
       hash: createHash("md5").update(data).digest("hex"),
-      textLemmatized: lemmatizeForBm25(data),
+      textLemmatized,
       createdAt: existingMemory.payload.createdAt,
       updatedAt: new Date().toISOString(),
     };
@@ -1844,16 +2005,21 @@ export class Memory {
     // then re-extract entities from the new text and link them back.
     try {
       const sessionFilters = this._sessionFiltersFromPayload(newMetadata);
-      await this._removeMemoryFromEntityStore(memoryId, sessionFilters);
+      await this._removeMemoriesFromEntityStore([memoryId], sessionFilters);
       await this._linkEntitiesForMemory(memoryId, data, sessionFilters);
     } catch (e) {
       console.warn(`Entity store cleanup/link failed during update: ${e}`);
     }
+    this._searchCache?.invalidate(scopeOf(existingMemory.payload));
+    this._searchCache?.invalidate(scopeOf(newMetadata));
 
     return memoryId;
   }
 
-  private async deleteMemory(memoryId: string): Promise<string> {
+  private async deleteMemory(
+    memoryId: string,
+    cleanupEntities = true,
+  ): Promise<string> {
     const existingMemory = await this.vectorStore.get(memoryId);
     if (!existingMemory) {
       throw new Error(`Memory with ID ${memoryId} not found`);
@@ -1875,12 +2041,16 @@ export class Memory {
     );
 
     // Entity-store cleanup: strip this memory's id from any entity records
-    // that linked to it. Non-fatal — log and continue on error.
-    try {
-      await this._removeMemoryFromEntityStore(memoryId, sessionFilters);
-    } catch (e) {
-      console.warn(`Entity store cleanup failed during delete: ${e}`);
+    // that linked to it. Non-fatal — log and continue on error. deleteAll()
+    // skips this and unlinks the whole batch in one pass instead.
+    if (cleanupEntities) {
+      try {
+        await this._removeMemoriesFromEntityStore([memoryId], sessionFilters);
+      } catch (e) {
+        console.warn(`Entity store cleanup failed during delete: ${e}`);
+      }
     }
+    this._searchCache?.invalidate(sessionFilters);
 
     return memoryId;
   }
@@ -7,6 +7,9 @@ export class SQLiteManager implements HistoryManager {
   private db: Database.Database;
   private stmtInsert!: Database.Statement;
   private stmtSelect!: Database.Statement;
+  private stmtInsertMessage!: Database.Statement;
+  private stmtEvictMessages!: Database.Statement;
+  private stmtLastMessages!: Database.Statement;
 
   constructor(dbPath: string) {
     ensureSQLiteDirectory(dbPath);
@@ -45,6 +48,26 @@ export class SQLiteManager implements HistoryManager {
     this.stmtSelect = this.db.prepare(
       "SELECT * FROM memory_history WHERE memory_id = ? ORDER BY id DESC",
     );
+    this.stmtInsertMessage = this.db.prepare(
+      `INSERT INTO messages (id, session_scope, role, content, name, created_at)
+       VALUES (?, ?, ?, ?, ?, ?)`,
+    );
+    this.stmtEvictMessages = this.db.prepare(
+      `DELETE FROM messages WHERE session_scope = ? AND id NOT IN (
+         SELECT id FROM (
+           SELECT id FROM messages WHERE session_scope = ? ORDER BY created_at DESC LIMIT 10
+         )
+       )`,
+    );
+    this.stmtLastMessages = this.db.prepare(
+      `SELECT role, content, name, created_at FROM (
+         SELECT role, content, name, created_at
+         FROM messages
+         WHERE session_scope = ?
+         ORDER BY created_at DESC
+         LIMIT ?
+       ) ORDER BY created_at ASC`,
+    );
   }
 
   async addHistory(
@@ -77,22 +100,10 @@ export class SQLiteManager implements HistoryManager {
   ): Promise<void> {
     if (!messages.length) return;
 
-    const insertMsg = this.db.prepare(
-      `INSERT INTO messages (id, session_scope, role, content, name, created_at)
-       VALUES (?, ?, ?, ?, ?, ?)`,
-    );
-    const evict = this.db.prepare(
-      `DELETE FROM messages WHERE session_scope = ? AND id NOT IN (
-         SELECT id FROM (
-           SELECT id FROM messages WHERE session_scope = ? ORDER BY created_at DESC LIMIT 10
-         )
-       )`,
-    );
-
     const txn = this.db.transaction(() => {
       const now = new Date().toISOString();
       for (const msg of messages) {
-        insertMsg.run(
+        this.stmtInsertMessage.run(
           randomUUID(),
           sessionScope,
           msg.role,
@@ -101,7 +112,7 @@ export class SQLiteManager implements HistoryManager {
           now,
         );
       }
-      evict.run(sessionScope, sessionScope);
+      this.stmtEvictMessages.run(sessionScope, sessionScope);
     });
 
     txn();
@@ -113,17 +124,7 @@ export class SQLiteManager implements HistoryManager {
   ): Promise<
     Array<{ role: string; content: string; name?: string; createdAt: string }>
   > {
-    const rows = this.db
-      .prepare(
-        `SELECT role, content, name, created_at FROM (
-           SELECT role, content, name, created_at
-           FROM messages
-           WHERE session_scope = ?
-           ORDER BY created_at DESC
-           LIMIT ?
-         ) ORDER BY created_at ASC`,
-      )
-      .all(sessionScope, limit) as Array<{
+    const rows = this.stmtLastMessages.all(sessionScope, limit) as Array<{
       role: string;
       content: string;
       name: string | null;
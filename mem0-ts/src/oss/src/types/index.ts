@@ -72,6 +72,21 @@ export interface MemoryConfig {
   disableHistory?: boolean;
   historyDbPath?: string;
   customInstructions?: string;
+  /**
+   * Number of worker threads for CPU-bound stages (lemmatization, entity
+   * extraction, in-memory vector scoring). 0 or unset runs them inline.
+   */
+  workerThreads?: number;
+  /**
+   * Merge identical concurrent search() calls onto one execution and reuse
+   * the result for `ttlMs` (0 only merges in-flight calls). Writes to an
+   * overlapping user/agent/run scope drop cached results. Off by default.
+   */
+  searchCache?: {
+    enabled?: boolean;
+    ttlMs?: number;
+    maxEntries?: number;
+  };
 }
 
 export interface MemoryItem {
@@ -149,4 +164,12 @@ export const MemoryConfigSchema = z.object({
     })
     .optional(),
   disableHistory: z.boolean().optional(),
+  workerThreads: z.number().int().nonnegative().optional(),
+  searchCache: z
+    .object({
+      enabled: z.boolean().optional(),
+      ttlMs: z.number().nonnegative().optional(),
+      maxEntries: z.number().int().positive().optional(),
+    })
+    .optional(),
 });
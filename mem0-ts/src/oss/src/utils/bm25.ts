@@ -1,64 +1,178 @@
-export class BM25 {
-  private documents: string[][];
-  private k1: number;
-  private b: number;
-  private avgDocLength: number;
-  private docFreq: Map<string, number>;
-  private docLengths: number[];
-  private idf: Map<string, number>;
-
-  constructor(documents: string[][], k1 = 1.5, b = 0.75) {
-    this.documents = documents;
-    this.k1 = k1;
-    this.b = b;
-    this.docLengths = documents.map((doc) => doc.length);
-    this.avgDocLength =
-      this.docLengths.reduce((a, b) => a + b, 0) / documents.length;
-    this.docFreq = new Map();
-    this.idf = new Map();
-    this.computeIdf();
+/**
+ * Incremental in-memory BM25 index for local vector stores that have no
+ * native full-text search.
+ *
+ * Documents are stored as per-term postings (term -> doc id -> term
+ * frequency), so adding or removing a document only touches its own terms
+ * and a query only visits documents that contain at least one query term.
+ * IDF and the average document length are derived from running counters at
+ * query time, so nothing is rebuilt when the corpus changes.
+ */
+
+export interface BM25Hit {
+  id: string;
+  score: number;
+}
+
+export class BM25Index {
+  private postings = new Map<string, Map<string, number>>();
+  private docTerms = new Map<string, Map<string, number>>();
+  private docLengths = new Map<string, number>();
+  private totalLength = 0;
+
+  constructor(
+    private readonly k1 = 1.5,
+    private readonly b = 0.75,
+  ) {}
+
+  get size(): number {
+    return this.docLengths.size;
   }
 
-  private computeIdf() {
-    const N = this.documents.length;
+  has(id: string): boolean {
+    return this.docLengths.has(id);
+  }
 
-    // Count document frequency for each term
-    for (const doc of this.documents) {
-      const terms = new Set(doc);
-      for (const term of terms) {
-        this.docFreq.set(term, (this.docFreq.get(term) || 0) + 1);
+  /** Index `terms` under `id`, replacing any previous version of it. */
+  add(id: string, terms: string[]): void {
+    if (this.docLengths.has(id)) {
+      this.remove(id);
+    }
+
+    const tf = new Map<string, number>();
+    let length = 0;
+    for (const term of terms) {
+      if (!term) continue;
+      tf.set(term, (tf.get(term) || 0) + 1);
+      length++;
+    }
+    for (const [term, count] of tf) {
+      let docs = this.postings.get(term);
+      if (!docs) {
+        docs = new Map();
+        this.postings.set(term, docs);
       }
+      docs.set(id, count);
     }
 
-    // Compute IDF for each term
-    for (const [term, freq] of this.docFreq) {
-      this.idf.set(term, Math.log((N - freq + 0.5) / (freq + 0.5) + 1));
+    this.docTerms.set(id, tf);
+    // Empty terms are not indexed, so they do not count towards the length.
+    this.docLengths.set(id, length);
+    this.totalLength += length;
+  }
+
+  remove(id: string): boolean {
+    const tf = this.docTerms.get(id);
+    if (!tf) return false;
+
+    for (const term of tf.keys()) {
+      const docs = this.postings.get(term)!;
+      docs.delete(id);
+      if (docs.size === 0) this.postings.delete(term);
     }
+
+    this.totalLength -= this.docLengths.get(id)!;
+    this.docTerms.delete(id);
+    this.docLengths.delete(id);
+    return true;
   }
 
-  private score(query: string[], doc: string[], index: number): number {
-    let score = 0;
-    const docLength = this.docLengths[index];
+  clear(): void {
+    this.postings.clear();
+    this.docTerms.clear();
+    this.docLengths.clear();
+    this.totalLength = 0;
+  }
+
+  /**
+   * Top `topK` documents by BM25 score, highest first. Only documents
+   * sharing at least one term with the query are scored; `accept` can
+   * exclude ids (e.g. ones that fail a payload filter) before they take a
+   * slot in the result.
+   */
+  search(
+    query: string[],
+    topK: number,
+    accept?: (id: string) => boolean,
+  ): BM25Hit[] {
+    const N = this.docLengths.size;
+    if (N === 0 || topK <= 0) return [];
+    const avgDocLength = this.totalLength / N || 1;
 
+    // Repeated query terms count once per occurrence, as in the textbook
+    // formulation.
+    const queryCounts = new Map<string, number>();
     for (const term of query) {
-      const tf = doc.filter((t) => t === term).length;
-      const idf = this.idf.get(term) || 0;
+      if (this.postings.has(term)) {
+        queryCounts.set(term, (queryCounts.get(term) || 0) + 1);
+      }
+    }
 
-      score +=
-        (idf * tf * (this.k1 + 1)) /
-        (tf +
-          this.k1 * (1 - this.b + (this.b * docLength) / this.avgDocLength));
+    const scores = new Map<string, number>();
+    for (const [term, occurrences] of queryCounts) {
+      const docs = this.postings.get(term)!;
+      const df = docs.size;
+      const idf = Math.log((N - df + 0.5) / (df + 0.5) + 1) * occurrences;
+      for (const [id, tf] of docs) {
+        const norm =
+          this.k1 *
+          (1 - this.b + (this.b * this.docLengths.get(id)!) / avgDocLength);
+        const termScore = (idf * tf * (this.k1 + 1)) / (tf + norm);
+        scores.set(id, (scores.get(id) || 0) + termScore);
+      }
     }
 
-    return score;
+    return selectTopK(scores, topK, accept);
   }
+}
 
-  search(query: string[]): string[][] {
-    const scores = this.documents.map((doc, idx) => ({
-      doc,
-      score: this.score(query, doc, idx),
-    }));
+/**
+ * Bounded min-heap selection: O(n log k) instead of sorting every scored
+ * document.
+ */
+function selectTopK(
+  scores: Map<string, number>,
+  k: number,
+  accept?: (id: string) => boolean,
+): BM25Hit[] {
+  const heap: BM25Hit[] = [];
 
-    return scores.sort((a, b) => b.score - a.score).map((item) => item.doc);
+  const siftUp = (i: number) => {
+    while (i > 0) {
+      const parent = (i - 1) >> 1;
+      if (heap[parent].score <= heap[i].score) break;
+      [heap[parent], heap[i]] = [heap[i], heap[parent]];
+      i = parent;
+    }
+  };
+  const siftDown = (i: number) => {
+    for (;;) {
+      const left = 2 * i + 1;
+      const right = left + 1;
+      let smallest = i;
+      if (left < heap.length && heap[left].score < heap[smallest].score) {
+        smallest = left;
+      }
+      if (right < heap.length && heap[right].score < heap[smallest].score) {
+        smallest = right;
+      }
+      if (smallest === i) break;
+      [heap[smallest], heap[i]] = [heap[i], heap[smallest]];
+      i = smallest;
+    }
+  };
+
+  for (const [id, score] of scores) {
+    if (heap.length === k && score <= heap[0].score) continue;
+    if (accept && !accept(id)) continue;
+    if (heap.length < k) {
+      heap.push({ id, score });
+      siftUp(heap.length - 1);
+    } else {
+      heap[0] = { id, score };
+      siftDown(0);
+    }
   }
+
+  return heap.sort((a, b) => b.score - a.score);
 }
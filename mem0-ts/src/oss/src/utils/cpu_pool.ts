@@ -0,0 +1,178 @@
+/**
+ * Fixed-size worker_threads pool for the CPU-bound stages of the memory
+ * pipeline (lemmatization, entity extraction, in-memory vector scoring).
+ *
+ * Opt-in through `MemoryConfig.workerThreads`. Without a pool every task
+ * runs inline on the calling thread, so callers can use the same API either
+ * way.
+ */
+import fs from "fs";
+import path from "path";
+import { Worker } from "worker_threads";
+import { CpuTask, CpuTaskResult, runCpuTask } from "./cpu_tasks";
+
+interface Job {
+  task: CpuTask;
+  transfer: ArrayBuffer[];
+  resolve: (value: any) => void;
+  reject: (error: Error) => void;
+}
+
+/**
+ * Locate the worker entry: the compiled bundle next to dist/oss/index.js,
+ * or the TypeScript source when running under ts-node / ts-jest.
+ */
+function resolveWorkerScript(): { file: string; eval: boolean } {
+  const compiled = path.join(__dirname, "cpu_worker.js");
+  if (fs.existsSync(compiled)) {
+    return { file: compiled, eval: false };
+  }
+  const source = path.join(__dirname, "cpu_worker.ts");
+  return {
+    file:
+      `require("ts-node").register({ transpileOnly: true, compilerOptions: { module: "commonjs" } });` +
+      `require(${JSON.stringify(source)});`,
+    eval: true,
+  };
+}
+
+export class CpuWorkerPool {
+  private workers: Worker[] = [];
+  private idle: Worker[] = [];
+  private busy = new Map<Worker, Job>();
+  private queue: Job[] = [];
+  private closed = false;
+
+  constructor(size: number) {
+    for (let i = 0; i < size; i++) {
+      this.spawn();
+    }
+  }
+
+  get size(): number {
+    return this.workers.length;
+  }
+
+  /** Jobs waiting for a free worker. */
+  get queueDepth(): number {
+    return this.queue.length;
+  }
+
+  /**
+   * Run a task on the next free worker. Buffers listed in `transfer` are
+   * moved to the worker and become unusable on the calling thread.
+   */
+  run<T extends CpuTask>(
+    task: T,
+    transfer: ArrayBuffer[] = [],
+  ): Promise<CpuTaskResult<T>> {
+    if (this.closed) {
+      return Promise.reject(new Error("CpuWorkerPool is closed"));
+    }
+    return new Promise((resolve, reject) => {
+      this.queue.push({ task, transfer, resolve, reject });
+      this.dispatch();
+    });
+  }
+
+  async close(): Promise<void> {
+    this.closed = true;
+    const error = new Error("CpuWorkerPool is closed");
+    for (const job of this.queue.splice(0)) job.reject(error);
+    for (const job of this.busy.values()) job.reject(error);
+    this.busy.clear();
+    const workers = this.workers.splice(0);
+    this.idle = [];
+    await Promise.all(workers.map((w) => w.terminate()));
+  }
+
+  private spawn(): void {
+    const script = resolveWorkerScript();
+    const worker = new Worker(script.file, { eval: script.eval });
+
+    worker.on("message", (message: { result?: any; error?: string }) => {
+      const job = this.busy.get(worker);
+      this.busy.delete(worker);
+      this.release(worker);
+      if (!job) return;
+      if (message.error !== undefined) {
+        job.reject(new Error(message.error));
+      } else {
+        job.resolve(message.result);
+      }
+    });
+
+    // A worker that crashes or exits mid-task fails that job and is
+    // replaced; one that fails while idle (e.g. the script could not load)
+    // is dropped so a broken install cannot respawn in a loop. "exit" also
+    // follows "error", so only the first of the two retires the worker.
+    worker.on("error", (error) => this.retire(worker, error));
+    worker.on("exit", (code) =>
+      this.retire(worker, new Error(`CpuWorkerPool worker exited (${code})`)),
+    );
+
+    // Idle workers must not keep the process alive.
+    worker.unref();
+    this.workers.push(worker);
+    this.idle.push(worker);
+  }
+
+  private retire(worker: Worker, error: Error): void {
+    if (!this.workers.includes(worker)) return;
+    const job = this.busy.get(worker);
+    this.busy.delete(worker);
+    this.workers = this.workers.filter((w) => w !== worker);
+    this.idle = this.idle.filter((w) => w !== worker);
+    if (job) {
+      job.reject(error);
+      if (!this.closed) this.spawn();
+    }
+    this.dispatch();
+  }
+
+  private release(worker: Worker): void {
+    worker.unref();
+    if (!this.closed) {
+      this.idle.push(worker);
+      this.dispatch();
+    }
+  }
+
+  private dispatch(): void {
+    if (this.workers.length === 0) {
+      const error = new Error("CpuWorkerPool has no running workers");
+      for (const job of this.queue.splice(0)) job.reject(error);
+      return;
+    }
+    while (this.idle.length > 0 && this.queue.length > 0) {
+      const worker = this.idle.pop()!;
+      const job = this.queue.shift()!;
+      this.busy.set(worker, job);
+      // Keep the process alive while a caller is awaiting this job.
+      worker.ref();
+      worker.postMessage(job.task, job.transfer);
+    }
+  }
+}
+
+/**
+ * Run a task on `pool` when one is configured, otherwise inline. Pool
+ * failures fall back to running inline, so enabling workers can never make
+ * a request fail that would have succeeded without them, unless the task's
+ * transferred buffers were already detached.
+ */
+export async function runOnPool<T extends CpuTask>(
+  pool: CpuWorkerPool | undefined,
+  task: T,
+  transfer: ArrayBuffer[] = [],
+): Promise<CpuTaskResult<T>> {
+  if (pool) {
+    try {
+      return await pool.run(task, transfer);
+    } catch (error) {
+      if (transfer.some((buffer) => buffer.byteLength === 0)) throw error;
+      console.warn(`[mem0] Worker task '${task.type}' failed: ${error}`);
+    }
+  }
+  return runCpuTask(task) as CpuTaskResult<T>;
+}
@@ -0,0 +1,67 @@
+/**
+ * CPU-bound stages of the memory pipeline, expressed as plain messages so
+ * they can run either inline or on a worker thread (see cpu_pool.ts).
+ *
+ * Every task must be a pure function of its arguments: workers share no
+ * state with the main thread.
+ */
+import { lemmatizeForBm25 } from "./lemmatization";
+import { ExtractedEntity, extractEntitiesBatch } from "./entity_extraction";
+
+export type CpuTask =
+  | { type: "lemmatize"; texts: string[] }
+  | { type: "extractEntities"; texts: string[] }
+  | {
+      type: "cosineScores";
+      query: Float32Array;
+      vectors: Float32Array;
+      dimension: number;
+    };
+
+export type CpuTaskResult<T extends CpuTask> = T extends { type: "lemmatize" }
+  ? string[]
+  : T extends { type: "extractEntities" }
+    ? ExtractedEntity[][]
+    : Float32Array;
+
+/**
+ * Cosine similarity of `query` against `vectors`, a row-major matrix of
+ * `vectors.length / dimension` rows packed into one buffer so it can be
+ * transferred to a worker without copying.
+ */
+export function cosineScores(
+  query: ArrayLike<number>,
+  vectors: Float32Array,
+  dimension: number,
+): Float32Array {
+  const rows = vectors.length / dimension;
+  const scores = new Float32Array(rows);
+
+  let queryNorm = 0;
+  for (let j = 0; j < dimension; j++) queryNorm += query[j] * query[j];
+  queryNorm = Math.sqrt(queryNorm);
+
+  for (let i = 0; i < rows; i++) {
+    const offset = i * dimension;
+    let dot = 0;
+    let norm = 0;
+    for (let j = 0; j < dimension; j++) {
+      const v = vectors[offset + j];
+      dot += query[j] * v;
+      norm += v * v;
+    }
+    scores[i] = dot / (queryNorm * Math.sqrt(norm));
+  }
+  return scores;
+}
+
+export function runCpuTask(task: CpuTask): CpuTaskResult<CpuTask> {
+  switch (task.type) {
+    case "lemmatize":
+      return task.texts.map(lemmatizeForBm25);
+    case "extractEntities":
+      return extractEntitiesBatch(task.texts);
+    case "cosineScores":
+      return cosineScores(task.query, task.vectors, task.dimension);
+  }
+}
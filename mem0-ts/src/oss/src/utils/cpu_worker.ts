@@ -0,0 +1,19 @@
+/**
+ * Worker-thread entry point for CpuWorkerPool. Built as its own bundle
+ * (dist/oss/cpu_worker.js) so it can be loaded with `new Worker(path)`.
+ */
+import { parentPort } from "worker_threads";
+import { CpuTask, runCpuTask } from "./cpu_tasks";
+
+parentPort?.on("message", (task: CpuTask) => {
+  try {
+    const result = runCpuTask(task);
+    // Hand score buffers back without copying.
+    const transfer = result instanceof Float32Array ? [result.buffer] : [];
+    parentPort!.postMessage({ result }, transfer as ArrayBuffer[]);
+  } catch (error) {
+    parentPort!.postMessage({
+      error: error instanceof Error ? error.message : String(error),
+    });
+  }
+});
@@ -0,0 +1,174 @@
+/**
+ * Single-flight coalescing and a short-lived result cache for search().
+ *
+ * Identical searches issued while one is already running share its result
+ * instead of embedding and querying again. Completed results can be reused
+ * for a short TTL. Entries are tagged with the entity scope (user_id /
+ * agent_id / run_id) of the search and dropped whenever a write touches an
+ * overlapping scope, so a search issued after a write always sees it.
+ */
+
+const SCOPE_KEYS = ["user_id", "agent_id", "run_id"] as const;
+
+export type SearchScope = Partial<
+  Record<(typeof SCOPE_KEYS)[number], unknown>
+>;
+
+export interface SearchCacheStats {
+  requests: number;
+  executions: number;
+  coalesced: number;
+  cacheHits: number;
+  /** Share of searches served without executing. */
+  dedupRate: number;
+  cachedEntries: number;
+}
+
+/** Entity scope of a filters object or memory payload. */
+export function scopeOf(filters: Record<string, any> | undefined): SearchScope {
+  const scope: SearchScope = {};
+  for (const key of SCOPE_KEYS) {
+    if (filters?.[key]) scope[key] = filters[key];
+  }
+  return scope;
+}
+
+/** JSON with sorted object keys, so equal filters give equal cache keys. */
+function canonicalJson(value: unknown): string {
+  return JSON.stringify(value, (_, v) =>
+    v && typeof v === "object" && !Array.isArray(v)
+      ? Object.fromEntries(
+          Object.keys(v)
+            .sort()
+            .map((k) => [k, v[k]]),
+        )
+      : v,
+  );
+}
+
+export function makeSearchKey(
+  query: string,
+  filters: Record<string, any>,
+  ...params: unknown[]
+): string {
+  return canonicalJson([query, filters, ...params]);
+}
+
+// The "*" wildcard and operator values such as {in: [...]} or {ne: ...} can
+// match many ids, so they are treated as overlapping anything rather than
+// interpreted.
+function valuesOverlap(a: unknown, b: unknown): boolean {
+  const isScalar = (v: unknown) =>
+    typeof v === "string" || typeof v === "number";
+  return !isScalar(a) || !isScalar(b) || a === "*" || b === "*" || a === b;
+}
+
+// A write to {user_id: u, agent_id: x} is visible to a search scoped to
+// {user_id: u}, but not to one scoped to {user_id: u, agent_id: y}.
+function scopesOverlap(a: SearchScope, b: SearchScope): boolean {
+  return SCOPE_KEYS.every(
+    (k) => !(k in a) || !(k in b) || valuesOverlap(a[k], b[k]),
+  );
+}
+
+interface CacheEntry<T> {
+  expiresAt: number;
+  scope: SearchScope;
+  value: T;
+}
+
+export class SearchCoalescer<T> {
+  private cache = new Map<string, CacheEntry<T>>();
+  private inflight = new Map<
+    string,
+    { scope: SearchScope; promise: Promise<T> }
+  >();
+  // Bumped by every invalidation; a flight only caches its result if no
+  // write happened while it was running.
+  private generation = 0;
+  private requests = 0;
+  private cacheHits = 0;
+  private coalesced = 0;
+
+  constructor(
+    private readonly ttlMs = 2000,
+    private readonly maxEntries = 1024,
+  ) {}
+
+  async run(
+    key: string,
+    scope: SearchScope,
+    fn: () => Promise<T>,
+  ): Promise<T> {
+    this.requests++;
+
+    const cached = this.cache.get(key);
+    if (cached) {
+      if (cached.expiresAt >= Date.now()) {
+        this.cacheHits++;
+        // Refresh LRU position.
+        this.cache.delete(key);
+        this.cache.set(key, cached);
+        return structuredClone(cached.value);
+      }
+      this.cache.delete(key);
+    }
+
+    const flight = this.inflight.get(key);
+    if (flight) {
+      this.coalesced++;
+      return structuredClone(await flight.promise);
+    }
+
+    const generation = this.generation;
+    const promise = fn().then((value) => structuredClone(value));
+    const entry = { scope, promise };
+    this.inflight.set(key, entry);
+    try {
+      const value = await promise;
+      if (this.ttlMs > 0 && generation === this.generation) {
+        this.cache.set(key, {
+          expiresAt: Date.now() + this.ttlMs,
+          scope,
+          value,
+        });
+        if (this.cache.size > this.maxEntries) {
+          this.cache.delete(this.cache.keys().next().value!);
+        }
+      }
+      return structuredClone(value);
+    } finally {
+      if (this.inflight.get(key) === entry) this.inflight.delete(key);
+    }
+  }
+
+  /** Drop cached and in-flight entries overlapping `scope` (all if omitted). */
+  invalidate(scope?: SearchScope): void {
+    this.generation++;
+    if (!scope) {
+      this.cache.clear();
+      this.inflight.clear();
+      return;
+    }
+    for (const [key, entry] of this.cache) {
+      if (scopesOverlap(entry.scope, scope)) this.cache.delete(key);
+    }
+    // Detach overlapping flights so searches issued after this write start
+    // a fresh execution; existing waiters still get their result.
+    for (const [key, entry] of this.inflight) {
+      if (scopesOverlap(entry.scope, scope)) this.inflight.delete(key);
+    }
+  }
+
+  stats(): SearchCacheStats {
+    const deduped = this.cacheHits + this.coalesced;
+    return {
+      requests: this.requests,
+      executions: this.requests - deduped,
+      coalesced: this.coalesced,
+      cacheHits: this.cacheHits,
+      dedupRate: this.requests ? deduped / this.requests : 0,
+      cachedEntries: this.cache.size,
+    };
+  }
+}
@@ -23,6 +23,11 @@ export interface VectorStore {
     payload: Record<string, any>,
   ): Promise<void>;
   delete(vectorId: string): Promise<void>;
+  // Optional fast paths; callers fall back to update() and a scoped list().
+  updatePayload?(vectorId: string, payload: Record<string, any>): Promise<void>;
+  // Entity rows whose `linkedMemoryIds` contain `memoryId`, answered from an
+  // index in the store itself so every process sharing it sees the same links.
+  listByLinkedMemory?(memoryId: string): Promise<VectorStoreResult[]>;
   deleteCol(): Promise<void>;
   list(
     filters?: SearchFilters,
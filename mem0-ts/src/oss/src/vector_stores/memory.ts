@@ -7,17 +7,17 @@ import {
   ensureSQLiteDirectory,
   getDefaultVectorStoreDbPath,
 } from "../utils/sqlite";
-
-interface MemoryVector {
-  id: string;
-  vector: number[];
-  payload: Record<string, any>;
-}
+import { CpuWorkerPool, runOnPool } from "../utils/cpu_pool";
 
 export class MemoryVectorStore implements VectorStore {
   private db: Database.Database;
   private dimension: number;
   private dbPath: string;
+  private workerPool?: CpuWorkerPool;
+  private statements = new Map<string, Database.Statement>();
+
+  /** Scans smaller than this are scored inline; transfer overhead dominates. */
+  private static readonly MIN_OFFLOAD_ROWS = 2048;
 
   private static readonly CAMEL_TO_SNAKE: Record<string, string> = {
     userId: "user_id",
@@ -25,6 +25,29 @@ export class MemoryVectorStore implements VectorStore {
     runId: "run_id",
   };
 
+  /**
+   * Payload fields promoted to indexed columns, keyed by column name. Each
+   * column is a virtual generated column over the JSON payload, so it can
+   * never drift from the payload and existing rows need no backfill.
+   */
+  private static readonly INDEXED_COLUMNS: Record<string, string[]> = {
+    user_id: ["user_id", "userId"],
+    agent_id: ["agent_id", "agentId"],
+    run_id: ["run_id", "runId"],
+    created_at: ["created_at", "createdAt"],
+    hash: ["hash"],
+  };
+
+  /** Filter keys that can be answered from an indexed column. */
+  private static readonly FILTER_COLUMNS: Record<string, string> = {
+    user_id: "user_id",
+    agent_id: "agent_id",
+    run_id: "run_id",
+    created_at: "created_at",
+    createdAt: "created_at",
+    hash: "hash",
+  };
+
   private normalizePayload(payload: Record<string, any>): Record<string, any> {
     for (const [camel, snake] of Object.entries(
       MemoryVectorStore.CAMEL_TO_SNAKE,
@@ -40,6 +63,7 @@ export class MemoryVectorStore implements VectorStore {
   constructor(config: VectorStoreConfig) {
     this.dimension = config.dimension || 1536; // Default OpenAI dimension
     this.dbPath = config.dbPath || getDefaultVectorStoreDbPath();
+    this.workerPool = config.workerPool;
 
     if (!config.dbPath) {
       const oldDefault = path.join(process.cwd(), "vector_store.db");
@@ -57,14 +81,20 @@ export class MemoryVectorStore implements VectorStore {
   }
 
   private init(): void {
+    this.migrateRowIds();
     this.db.exec(`
       CREATE TABLE IF NOT EXISTS vectors (
-        id TEXT PRIMARY KEY,
+        seq INTEGER PRIMARY KEY,
+        id TEXT NOT NULL UNIQUE,
         vector BLOB NOT NULL,
         payload TEXT NOT NULL
       )
     `);
 
+    this.initIndexedColumns();
+    this.initKeywordIndex();
+    this.initLinkIndex();
+
     this.db.exec(`
       CREATE TABLE IF NOT EXISTS memory_migrations (
         id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -73,7 +103,264 @@ export class MemoryVectorStore implements VectorStore {
     `);
   }
 
-  private cosineSimilarity(a: number[], b: number[]): number {
+  /**
+   * Rebuild tables created with `id TEXT PRIMARY KEY`. Their rowid is
+   * implicit and VACUUM may renumber it, which would point the keyword index
+   * at the wrong rows; `seq` aliases the rowid so it stays stable. Current
+   * rowids are carried over and the keyword index is rebuilt regardless.
+   */
+  private migrateRowIds(): void {
+    const columns = this.db
+      .prepare(`PRAGMA table_info(vectors)`)
+      .all() as any[];
+    if (columns.length === 0 || columns.some((col) => col.name === "seq")) {
+      return;
+    }
+    this.db.transaction(() => {
+      this.db.exec(`
+        CREATE TABLE vectors_migrated (
+          seq INTEGER PRIMARY KEY,
+          id TEXT NOT NULL UNIQUE,
+          vector BLOB NOT NULL,
+          payload TEXT NOT NULL
+        );
+        INSERT INTO vectors_migrated (seq, id, vector, payload)
+          SELECT rowid, id, vector, payload FROM vectors;
+        DROP TABLE vectors;
+        ALTER TABLE vectors_migrated RENAME TO vectors;
+        DROP TABLE IF EXISTS vectors_fts;
+      `);
+    })();
+  }
+
+  /**
+   * Add the indexed payload columns, migrating databases created before they
+   * existed. `table_xinfo` is used because generated columns are hidden from
+   * `table_info`.
+   */
+  private initIndexedColumns(): void {
+    const existing = new Set(
+      (this.db.prepare(`PRAGMA table_xinfo(vectors)`).all() as any[]).map(
+        (col) => col.name,
+      ),
+    );
+    for (const [column, keys] of Object.entries(
+      MemoryVectorStore.INDEXED_COLUMNS,
+    )) {
+      if (!existing.has(column)) {
+        const expr = keys
+          .map((key) => `json_extract(payload, '$.${key}')`)
+          .join(", ");
+        const value = keys.length > 1 ? `coalesce(${expr})` : expr;
+        this.db.exec(
+          `ALTER TABLE vectors ADD COLUMN ${column} GENERATED ALWAYS AS (${value}) VIRTUAL`,
+        );
+      }
+      this.db.exec(
+        `CREATE INDEX IF NOT EXISTS idx_vectors_${column} ON vectors (${column})`,
+      );
+    }
+  }
+
+  /**
+   * Translate a single field condition on an indexed column into SQL, or
+   * return null when it must be evaluated in JS. NULL handling mirrors the
+   * JS semantics, where a missing field compares as `undefined`.
+   */
+  private columnCondition(
+    col: string,
+    value: any,
+  ): { clause: string; params: any[] } | null {
+    const isScalar = (v: any) =>
+      typeof v === "string" || (typeof v === "number" && Number.isFinite(v));
+    const isScalarList = (v: any) =>
+      Array.isArray(v) && v.length > 0 && v.every(isScalar);
+    const placeholders = (v: any[]) => v.map(() => "?").join(", ");
+
+    if (value === "*") return null;
+    if (isScalar(value)) return { clause: `${col} = ?`, params: [value] };
+    if (isScalarList(value)) {
+      return { clause: `${col} IN (${placeholders(value)})`, params: value };
+    }
+    if (typeof value !== "object" || value === null || Array.isArray(value)) {
+      return null;
+    }
+
+    const entries = Object.entries(value);
+    if (entries.length !== 1) return null;
+    const [op, operand] = entries[0] as [string, any];
+    const comparisons: Record<string, string> = {
+      eq: "=",
+      ne: "IS NOT",
+      gt: ">",
+      gte: ">=",
+      lt: "<",
+      lte: "<=",
+    };
+
+    if (op in comparisons && isScalar(operand)) {
+      return { clause: `${col} ${comparisons[op]} ?`, params: [operand] };
+    }
+    if (op === "in" && isScalarList(operand)) {
+      return { clause: `${col} IN (${placeholders(operand)})`, params: operand };
+    }
+    if (op === "nin" && isScalarList(operand)) {
+      return {
+        clause: `(${col} IS NULL OR ${col} NOT IN (${placeholders(operand)}))`,
+        params: operand,
+      };
+    }
+    return null;
+  }
+
+  /**
+   * Split filters into a SQL condition over the indexed columns (`"1"` when
+   * nothing can be pushed down) and the remaining filters, which are still
+   * evaluated in JS by `filterVector`. Only top-level conditions on indexed
+   * keys are pushed down; logical operators and other payload fields always
+   * stay in JS.
+   */
+  private buildSqlFilter(
+    filters?: SearchFilters,
+    alias = "",
+  ): { where: string; params: any[]; residual: SearchFilters } {
+    const clauses: string[] = [];
+    const params: any[] = [];
+    const residual: SearchFilters = {};
+
+    for (const [key, value] of Object.entries(filters || {})) {
+      const column = MemoryVectorStore.FILTER_COLUMNS[key];
+      const condition = column
+        ? this.columnCondition(`${alias}${column}`, value)
+        : null;
+      if (condition) {
+        clauses.push(condition.clause);
+        params.push(...condition.params);
+      } else {
+        residual[key] = value;
+      }
+    }
+
+    return {
+      where: clauses.length > 0 ? clauses.join(" AND ") : "1",
+      params,
+      residual,
+    };
+  }
+
+  /**
+   * Create the FTS5 inverted index used by keywordSearch and keep it in sync
+   * with the vectors table through triggers. Rows share rowids with
+   * `vectors` (its `seq` column), so the index never needs to be scanned to
+   * find a document.
+   * Databases created before the index existed are backfilled once.
+   */
+  private initKeywordIndex(): void {
+    const exists = this.db
+      .prepare(
+        `SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'vectors_fts'`,
+      )
+      .get();
+
+    // Index the lemmatized text, falling back to raw `data` for payloads
+    // written without it (e.g. entity rows).
+    const text = (payload: string) =>
+      `coalesce(nullif(json_extract(${payload}, '$.textLemmatized'), ''), json_extract(${payload}, '$.data'), '')`;
+
+    this.db.exec(`
+      CREATE VIRTUAL TABLE IF NOT EXISTS vectors_fts USING fts5(
+        text,
+        tokenize = 'unicode61'
+      );
+
+      CREATE TRIGGER IF NOT EXISTS vectors_fts_insert AFTER INSERT ON vectors BEGIN
+        INSERT INTO vectors_fts (rowid, text) VALUES (new.rowid, ${text("new.payload")});
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS vectors_fts_delete AFTER DELETE ON vectors BEGIN
+        DELETE FROM vectors_fts WHERE rowid = old.rowid;
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS vectors_fts_update AFTER UPDATE OF payload ON vectors BEGIN
+        DELETE FROM vectors_fts WHERE rowid = old.rowid;
+        INSERT INTO vectors_fts (rowid, text) VALUES (new.rowid, ${text("new.payload")});
+      END;
+    `);
+
+    if (!exists) {
+      this.db.exec(
+        `INSERT INTO vectors_fts (rowid, text) SELECT rowid, ${text("payload")} FROM vectors`,
+      );
+    }
+  }
+
+  /**
+   * Index entity rows by the memory ids in their `linkedMemoryIds`, so
+   * entity cleanup can find the rows for one memory without a scan. Kept in
+   * the same database as the rows, and in sync through triggers, so every
+   * process sharing the file sees the same links. Databases created before
+   * the index existed are backfilled once.
+   */
+  private initLinkIndex(): void {
+    const exists = this.db
+      .prepare(
+        `SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'vector_links'`,
+      )
+      .get();
+
+    const links = (row: string) =>
+      `SELECT value, ${row}.id FROM json_each(${row}.payload, '$.linkedMemoryIds')`;
+
+    this.db.exec(`
+      CREATE TABLE IF NOT EXISTS vector_links (
+        memory_id TEXT NOT NULL,
+        vector_id TEXT NOT NULL,
+        PRIMARY KEY (memory_id, vector_id)
+      ) WITHOUT ROWID;
+
+      CREATE INDEX IF NOT EXISTS idx_vector_links_vector_id
+        ON vector_links (vector_id);
+
+      CREATE TRIGGER IF NOT EXISTS vector_links_insert AFTER INSERT ON vectors BEGIN
+        INSERT OR IGNORE INTO vector_links (memory_id, vector_id) ${links("new")};
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS vector_links_delete AFTER DELETE ON vectors BEGIN
+        DELETE FROM vector_links WHERE vector_id = old.id;
+      END;
+
+      CREATE TRIGGER IF NOT EXISTS vector_links_update AFTER UPDATE OF payload ON vectors BEGIN
+        DELETE FROM vector_links WHERE vector_id = old.id;
+        INSERT OR IGNORE INTO vector_links (memory_id, vector_id) ${links("new")};
+      END;
+    `);
+
+    if (!exists) {
+      this.db.exec(
+        `INSERT OR IGNORE INTO vector_links (memory_id, vector_id)
+         SELECT l.value, v.id FROM vectors v, json_each(v.payload, '$.linkedMemoryIds') l`,
+      );
+    }
+  }
+
+  /**
+   * Prepare `sql` once per connection. Filtered queries vary with the shape
+   * of the filters, so the cache is bounded by simply starting over.
+   */
+  private prepare(sql: string): Database.Statement {
+    let stmt = this.statements.get(sql);
+    if (!stmt) {
+      if (this.statements.size >= 256) this.statements.clear();
+      stmt = this.db.prepare(sql);
+      this.statements.set(sql, stmt);
+    }
+    return stmt;
+  }
+
+  private cosineSimilarity(
+    a: ArrayLike<number>,
+    b: ArrayLike<number>,
+  ): number {
     let dotProduct = 0;
     let normA = 0;
     let normB = 0;
@@ -154,10 +441,13 @@ export class MemoryVectorStore implements VectorStore {
   }
 
   /**
-   * Filter a vector by the given filters.
+   * Filter a payload by the given filters.
    * Supports logical operators (AND, OR, NOT) and comparison operators.
    */
-  private filterVector(vector: MemoryVector, filters?: SearchFilters): boolean {
+  private filterVector(
+    payload: Record<string, any>,
+    filters?: SearchFilters,
+  ): boolean {
     if (!filters || Object.keys(filters).length === 0) return true;
 
     // Normalize $or/$not/$and → OR/NOT/AND
@@ -184,7 +474,7 @@ export class MemoryVectorStore implements VectorStore {
         }
         // All conditions must match
         const allMatch = value.every((sub: SearchFilters) =>
-          this.filterVector(vector, sub),
+          this.filterVector(payload, sub),
         );
         if (!allMatch) return false;
       } else if (key === "OR") {
@@ -195,7 +485,7 @@ export class MemoryVectorStore implements VectorStore {
         }
         // At least one condition must match
         const anyMatch = value.some((sub: SearchFilters) =>
-          this.filterVector(vector, sub),
+          this.filterVector(payload, sub),
         );
         if (!anyMatch) return false;
       } else if (key === "NOT") {
@@ -206,12 +496,12 @@ export class MemoryVectorStore implements VectorStore {
         }
         // None of the conditions should match
         const noneMatch = value.every(
-          (sub: SearchFilters) => !this.filterVector(vector, sub),
+          (sub: SearchFilters) => !this.filterVector(payload, sub),
         );
         if (!noneMatch) return false;
       } else {
         // Regular field condition
-        if (!this.matchFieldCondition(vector.payload, key, value)) {
+        if (!this.matchFieldCondition(payload, key, value)) {
           return false;
         }
       }
@@ -225,27 +515,41 @@ export class MemoryVectorStore implements VectorStore {
     ids: string[],
     payloads: Record<string, any>[],
   ): Promise<void> {
-    const stmt = this.db.prepare(
-      `INSERT OR REPLACE INTO vectors (id, vector, payload) VALUES (?, ?, ?)`,
-    );
-    const insertMany = this.db.transaction(
-      (vecs: number[][], vIds: string[], vPayloads: Record<string, any>[]) => {
-        for (let i = 0; i < vecs.length; i++) {
-          if (vecs[i].length !== this.dimension) {
-            throw new Error(
-              `Vector dimension mismatch. Expected ${this.dimension}, got ${vecs[i].length}`,
-            );
-          }
-          const vectorBuffer = Buffer.from(new Float32Array(vecs[i]).buffer);
-          stmt.run(vIds[i], vectorBuffer, JSON.stringify(vPayloads[i]));
-        }
-      },
+    const rows = vectors.map((vector, i) => {
+      if (vector.length !== this.dimension) {
+        throw new Error(
+          `Vector dimension mismatch. Expected ${this.dimension}, got ${vector.length}`,
+        );
+      }
+      return [
+        ids[i],
+        Buffer.from(new Float32Array(vector).buffer),
+        JSON.stringify(payloads[i]),
+      ];
+    });
+
+    // Upsert rather than INSERT OR REPLACE: REPLACE deletes the old row
+    // without firing delete triggers, which would orphan its FTS entry.
+    const stmt = this.prepare(
+      `INSERT INTO vectors (id, vector, payload) VALUES (?, ?, ?)
+       ON CONFLICT(id) DO UPDATE SET vector = excluded.vector, payload = excluded.payload`,
     );
-    insertMany(vectors, ids, payloads);
+    this.db.transaction(() => {
+      for (const row of rows) stmt.run(...row);
+    })();
   }
 
-  private tokenize(text: string): string[] {
-    return text.toLowerCase().split(/\s+/).filter(Boolean);
+  /**
+   * Build an FTS5 MATCH expression that ORs every query token. Each token is
+   * quoted so user text can never be parsed as FTS5 query syntax.
+   */
+  private buildMatchQuery(query: string): string | null {
+    const terms = query
+      .toLowerCase()
+      .split(/\s+/)
+      .filter((t) => /[\p{L}\p{N}]/u.test(t))
+      .map((t) => `"${t.replace(/"/g, '""')}"`);
+    return terms.length > 0 ? terms.join(" OR ") : null;
   }
 
   async keywordSearch(
@@ -254,94 +558,29 @@ export class MemoryVectorStore implements VectorStore {
     filters?: SearchFilters,
   ): Promise<VectorStoreResult[] | null> {
     try {
-      const rows = this.db.prepare(`SELECT * FROM vectors`).all() as any[];
-
-      // Collect documents that pass the filter
-      const candidates: {
-        id: string;
-        payload: Record<string, any>;
-        tokens: string[];
-      }[] = [];
-
-      for (const row of rows) {
-        const payload = this.normalizePayload(JSON.parse(row.payload));
-        const memoryVector: MemoryVector = {
-          id: row.id,
-          vector: Array.from(
-            new Float32Array(
-              row.vector.buffer,
-              row.vector.byteOffset,
-              row.vector.byteLength / 4,
-            ),
-          ),
-          payload,
-        };
-
-        if (this.filterVector(memoryVector, filters)) {
-          const text = payload.textLemmatized || payload.data || "";
-          candidates.push({ id: row.id, payload, tokens: this.tokenize(text) });
-        }
-      }
-
-      if (candidates.length === 0) {
+      const match = this.buildMatchQuery(query);
+      if (!match) {
         return [];
       }
 
-      const tokenizedQuery = this.tokenize(query);
-      if (tokenizedQuery.length === 0) {
-        return [];
-      }
+      const { where, params, residual } = this.buildSqlFilter(filters, "v.");
 
-      // Compute BM25 scores inline
-      const k1 = 1.5;
-      const b = 0.75;
-      const N = candidates.length;
-      const avgDocLength =
-        candidates.reduce((sum, c) => sum + c.tokens.length, 0) / N;
-
-      // Compute document frequency for query terms
-      const docFreq = new Map<string, number>();
-      for (const term of tokenizedQuery) {
-        if (!docFreq.has(term)) {
-          let count = 0;
-          for (const c of candidates) {
-            if (c.tokens.includes(term)) count++;
-          }
-          docFreq.set(term, count);
-        }
-      }
+      // bm25() is negative (lower is better); negate it so callers get the
+      // usual positive, higher-is-better BM25 score.
+      const rows = this.prepare(
+        `SELECT v.id, v.payload, -bm25(vectors_fts) AS score
+         FROM vectors_fts JOIN vectors v ON v.rowid = vectors_fts.rowid
+         WHERE vectors_fts MATCH ? AND ${where}
+         ORDER BY rank`,
+      ).iterate(match, ...params) as IterableIterator<any>;
 
-      // Compute IDF for query terms
-      const idf = new Map<string, number>();
-      for (const [term, freq] of docFreq) {
-        idf.set(term, Math.log((N - freq + 0.5) / (freq + 0.5) + 1));
+      const results: VectorStoreResult[] = [];
+      for (const row of rows) {
+        const payload = this.normalizePayload(JSON.parse(row.payload));
+        if (!this.filterVector(payload, residual)) continue;
+        results.push({ id: row.id, payload, score: row.score });
+        if (results.length >= topK) break;
       }
-
-      // Score each candidate
-      const scored = candidates.map((candidate) => {
-        let score = 0;
-        const docLength = candidate.tokens.length;
-        for (const term of tokenizedQuery) {
-          const tf = candidate.tokens.filter((t) => t === term).length;
-          const termIdf = idf.get(term) || 0;
-          score +=
-            (termIdf * tf * (k1 + 1)) /
-            (tf + k1 * (1 - b + (b * docLength) / avgDocLength));
-        }
-        return { ...candidate, score };
-      });
-
-      // Filter out zero-score documents and sort descending
-      const results = scored
-        .filter((s) => s.score > 0)
-        .sort((a, b) => b.score - a.score)
-        .slice(0, topK)
-        .map((s) => ({
-          id: s.id,
-          payload: s.payload,
-          score: s.score,
-        }));
-
       return results;
     } catch (error) {
       console.error("Error during keyword search:", error);
@@ -360,40 +599,70 @@ export class MemoryVectorStore implements VectorStore {
       );
     }
 
-    const rows = this.db.prepare(`SELECT * FROM vectors`).all() as any[];
+    const { where, params, residual } = this.buildSqlFilter(filters);
+    const rows = this.prepare(
+      `SELECT id, vector, payload FROM vectors WHERE ${where}`,
+    ).iterate(...params) as IterableIterator<any>;
     const results: VectorStoreResult[] = [];
+    const blobs: Buffer[] = [];
 
     for (const row of rows) {
-      const vector = new Float32Array(
-        row.vector.buffer,
-        row.vector.byteOffset,
-        row.vector.byteLength / 4,
-      );
       const payload = this.normalizePayload(JSON.parse(row.payload));
-      const memoryVector: MemoryVector = {
-        id: row.id,
-        vector: Array.from(vector),
-        payload,
-      };
+      if (!this.filterVector(payload, residual)) continue;
+      results.push({ id: row.id, payload });
+      blobs.push(row.vector);
+    }
 
-      if (this.filterVector(memoryVector, filters)) {
-        const score = this.cosineSimilarity(query, Array.from(vector));
-        results.push({
-          id: memoryVector.id,
-          payload: memoryVector.payload,
-          score,
-        });
-      }
+    const scores = await this.scoreVectors(query, blobs);
+    for (let i = 0; i < results.length; i++) {
+      results[i].score = scores[i];
     }
 
     results.sort((a, b) => (b.score || 0) - (a.score || 0));
     return results.slice(0, topK);
   }
 
+  /**
+   * Cosine similarity of `query` against each stored vector blob. Large
+   * scans are packed into one Float32Array and transferred to the worker
+   * pool (when configured) so scoring does not block the event loop.
+   */
+  private async scoreVectors(
+    query: number[],
+    blobs: Buffer[],
+  ): Promise<ArrayLike<number>> {
+    if (
+      !this.workerPool ||
+      blobs.length < MemoryVectorStore.MIN_OFFLOAD_ROWS
+    ) {
+      return blobs.map((blob) =>
+        this.cosineSimilarity(
+          query,
+          new Float32Array(blob.buffer, blob.byteOffset, blob.byteLength / 4),
+        ),
+      );
+    }
+
+    const vectors = new Float32Array(blobs.length * this.dimension);
+    const bytes = new Uint8Array(vectors.buffer);
+    blobs.forEach((blob, i) => bytes.set(blob, i * this.dimension * 4));
+    const queryVector = new Float32Array(query);
+    return runOnPool(
+      this.workerPool,
+      {
+        type: "cosineScores",
+        query: queryVector,
+        vectors,
+        dimension: this.dimension,
+      },
+      [vectors.buffer, queryVector.buffer],
+    );
+  }
+
   async get(vectorId: string): Promise<VectorStoreResult | null> {
-    const row = this.db
-      .prepare(`SELECT * FROM vectors WHERE id = ?`)
-      .get(vectorId) as any;
+    const row = this.prepare(`SELECT * FROM vectors WHERE id = ?`).get(
+      vectorId,
+    ) as any;
     if (!row) return null;
 
     const payload = this.normalizePayload(JSON.parse(row.payload));
@@ -414,17 +683,44 @@ export class MemoryVectorStore implements VectorStore {
       );
     }
     const vectorBuffer = Buffer.from(new Float32Array(vector).buffer);
-    this.db
-      .prepare(`UPDATE vectors SET vector = ?, payload = ? WHERE id = ?`)
-      .run(vectorBuffer, JSON.stringify(payload), vectorId);
+    this.prepare(`UPDATE vectors SET vector = ?, payload = ? WHERE id = ?`).run(
+      vectorBuffer,
+      JSON.stringify(payload),
+      vectorId,
+    );
+  }
+
+  async updatePayload(
+    vectorId: string,
+    payload: Record<string, any>,
+  ): Promise<void> {
+    this.prepare(`UPDATE vectors SET payload = ? WHERE id = ?`).run(
+      JSON.stringify(payload),
+      vectorId,
+    );
   }
 
   async delete(vectorId: string): Promise<void> {
-    this.db.prepare(`DELETE FROM vectors WHERE id = ?`).run(vectorId);
+    this.prepare(`DELETE FROM vectors WHERE id = ?`).run(vectorId);
+  }
+
+  async listByLinkedMemory(memoryId: string): Promise<VectorStoreResult[]> {
+    const rows = this.prepare(
+      `SELECT v.id, v.payload FROM vector_links l
+       JOIN vectors v ON v.id = l.vector_id
+       WHERE l.memory_id = ?`,
+    ).all(memoryId) as any[];
+    return rows.map((row) => ({
+      id: row.id,
+      payload: this.normalizePayload(JSON.parse(row.payload)),
+    }));
   }
 
   async deleteCol(): Promise<void> {
+    this.statements.clear();
     this.db.exec(`DROP TABLE IF EXISTS vectors`);
+    this.db.exec(`DROP TABLE IF EXISTS vectors_fts`);
+    this.db.exec(`DROP TABLE IF EXISTS vector_links`);
     this.init();
   }
 
@@ -432,38 +728,46 @@ export class MemoryVectorStore implements VectorStore {
     filters?: SearchFilters,
     topK: number = 100,
   ): Promise<[VectorStoreResult[], number]> {
-    const rows = this.db.prepare(`SELECT * FROM vectors`).all() as any[];
+    const { where, params, residual } = this.buildSqlFilter(filters);
+
+    // Fully pushed-down filters can be counted and paged in SQL; otherwise
+    // every candidate row still has to be checked against the JS filters.
+    if (Object.keys(residual).length === 0) {
+      const { total } = this.prepare(
+        `SELECT COUNT(*) AS total FROM vectors WHERE ${where}`,
+      ).get(...params) as { total: number };
+      const rows = this.prepare(
+        `SELECT id, payload FROM vectors WHERE ${where} LIMIT ?`,
+      ).all(...params, topK) as any[];
+      const results = rows.map((row) => ({
+        id: row.id,
+        payload: this.normalizePayload(JSON.parse(row.payload)),
+      }));
+      return [results, total];
+    }
+
+    const rows = this.prepare(
+      `SELECT id, payload FROM vectors WHERE ${where}`,
+    ).iterate(...params) as IterableIterator<any>;
     const results: VectorStoreResult[] = [];
+    let total = 0;
 
     for (const row of rows) {
       const payload = this.normalizePayload(JSON.parse(row.payload));
-      const memoryVector: MemoryVector = {
-        id: row.id,
-        vector: Array.from(
-          new Float32Array(
-            row.vector.buffer,
-            row.vector.byteOffset,
-            row.vector.byteLength / 4,
-          ),
-        ),
-        payload,
-      };
-
-      if (this.filterVector(memoryVector, filters)) {
-        results.push({
-          id: memoryVector.id,
-          payload: memoryVector.payload,
-        });
+      if (!this.filterVector(payload, residual)) continue;
+      if (results.length < topK) {
+        results.push({ id: row.id, payload });
       }
+      total++;
     }
 
-    return [results.slice(0, topK), results.length];
+    return [results, total];
   }
 
   async getUserId(): Promise<string> {
-    const row = this.db
-      .prepare(`SELECT user_id FROM memory_migrations LIMIT 1`)
-      .get() as any;
+    const row = this.prepare(
+      `SELECT user_id FROM memory_migrations LIMIT 1`,
+    ).get() as any;
     if (row) {
       return row.user_id;
     }
@@ -472,17 +776,17 @@ export class MemoryVectorStore implements VectorStore {
     const randomUserId =
       Math.random().toString(36).substring(2, 15) +
       Math.random().toString(36).substring(2, 15);
-    this.db
-      .prepare(`INSERT INTO memory_migrations (user_id) VALUES (?)`)
-      .run(randomUserId);
+    this.prepare(`INSERT INTO memory_migrations (user_id) VALUES (?)`).run(
+      randomUserId,
+    );
     return randomUserId;
   }
 
   async setUserId(userId: string): Promise<void> {
-    this.db.prepare(`DELETE FROM memory_migrations`).run();
-    this.db
-      .prepare(`INSERT INTO memory_migrations (user_id) VALUES (?)`)
-      .run(userId);
+    this.prepare(`DELETE FROM memory_migrations`).run();
+    this.prepare(`INSERT INTO memory_migrations (user_id) VALUES (?)`).run(
+      userId,
+    );
   }
 
   async initialize(): Promise<void> {
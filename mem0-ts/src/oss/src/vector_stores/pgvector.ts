@@ -338,6 +338,18 @@ export class PGVector implements VectorStore {
         console.warn("HNSW index creation failed:", error);
       }
     }
+
+    // Serves listByLinkedMemory() for entity collections; rows without
+    // `linkedMemoryIds` are not indexed.
+    try {
+      await this.client.query(`
+        CREATE INDEX IF NOT EXISTS ${escapeIdentifier(this.collectionName + "_linked_idx")}
+        ON ${this.col()}
+        USING gin ((payload->'linkedMemoryIds'));
+      `);
+    } catch (error) {
+      console.warn("Linked memory index creation failed:", error);
+    }
   }
 
   async insert(
@@ -464,12 +476,33 @@ export class PGVector implements VectorStore {
     );
   }
 
+  async updatePayload(
+    vectorId: string,
+    payload: Record<string, any>,
+  ): Promise<void> {
+    await this.client.query(
+      `UPDATE ${this.col()} SET payload = $1::jsonb WHERE id = $2`,
+      [payload, vectorId],
+    );
+  }
+
   async delete(vectorId: string): Promise<void> {
     await this.client.query(`DELETE FROM ${this.col()} WHERE id = $1`, [
       vectorId,
     ]);
   }
 
+  async listByLinkedMemory(memoryId: string): Promise<VectorStoreResult[]> {
+    const result = await this.client.query(
+      `SELECT id, payload FROM ${this.col()} WHERE payload->'linkedMemoryIds' ? $1`,
+      [memoryId],
+    );
+    return result.rows.map((row) => ({
+      id: row.id,
+      payload: row.payload,
+    }));
+  }
+
   async deleteCol(): Promise<void> {
     await this.client.query(`DROP TABLE IF EXISTS ${this.col()}`);
   }
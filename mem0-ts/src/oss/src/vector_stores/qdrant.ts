@@ -334,12 +334,38 @@ export class Qdrant implements VectorStore {
     });
   }
 
+  async updatePayload(
+    vectorId: string,
+    payload: Record<string, any>,
+  ): Promise<void> {
+    await this.client.overwritePayload(this.collectionName, {
+      points: [vectorId],
+      payload,
+    });
+  }
+
   async delete(vectorId: string): Promise<void> {
     await this.client.delete(this.collectionName, {
       points: [vectorId],
     });
   }
 
+  async listByLinkedMemory(memoryId: string): Promise<VectorStoreResult[]> {
+    // A match on an array field hits points where any element matches.
+    const response = await this.client.scroll(this.collectionName, {
+      limit: 1000,
+      filter: {
+        must: [{ key: "linkedMemoryIds", match: { value: memoryId } }],
+      },
+      with_payload: true,
+      with_vectors: false,
+    });
+    return response.points.map((point) => ({
+      id: String(point.id),
+      payload: (point.payload as Record<string, any>) || {},
+    }));
+  }
+
   async deleteCol(): Promise<void> {
     await this.client.deleteCollection(this.collectionName);
   }
@@ -0,0 +1,122 @@
+/**
+ * BM25Index tests — scores match the textbook formula over the live corpus,
+ * add/remove keep statistics consistent, and top-k selection is ordered.
+ */
+/// <reference types="jest" />
+import { BM25Index } from "../src/utils/bm25";
+
+function referenceScores(
+  docs: Array<[string, string[]]>,
+  query: string[],
+  k1 = 1.5,
+  b = 0.75,
+): Array<{ id: string; score: number }> {
+  const N = docs.length;
+  const avg = docs.reduce((sum, [, d]) => sum + d.length, 0) / N;
+  const df = new Map<string, number>();
+  for (const [, doc] of docs) {
+    for (const term of new Set(doc)) df.set(term, (df.get(term) || 0) + 1);
+  }
+  return docs
+    .map(([id, doc]) => {
+      let score = 0;
+      for (const term of query) {
+        const tf = doc.filter((t) => t === term).length;
+        const n = df.get(term) || 0;
+        const idf = Math.log((N - n + 0.5) / (n + 0.5) + 1);
+        const norm = k1 * (1 - b + (b * doc.length) / avg);
+        score += (idf * tf * (k1 + 1)) / (tf + norm);
+      }
+      return { id, score };
+    })
+    .filter((r) => r.score > 0)
+    .sort((x, y) => y.score - x.score);
+}
+
+describe("BM25Index", () => {
+  const vocab = ["alice", "berlin", "cello", "dog", "espresso", "falcon"];
+  let seed = 7;
+  const random = () => (seed = (seed * 16807) % 2147483647) / 2147483647;
+
+  const docs: Array<[string, string[]]> = Array.from(
+    { length: 200 },
+    (_, i) => [
+      `d${i}`,
+      Array.from(
+        { length: 1 + (i % 11) },
+        () => vocab[Math.floor(random() * vocab.length)],
+      ),
+    ],
+  );
+
+  test("matches reference scoring after adds and removes", () => {
+    const index = new BM25Index();
+    for (const [id, terms] of docs) index.add(id, terms);
+    for (let i = 0; i < docs.length; i += 4) index.remove(`d${i}`);
+    const live = docs.filter((_, i) => i % 4 !== 0);
+    expect(index.size).toBe(live.length);
+
+    const query = ["berlin", "cello", "cello", "falcon"];
+    const expected = referenceScores(live, query).slice(0, 10);
+    const actual = index.search(query, 10);
+    expect(actual).toHaveLength(10);
+    actual.forEach((hit, i) => {
+      expect(hit.score).toBeCloseTo(expected[i].score, 9);
+    });
+  });
+
+  test("re-adding an id replaces the previous document", () => {
+    const index = new BM25Index();
+    index.add("m1", ["alice", "berlin"]);
+    index.add("m2", ["dog"]);
+    index.add("m1", ["espresso"]);
+
+    expect(index.size).toBe(2);
+    expect(index.search(["berlin"], 5)).toEqual([]);
+    expect(index.search(["espresso"], 5).map((h) => h.id)).toEqual(["m1"]);
+  });
+
+  test("only returns documents containing a query term, best first", () => {
+    const index = new BM25Index();
+    index.add("a", ["dog", "dog", "park"]);
+    index.add("b", ["dog", "cat", "park", "walk", "river"]);
+    index.add("c", ["cat"]);
+
+    const hits = index.search(["dog"], 10);
+    expect(hits.map((h) => h.id)).toEqual(["a", "b"]);
+    expect(hits[0].score).toBeGreaterThan(hits[1].score);
+  });
+
+  test("accept callback filters before hits take a top-k slot", () => {
+    const index = new BM25Index();
+    for (const [id, terms] of docs) index.add(id, terms);
+
+    const hits = index.search(["alice"], 5, (id) => id.endsWith("3"));
+    expect(hits.length).toBeGreaterThan(0);
+    expect(hits.length).toBeLessThanOrEqual(5);
+    expect(hits.every((h) => h.id.endsWith("3"))).toBe(true);
+    for (let i = 1; i < hits.length; i++) {
+      expect(hits[i - 1].score).toBeGreaterThanOrEqual(hits[i].score);
+    }
+  });
+
+  test("empty terms do not count towards document length", () => {
+    const padded = new BM25Index();
+    padded.add("a", ["dog", "", "", "", ""]);
+    padded.add("b", ["dog", "cat"]);
+    const plain = new BM25Index();
+    plain.add("a", ["dog"]);
+    plain.add("b", ["dog", "cat"]);
+
+    expect(padded.search(["dog"], 2)).toEqual(plain.search(["dog"], 2));
+  });
+
+  test("empty index and unknown terms return no hits", () => {
+    const index = new BM25Index();
+    expect(index.search(["alice"], 5)).toEqual([]);
+    index.add("m1", ["alice"]);
+    expect(index.search(["zebra"], 5)).toEqual([]);
+    index.clear();
+    expect(index.size).toBe(0);
+  });
+});
@@ -0,0 +1,117 @@
+/**
+ * CpuWorkerPool tests — worker results match inline execution, transferred
+ * vector scans score correctly, exited workers are replaced, and a closed
+ * pool falls back to inline.
+ */
+/// <reference types="jest" />
+import { CpuWorkerPool, runOnPool } from "../src/utils/cpu_pool";
+import { cosineScores, runCpuTask } from "../src/utils/cpu_tasks";
+import { MemoryVectorStore } from "../src/vector_stores/memory";
+
+jest.setTimeout(30000);
+
+describe("CpuWorkerPool", () => {
+  let pool: CpuWorkerPool;
+
+  beforeAll(() => {
+    pool = new CpuWorkerPool(2);
+  });
+
+  afterAll(async () => {
+    await pool.close();
+  });
+
+  test("lemmatize and extractEntities match inline results", async () => {
+    const texts = [
+      "Alice is running the Berlin marathon next spring",
+      'She named her project "Blue Falcon"',
+    ];
+    for (const type of ["lemmatize", "extractEntities"] as const) {
+      const inline = runCpuTask({ type, texts });
+      const pooled = await pool.run({ type, texts });
+      expect(pooled).toEqual(inline);
+    }
+  });
+
+  test("cosineScores transfers buffers and returns one score per row", async () => {
+    const query = new Float32Array([1, 0]);
+    const vectors = new Float32Array([1, 0, 0, 1, 1, 1]);
+    const expected = cosineScores(query, vectors.slice(), 2);
+
+    const scores = await pool.run(
+      { type: "cosineScores", query, vectors, dimension: 2 },
+      [vectors.buffer],
+    );
+    expect(vectors.byteLength).toBe(0); // moved, not copied
+    expect(Array.from(scores)).toEqual(Array.from(expected));
+  });
+
+  test("runs concurrent jobs beyond the pool size", async () => {
+    const jobs = Array.from({ length: 10 }, (_, i) =>
+      pool.run({ type: "lemmatize", texts: [`running ${i}`] }),
+    );
+    const results = await Promise.all(jobs);
+    expect(results).toHaveLength(10);
+    expect(pool.queueDepth).toBe(0);
+  });
+
+  test("a worker that exits mid-task fails the job and is replaced", async () => {
+    const running = pool.run({ type: "lemmatize", texts: ["running"] });
+    const [worker] = (pool as any).busy.keys();
+    await worker.terminate();
+
+    await expect(running).rejects.toThrow("exited");
+    expect(pool.size).toBe(2);
+    const result = await pool.run({ type: "lemmatize", texts: ["running"] });
+    expect(result).toEqual(
+      runCpuTask({ type: "lemmatize", texts: ["running"] }),
+    );
+  });
+
+  test("runOnPool falls back to inline once the pool is closed", async () => {
+    const closed = new CpuWorkerPool(1);
+    await closed.close();
+    const warn = jest.spyOn(console, "warn").mockImplementation(() => {});
+    const result = await runOnPool(closed, {
+      type: "lemmatize",
+      texts: ["running"],
+    });
+    warn.mockRestore();
+    expect(result).toEqual(
+      runCpuTask({ type: "lemmatize", texts: ["running"] }),
+    );
+  });
+
+  test("MemoryVectorStore scores large scans on the pool", async () => {
+    const dim = 4;
+    const count = 2100; // above the inline-scoring cutoff
+    const vectors = Array.from({ length: count }, (_, i) => [
+      Math.cos(i),
+      Math.sin(i),
+      (i % 7) / 7,
+      1,
+    ]);
+    const ids = vectors.map((_, i) => `v${i}`);
+    const payloads = ids.map(() => ({ data: "x", user_id: "u1" }));
+
+    const inline = new MemoryVectorStore({
+      dimension: dim,
+      dbPath: ":memory:",
+    });
+    const pooled = new MemoryVectorStore({
+      dimension: dim,
+      dbPath: ":memory:",
+      workerPool: pool,
+    });
+    await inline.insert(vectors, ids, payloads);
+    await pooled.insert(vectors, ids, payloads);
+
+    const query = [1, 0, 0.5, 1];
+    const expected = await inline.search(query, 5, { user_id: "u1" });
+    const actual = await pooled.search(query, 5, { user_id: "u1" });
+    expect(actual.map((r) => r.id)).toEqual(expected.map((r) => r.id));
+    actual.forEach((r, i) =>
+      expect(r.score).toBeCloseTo(expected[i].score!, 5),
+    );
+  });
+});
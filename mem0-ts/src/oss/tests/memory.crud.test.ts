@@ -438,3 +438,141 @@ describe("Memory - history()", () => {
     expect(history).toHaveLength(0);
   });
 });
+
+// ─── add(infer: false) batching ──────────────────────────
+
+describe("Memory - add() with infer: false", () => {
+  let memory: Memory;
+  const userId = `verbatim_test_${Date.now()}`;
+
+  beforeAll(async () => {
+    memory = createMemory();
+  });
+
+  afterAll(async () => {
+    await memory.reset();
+  });
+
+  test("stores each non-system message with one embedBatch call", async () => {
+    await (memory as any)._ensureInitialized();
+    const embedder = (memory as any).embedder;
+    embedder.embedBatch.mockClear();
+    embedder.embed.mockClear();
+
+    const result: SearchResult = await memory.add(
+      [
+        { role: "system", content: "You are helpful" },
+        { role: "user", content: "I live in Lisbon" },
+        { role: "assistant", content: "Noted" },
+        { role: "user", content: "I play the cello" },
+      ],
+      { userId, infer: false },
+    );
+
+    expect(result.results.map((r) => r.memory)).toEqual([
+      "I live in Lisbon",
+      "Noted",
+      "I play the cello",
+    ]);
+    expect(embedder.embedBatch).toHaveBeenCalledTimes(1);
+    expect(embedder.embed).not.toHaveBeenCalled();
+
+    for (const item of result.results) {
+      const stored = await memory.get(item.id);
+      expect(stored!.memory).toBe(item.memory);
+      const history = await memory.history(item.id);
+      expect(history).toHaveLength(1);
+    }
+  });
+});
+
+// ─── entity-store cleanup ────────────────────────────────
+
+describe("Memory - entity store cleanup", () => {
+  let memory: Memory;
+
+  async function entityRows(): Promise<
+    Array<{ id: string; payload: Record<string, any> }>
+  > {
+    const store = await (memory as any).getEntityStore();
+    const [rows] = await store.list(undefined, 1000);
+    return rows;
+  }
+
+  function linking(
+    rows: Array<{ payload: Record<string, any> }>,
+    memoryId: string,
+  ) {
+    return rows.filter((r) => r.payload.linkedMemoryIds?.includes(memoryId));
+  }
+
+  beforeEach(async () => {
+    memory = createMemory();
+  });
+
+  afterEach(async () => {
+    await memory.reset();
+  });
+
+  test("delete() unlinks only affected entities without re-embedding", async () => {
+    const userId = `entity_cleanup_${Date.now()}`;
+    const first = await memory.add("User compared Cartesia and Deepgram", {
+      userId,
+    });
+    const second = await memory.add("User picked Deepgram for Mem0", {
+      userId,
+    });
+    const firstId = first.results[0].id;
+    const secondId = second.results[0].id;
+    expect(linking(await entityRows(), firstId).length).toBeGreaterThan(0);
+
+    const embedder = (memory as any).embedder;
+    embedder.embed.mockClear();
+    await memory.delete(firstId);
+
+    const rows = await entityRows();
+    expect(linking(rows, firstId)).toHaveLength(0);
+    expect(linking(rows, secondId).length).toBeGreaterThan(0);
+    expect(embedder.embed).not.toHaveBeenCalled();
+
+    await memory.delete(secondId);
+    expect(await entityRows()).toHaveLength(0);
+  });
+
+  test("deleteAll() clears the scope's entities and keeps other scopes", async () => {
+    const userId = `entity_scope_${Date.now()}`;
+    const otherUserId = `${userId}_other`;
+    await memory.add("User compared Cartesia and Deepgram", { userId });
+    await memory.add("User picked Deepgram for Mem0", { userId });
+    const kept = await memory.add("User compared Cartesia and Deepgram", {
+      userId: otherUserId,
+    });
+
+    await memory.deleteAll({ userId });
+
+    const rows = await entityRows();
+    expect(rows.filter((r) => r.payload.user_id === userId)).toHaveLength(0);
+    expect(linking(rows, kept.results[0].id).length).toBeGreaterThan(0);
+  });
+
+  test("deleteAll() keeps entities still linked from a broader scope", async () => {
+    const userId = `entity_shared_${Date.now()}`;
+    const runId = "run-1";
+    const scoped = await memory.add("User compared Cartesia and Deepgram", {
+      userId,
+      runId,
+    });
+    // The user-only add reuses the run-scoped entity rows for Deepgram.
+    const broad = await memory.add("User picked Deepgram for Mem0", {
+      userId,
+    });
+    const broadId = broad.results[0].id;
+    expect(linking(await entityRows(), broadId).length).toBeGreaterThan(0);
+
+    await memory.deleteAll({ userId, runId });
+
+    const rows = await entityRows();
+    expect(linking(rows, scoped.results[0].id)).toHaveLength(0);
+    expect(linking(rows, broadId).length).toBeGreaterThan(0);
+  });
+});
@@ -0,0 +1,183 @@
+/**
+ * Search single-flight tests — identical concurrent searches share one
+ * execution, cached results are scoped, and writes invalidate them.
+ */
+/// <reference types="jest" />
+import { Memory } from "../src/memory";
+import { SearchCoalescer, makeSearchKey } from "../src/utils/search_cache";
+
+jest.setTimeout(30000);
+
+jest.mock("../src/embeddings/google", () => ({
+  GoogleEmbedder: jest.fn(),
+}));
+jest.mock("../src/llms/google", () => ({
+  GoogleLLM: jest.fn(),
+}));
+jest.mock("../src/llms/openai", () => ({
+  OpenAILLM: jest.fn().mockImplementation(() => ({
+    generateResponse: jest.fn().mockResolvedValue(
+      JSON.stringify({
+        memory: [{ id: "0", text: "fact", attributed_to: "user" }],
+      }),
+    ),
+  })),
+}));
+
+const mockEmbedding = new Array(1536).fill(0.1);
+jest.mock("../src/embeddings/openai", () => ({
+  OpenAIEmbedder: jest.fn().mockImplementation(() => ({
+    embed: jest.fn().mockResolvedValue(mockEmbedding),
+    embedBatch: jest
+      .fn()
+      .mockImplementation((texts: string[]) =>
+        Promise.resolve(texts.map(() => mockEmbedding)),
+      ),
+    embeddingDims: 1536,
+  })),
+}));
+
+describe("SearchCoalescer", () => {
+  test("concurrent identical calls share one execution", async () => {
+    const coalescer = new SearchCoalescer<string[]>(0);
+    const fn = jest.fn(
+      () => new Promise<string[]>((r) => setTimeout(() => r(["m1"]), 10)),
+    );
+
+    const results = await Promise.all(
+      Array.from({ length: 4 }, () =>
+        coalescer.run("k", { user_id: "u1" }, fn),
+      ),
+    );
+    expect(fn).toHaveBeenCalledTimes(1);
+    expect(results).toEqual([["m1"], ["m1"], ["m1"], ["m1"]]);
+    expect(results[0]).not.toBe(results[1]);
+    expect(coalescer.stats().dedupRate).toBeCloseTo(0.75);
+  });
+
+  test("writes drop overlapping scopes only", async () => {
+    const coalescer = new SearchCoalescer<string[]>(60_000);
+    const fn = jest.fn(async () => ["r"]);
+
+    await coalescer.run("user", { user_id: "u1" }, fn);
+    await coalescer.run("agent", { user_id: "u1", agent_id: "x" }, fn);
+    coalescer.invalidate({ user_id: "u1", agent_id: "y" });
+
+    await coalescer.run("agent", { user_id: "u1", agent_id: "x" }, fn);
+    expect(fn).toHaveBeenCalledTimes(2);
+    await coalescer.run("user", { user_id: "u1" }, fn);
+    expect(fn).toHaveBeenCalledTimes(3);
+  });
+
+  test("operator scopes are dropped by any write they could match", async () => {
+    const coalescer = new SearchCoalescer<string[]>(60_000);
+    const fn = jest.fn(async () => ["r"]);
+
+    await coalescer.run("in", { user_id: { in: ["a", "b"] } }, fn);
+    coalescer.invalidate({ user_id: "a" });
+    await coalescer.run("in", { user_id: { in: ["a", "b"] } }, fn);
+    expect(fn).toHaveBeenCalledTimes(2);
+  });
+
+  test("wildcard scopes are dropped by any write they could match", async () => {
+    const coalescer = new SearchCoalescer<string[]>(60_000);
+    const fn = jest.fn(async () => ["r"]);
+
+    await coalescer.run("any", { user_id: "u1", agent_id: "*" }, fn);
+    coalescer.invalidate({ user_id: "u1", agent_id: "x" });
+    await coalescer.run("any", { user_id: "u1", agent_id: "*" }, fn);
+    expect(fn).toHaveBeenCalledTimes(2);
+  });
+
+  test("results of a flight overlapping a write are not cached", async () => {
+    const coalescer = new SearchCoalescer<string[]>(60_000);
+    await coalescer.run("k", { user_id: "u1" }, async () => {
+      coalescer.invalidate({ user_id: "u1" });
+      return ["stale"];
+    });
+    expect(coalescer.stats().cachedEntries).toBe(0);
+  });
+
+  test("keys ignore filter key order", () => {
+    expect(makeSearchKey("q", { a: 1, b: { y: 2, x: 1 } }, 5)).toBe(
+      makeSearchKey("q", { b: { x: 1, y: 2 }, a: 1 }, 5),
+    );
+  });
+});
+
+describe("Memory.search with searchCache", () => {
+  let memory: Memory;
+
+  beforeEach(() => {
+    memory = new Memory({
+      version: "v1.1",
+      embedder: {
+        provider: "openai",
+        config: { apiKey: "test-key", model: "text-embedding-3-small" },
+      },
+      vectorStore: {
+        provider: "memory",
+        config: {
+          collectionName: `test-search-cache-${Date.now()}-${Math.random()}`,
+          dimension: 1536,
+          dbPath: ":memory:",
+        },
+      },
+      llm: {
+        provider: "openai",
+        config: { apiKey: "test-key", model: "gpt-5-mini" },
+      },
+      historyDbPath: ":memory:",
+      searchCache: { enabled: true, ttlMs: 60_000 },
+    });
+  });
+
+  afterEach(async () => {
+    await memory.reset();
+  });
+
+  test("repeated searches reuse results until the scope is written", async () => {
+    const userId = "cache_user";
+    await memory.add("I drink espresso", { userId, infer: false });
+    await (memory as any)._ensureInitialized();
+    const search = jest.spyOn((memory as any).vectorStore, "search");
+
+    const [a, b] = await Promise.all([
+      memory.search("espresso", { filters: { user_id: userId } }),
+      memory.search("espresso", { filters: { user_id: userId } }),
+    ]);
+    await memory.search("espresso", { filters: { user_id: userId } });
+    expect(search).toHaveBeenCalledTimes(1);
+    expect(b.results).toEqual(a.results);
+
+    await memory.add("I also like tea", { userId, infer: false });
+    const after = await memory.search("espresso", {
+      filters: { user_id: userId },
+    });
+    expect(search).toHaveBeenCalledTimes(2);
+    expect(after.results).toHaveLength(2);
+    expect(memory.searchCacheStats()!.dedupRate).toBeCloseTo(0.5);
+  });
+
+  test("wildcard searches see writes to a concrete id", async () => {
+    const userId = "cache_user";
+    const filters = { user_id: userId, agent_id: "*" };
+    await memory.add("I drink espresso", {
+      userId,
+      agentId: "a1",
+      infer: false,
+    });
+    await (memory as any)._ensureInitialized();
+    const search = jest.spyOn((memory as any).vectorStore, "search");
+
+    await memory.search("espresso", { filters });
+    await memory.add("I also like tea", {
+      userId,
+      agentId: "x",
+      infer: false,
+    });
+    const after = await memory.search("espresso", { filters });
+    expect(search).toHaveBeenCalledTimes(2);
+    expect(after.results).toHaveLength(2);
+  });
+});
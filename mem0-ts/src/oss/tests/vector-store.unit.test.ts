@@ -3,6 +3,10 @@
  * Uses real SQLite in-memory DB, no external dependencies.
  */
 /// <reference types="jest" />
+import Database from "better-sqlite3";
+import fs from "fs";
+import os from "os";
+import path from "path";
 import { MemoryVectorStore } from "../src/vector_stores/memory";
 import type { VectorStoreResult } from "../src/types";
 
@@ -182,6 +186,239 @@ describe("MemoryVectorStore - list", () => {
   });
 });
 
+describe("MemoryVectorStore - indexed filter columns", () => {
+  let store: MemoryVectorStore;
+
+  beforeAll(async () => {
+    store = createStore();
+    await store.insert(
+      [vec([1, 0, 0, 0]), vec([0, 1, 0, 0]), vec([0, 0, 1, 0])],
+      ["f1", "f2", "f3"],
+      [
+        { data: "a", userId: "u1", agentId: "bot", createdAt: "2026-01-01" },
+        { data: "b", user_id: "u1", createdAt: "2026-02-01", topic: "x" },
+        { data: "c", user_id: "u2", createdAt: "2026-03-01", topic: "x" },
+      ],
+    );
+  });
+
+  test("matches camelCase and snake_case payload keys", async () => {
+    const [results, count] = await store.list({ user_id: "u1" });
+    expect(count).toBe(2);
+    expect(results.map((r) => r.id).sort()).toEqual(["f1", "f2"]);
+  });
+
+  test("ne and nin keep rows where the field is missing", async () => {
+    const [ne] = await store.list({ agent_id: { ne: "bot" } });
+    expect(ne.map((r) => r.id).sort()).toEqual(["f2", "f3"]);
+    const [nin] = await store.list({ agent_id: { nin: ["bot"] } });
+    expect(nin.map((r) => r.id).sort()).toEqual(["f2", "f3"]);
+  });
+
+  test("range filters on created_at", async () => {
+    const [results] = await store.list({ created_at: { gte: "2026-02-01" } });
+    expect(results.map((r) => r.id).sort()).toEqual(["f2", "f3"]);
+  });
+
+  test("combines indexed and payload-only filters", async () => {
+    const [results, count] = await store.list({ user_id: "u1", topic: "x" });
+    expect(count).toBe(1);
+    expect(results[0].id).toBe("f2");
+
+    const hits = await store.search(vec([0, 1, 0, 0]), 10, {
+      user_id: "u1",
+      OR: [{ topic: "x" }, { topic: "y" }],
+    });
+    expect(hits.map((r) => r.id)).toEqual(["f2"]);
+  });
+
+  test("count reflects all matches when limited", async () => {
+    const [results, count] = await store.list({ user_id: "u1" }, 1);
+    expect(results).toHaveLength(1);
+    expect(count).toBe(2);
+  });
+
+  test("migrates databases created before the columns existed", async () => {
+    const dbPath = path.join(
+      fs.mkdtempSync(path.join(os.tmpdir(), "mem0-cols-")),
+      "vector_store.db",
+    );
+    const legacy = new Database(dbPath);
+    legacy.exec(
+      `CREATE TABLE vectors (id TEXT PRIMARY KEY, vector BLOB NOT NULL, payload TEXT NOT NULL)`,
+    );
+    legacy
+      .prepare(`INSERT INTO vectors (id, vector, payload) VALUES (?, ?, ?)`)
+      .run(
+        "old",
+        Buffer.from(new Float32Array([1, 0, 0, 0]).buffer),
+        JSON.stringify({ data: "legacy", userId: "u9", hash: "h1" }),
+      );
+    legacy.close();
+
+    const migrated = new MemoryVectorStore({
+      collectionName: "test",
+      dimension: DIM,
+      dbPath,
+    });
+    const [results] = await migrated.list({ user_id: "u9", hash: "h1" });
+    expect(results.map((r) => r.id)).toEqual(["old"]);
+
+    const inspect = new Database(dbPath, { readonly: true });
+    const indexes = (
+      inspect.prepare(`PRAGMA index_list(vectors)`).all() as any[]
+    ).map((i) => i.name);
+    inspect.close();
+    expect(indexes).toEqual(
+      expect.arrayContaining([
+        "idx_vectors_user_id",
+        "idx_vectors_agent_id",
+        "idx_vectors_run_id",
+        "idx_vectors_created_at",
+        "idx_vectors_hash",
+      ]),
+    );
+  });
+});
+
+describe("MemoryVectorStore - keywordSearch", () => {
+  let store: MemoryVectorStore;
+
+  beforeEach(async () => {
+    store = createStore();
+    await store.insert(
+      [vec([1, 0, 0, 0]), vec([0, 1, 0, 0]), vec([0, 0, 1, 0])],
+      ["k1", "k2", "k3"],
+      [
+        { data: "x", textLemmatized: "hike mountain trail", userId: "u1" },
+        { data: "x", textLemmatized: "cook pasta dinner", userId: "u1" },
+        { data: "x", textLemmatized: "mountain bike mountain", userId: "u2" },
+      ],
+    );
+  });
+
+  test("ranks matching documents with positive BM25 scores", async () => {
+    const results = (await store.keywordSearch("mountain", 10))!;
+    expect(results.map((r) => r.id).sort()).toEqual(["k1", "k3"]);
+    expect(results[0].id).toBe("k3"); // higher term frequency
+    expect(results.every((r) => r.score! > 0)).toBe(true);
+  });
+
+  test("applies filters and topK", async () => {
+    const filtered = (await store.keywordSearch("mountain", 10, {
+      user_id: "u1",
+    }))!;
+    expect(filtered.map((r) => r.id)).toEqual(["k1"]);
+
+    const limited = (await store.keywordSearch("mountain pasta", 1))!;
+    expect(limited).toHaveLength(1);
+  });
+
+  test("treats FTS5 syntax in the query as plain text", async () => {
+    const results = await store.keywordSearch('mountain" OR NEAR( *', 10);
+    expect(results).not.toBeNull();
+  });
+
+  test("stays in sync with update, upsert and delete", async () => {
+    await store.update("k2", vec([0, 1, 0, 0]), {
+      data: "x",
+      textLemmatized: "mountain lake",
+    });
+    await store.insert(
+      [vec([0, 0, 1, 0])],
+      ["k3"],
+      [{ data: "x", textLemmatized: "ocean" }],
+    );
+    await store.delete("k1");
+
+    const mountain = (await store.keywordSearch("mountain", 10))!;
+    expect(mountain.map((r) => r.id)).toEqual(["k2"]);
+    const ocean = (await store.keywordSearch("ocean", 10))!;
+    expect(ocean.map((r) => r.id)).toEqual(["k3"]);
+  });
+
+  test("backfills the index for databases created before it existed", async () => {
+    const dbPath = path.join(
+      fs.mkdtempSync(path.join(os.tmpdir(), "mem0-fts-")),
+      "vector_store.db",
+    );
+    const legacy = new Database(dbPath);
+    legacy.exec(
+      `CREATE TABLE vectors (id TEXT PRIMARY KEY, vector BLOB NOT NULL, payload TEXT NOT NULL)`,
+    );
+    legacy
+      .prepare(`INSERT INTO vectors (id, vector, payload) VALUES (?, ?, ?)`)
+      .run(
+        "old",
+        Buffer.from(new Float32Array([1, 0, 0, 0]).buffer),
+        JSON.stringify({ data: "legacy memory about sailing" }),
+      );
+    legacy.close();
+
+    const migrated = new MemoryVectorStore({
+      collectionName: "test",
+      dimension: DIM,
+      dbPath,
+    });
+    const results = (await migrated.keywordSearch("sailing", 10))!;
+    expect(results.map((r) => r.id)).toEqual(["old"]);
+  });
+
+  test("keeps pointing at the right rows after VACUUM", async () => {
+    const dbPath = path.join(
+      fs.mkdtempSync(path.join(os.tmpdir(), "mem0-fts-")),
+      "vector_store.db",
+    );
+    const vacuumed = new MemoryVectorStore({
+      collectionName: "test",
+      dimension: DIM,
+      dbPath,
+    });
+    const words = ["alpha", "bravo", "charlie", "delta"];
+    await vacuumed.insert(
+      words.map(() => vec([1, 0, 0, 0])),
+      words,
+      words.map((w) => ({ data: w, textLemmatized: w })),
+    );
+    await vacuumed.delete("alpha");
+    await vacuumed.delete("charlie");
+    (vacuumed as any).db.exec("VACUUM");
+
+    for (const word of ["bravo", "delta"]) {
+      const results = (await vacuumed.keywordSearch(word, 10))!;
+      expect(results.map((r) => r.id)).toEqual([word]);
+    }
+  });
+});
+
+describe("MemoryVectorStore - linked memory index", () => {
+  test("finds entity rows by linked memory and follows payload changes", async () => {
+    const store = createStore();
+    await store.insert(
+      [vec([1, 0, 0, 0]), vec([0, 1, 0, 0]), vec([0, 0, 1, 0])],
+      ["e1", "e2", "m1"],
+      [
+        { data: "Deepgram", linkedMemoryIds: ["mem1", "mem2"] },
+        { data: "Cartesia", linkedMemoryIds: ["mem1"] },
+        { data: "a memory without links" },
+      ],
+    );
+
+    const ids = async (memoryId: string) =>
+      (await store.listByLinkedMemory(memoryId)).map((r) => r.id).sort();
+    expect(await ids("mem1")).toEqual(["e1", "e2"]);
+    expect(await ids("mem2")).toEqual(["e1"]);
+
+    await store.updatePayload("e1", {
+      data: "Deepgram",
+      linkedMemoryIds: ["mem2"],
+    });
+    await store.delete("e2");
+    expect(await ids("mem1")).toEqual([]);
+    expect(await ids("mem2")).toEqual(["e1"]);
+  });
+});
+
 describe("MemoryVectorStore - userId tracking", () => {
   test("getUserId generates and persists a random ID", async () => {
     const store = createStore();
@@ -43,7 +43,18 @@ export default defineConfig([
     format: ["cjs", "esm"],
     dts: true,
     sourcemap: true,
+    // __dirname is used to locate cpu_worker.js from the ESM build too.
+    shims: true,
     external,
     define,
   },
+  {
+    // Loaded by CpuWorkerPool via `new Worker(path)`, so it must be a
+    // standalone CommonJS file next to the oss bundle.
+    entry: ["src/oss/src/utils/cpu_worker.ts"],
+    outDir: "dist/oss",
+    format: ["cjs"],
+    sourcemap: true,
+    external,
+  },
 ]);
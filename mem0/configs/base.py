@@ -26,6 +26,23 @@ class MemoryItem(BaseModel):
     updated_at: Optional[str] = Field(None, description="The timestamp when the memory was updated")
 
 
+class SearchCacheConfig(BaseModel):
+    enabled: bool = Field(
+        description="Merge identical concurrent search() calls onto one execution",
+        default=False,
+    )
+    ttl_seconds: float = Field(
+        description="How long completed results are reused; 0 only coalesces in-flight calls",
+        default=2.0,
+        ge=0,
+    )
+    max_entries: int = Field(
+        description="Maximum number of cached search results",
+        default=1024,
+        gt=0,
+    )
+
+
 class MemoryConfig(BaseModel):
     vector_store: VectorStoreConfig = Field(
         description="Configuration for the vector store",
@@ -55,6 +72,14 @@ class MemoryConfig(BaseModel):
         description="Custom instructions for fact extraction",
         default=None,
     )
+    search_cache: SearchCacheConfig = Field(
+        description="Single-flight and short-lived result cache for search()",
+        default_factory=SearchCacheConfig,
+    )
+    notices: bool = Field(
+        description="Evaluate OSS notices on add/search/delete; False keeps notice bookkeeping off every call",
+        default=True,
+    )
 
 
 class AzureConfig(BaseModel):
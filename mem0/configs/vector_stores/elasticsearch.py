@@ -21,6 +21,12 @@ class ElasticsearchConfig(BaseModel):
         None, description="Custom search query function. Parameters: (query, top_k, filters) -> Dict"
     )
     headers: Optional[Dict[str, str]] = Field(None, description="Custom headers to include in requests")
+    num_candidates: Optional[int] = Field(
+        None,
+        gt=0,
+        description="Candidates considered per shard in KNN search. Defaults to 4x the requested results, "
+        "at least 100.",
+    )
 
     @model_validator(mode="before")
     @classmethod
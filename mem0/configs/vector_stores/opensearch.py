@@ -24,6 +24,12 @@ class OpenSearchConfig(BaseModel):
         "immediately searchable. Disabled by default for OpenSearch Serverless compatibility. "
         "OpenSearch automatically refreshes indices every ~1 second, so most users don't need this.",
     )
+    ef_search: Optional[int] = Field(
+        None,
+        gt=0,
+        description="HNSW ef_search for k-NN queries (OpenSearch 2.16+). Larger values trade latency for recall; "
+        "unset uses the index setting.",
+    )
 
     @model_validator(mode="before")
     @classmethod
@@ -8,6 +8,7 @@ import os
 import time
 import uuid
 import warnings
+from contextlib import asynccontextmanager, contextmanager
 from copy import deepcopy
 from datetime import date, datetime, timezone
 from typing import Any, Dict, Optional
@@ -25,9 +26,10 @@ from mem0.configs.prompts import (
 from mem0.exceptions import LLMError
 from mem0.exceptions import ValidationError as Mem0ValidationError
 from mem0.memory.base import MemoryBase
+from mem0.memory.search_cache import SearchCoalescer, make_search_key, scope_of
 from mem0.memory.setup import mem0_dir, setup_config
 from mem0.memory.storage import SQLiteManager
-from mem0.memory.telemetry import MEM0_TELEMETRY, capture_event
+from mem0.memory.telemetry import MEM0_TELEMETRY, TelemetryFilters, capture_event
 from mem0.memory.notices import (
     PERFORMANCE_SLOW_QUERY_THRESHOLD_SECONDS,
     detect_scale_threshold_from_add_result,
@@ -50,12 +52,12 @@ from mem0.memory.notices import (
     get_decay_feature_error_message_async,
     get_temporal_feature_error_message,
     get_temporal_feature_error_message_async,
+    notices_enabled,
 )
 from mem0.memory.utils import (
     extract_json,
     parse_messages,
     parse_vision_messages,
-    process_telemetry_filters,
     remove_code_blocks,
 )
 from mem0.utils.entity_extraction import extract_entities, extract_entities_batch
@@ -374,6 +376,97 @@ def _build_session_scope(filters):
     return "&".join(parts)
 
 
+def _embed_raw_messages(embedding_model, messages) -> Dict[str, Any]:
+    """Embeddings of the stored contents of an ``infer=False`` add, keyed by content.
+
+    Several messages share one ``embed_batch`` call; a single message, or a
+    batch the provider rejects, is embedded one content at a time.
+    """
+    contents = []
+    for message_dict in messages:
+        if isinstance(message_dict, dict) and message_dict.get("role") not in (None, "system"):
+            content = message_dict.get("content")
+            if content is not None and content not in contents:
+                contents.append(content)
+    if len(contents) > 1:
+        try:
+            vectors = embedding_model.embed_batch(contents, "add")
+            if isinstance(vectors, list) and len(vectors) == len(contents):
+                return dict(zip(contents, vectors))
+        except Exception as e:
+            logger.warning(f"Batch embedding failed, embedding messages individually: {e}")
+    return {content: embedding_model.embed(content, "add") for content in contents}
+
+
+def _create_search_cache(config: MemoryConfig) -> Optional[SearchCoalescer]:
+    if not config.search_cache.enabled:
+        return None
+    return SearchCoalescer(
+        ttl_seconds=config.search_cache.ttl_seconds,
+        max_entries=config.search_cache.max_entries,
+    )
+
+
+def _bump_scope_version(memory, scope: Optional[Dict[str, Any]], floor: int) -> None:
+    db = getattr(memory, "db", None)
+    if db is not None:
+        scope = scope or {}
+        db.bump_scope_version(scope.get("user_id"), scope.get("agent_id"), scope.get("run_id"), floor=floor)
+
+
+def _invalidate_cached_searches(memory, scope: Optional[Dict[str, Any]]) -> None:
+    search_cache = getattr(memory, "search_cache", None)
+    if search_cache is not None:
+        search_cache.invalidate(scope or None)
+
+
+def _record_scope_write(memory, scope: Optional[Dict[str, Any]] = None, *, floor: int = 0) -> None:
+    """Bump the scope version for a write to ``scope`` and drop cached searches it could change.
+
+    ``scope=None`` marks a store-wide write (reset).
+    """
+    _bump_scope_version(memory, scope, floor)
+    _invalidate_cached_searches(memory, scope)
+
+
+async def _record_scope_write_async(memory, scope: Optional[Dict[str, Any]] = None, *, floor: int = 0) -> None:
+    """``_record_scope_write`` with the SQLite bump run in a worker thread."""
+    await asyncio.to_thread(_bump_scope_version, memory, scope, floor)
+    _invalidate_cached_searches(memory, scope)
+
+
+@contextmanager
+def _scope_write(memory, scope: Dict[str, Any]):
+    """Record a write to ``scope`` when the block exits, even if it failed part way.
+
+    If the block raised, a failure to record the write is logged instead of raised so it
+    never replaces the original error.
+    """
+    try:
+        yield
+    except BaseException:
+        try:
+            _record_scope_write(memory, scope)
+        except Exception as e:
+            logger.warning(f"Failed to record scope write after a failed add: {e}")
+        raise
+    _record_scope_write(memory, scope)
+
+
+@asynccontextmanager
+async def _scope_write_async(memory, scope: Dict[str, Any]):
+    """``_scope_write`` for AsyncMemory; the bump runs off the event loop."""
+    try:
+        yield
+    except BaseException:
+        try:
+            await _record_scope_write_async(memory, scope)
+        except Exception as e:
+            logger.warning(f"Failed to record scope write after a failed add: {e}")
+        raise
+    await _record_scope_write_async(memory, scope)
+
+
 def _entity_collection_name(provider: str, collection_name: str) -> str:
     separator = "-" if provider == "s3_vectors" else "_"
     return f"{collection_name}{separator}entities"
@@ -406,6 +499,17 @@ def _payload_is_expired(payload: Optional[Dict[str, Any]]) -> bool:
         return False
 
 
+def _semantic_and_keyword_search(vector_store, query, keyword_query, vectors, top_k, filters):
+    """Semantic and keyword results for a query, in one request where the store supports it."""
+    if getattr(type(vector_store), "hybrid_search", VectorStoreBase.hybrid_search) is not VectorStoreBase.hybrid_search:
+        return vector_store.hybrid_search(
+            query=query, keyword_query=keyword_query, vectors=vectors, top_k=top_k, filters=filters
+        )
+    semantic_results = vector_store.search(query=query, vectors=vectors, top_k=top_k, filters=filters)
+    keyword_results = vector_store.keyword_search(query=keyword_query, top_k=top_k, filters=filters)
+    return semantic_results, keyword_results
+
+
 setup_config()
 logger = logging.getLogger(__name__)
 
@@ -469,6 +573,7 @@ class Memory(MemoryBase):
 
         # Entity store is initialized lazily on first use
         self._entity_store = None
+        self.search_cache = _create_search_cache(self.config)
 
         if MEM0_TELEMETRY:
             # Create telemetry config manually to avoid deepcopy issues with thread locks
@@ -803,7 +908,8 @@ class Memory(MemoryBase):
             )
 
         if agent_id is not None and memory_type == MemoryType.PROCEDURAL.value:
-            results = self._create_procedural_memory(messages, metadata=processed_metadata, prompt=prompt)
+            with _scope_write(self, scope_of(effective_filters)):
+                results = self._create_procedural_memory(messages, metadata=processed_metadata, prompt=prompt)
             scale_threshold_notice = detect_scale_threshold_from_add_result(self, results)
             if temporal_usage_notice:
                 display_temporal_usage_notice(self, "sync", "add", *temporal_usage_notice)
@@ -818,7 +924,10 @@ class Memory(MemoryBase):
         else:
             messages = parse_vision_messages(messages)
 
-        vector_store_result = self._add_to_vector_store(messages, processed_metadata, effective_filters, infer, prompt=prompt)
+        with _scope_write(self, scope_of(effective_filters)):
+            vector_store_result = self._add_to_vector_store(
+                messages, processed_metadata, effective_filters, infer, prompt=prompt
+            )
         scale_threshold_notice = detect_scale_threshold_from_add_result(self, vector_store_result)
         if temporal_usage_notice:
             display_temporal_usage_notice(self, "sync", "add", *temporal_usage_notice)
@@ -831,6 +940,7 @@ class Memory(MemoryBase):
     def _add_to_vector_store(self, messages, metadata, filters, infer, prompt=None):
         if not infer:
             returned_memories = []
+            embeddings = _embed_raw_messages(self.embedding_model, messages)
             for message_dict in messages:
                 if (
                     not isinstance(message_dict, dict)
@@ -851,8 +961,7 @@ class Memory(MemoryBase):
                     per_msg_meta["actor_id"] = actor_name
 
                 msg_content = message_dict["content"]
-                msg_embeddings = self.embedding_model.embed(msg_content, "add")
-                mem_id = self._create_memory(msg_content, {msg_content: msg_embeddings}, per_msg_meta)
+                mem_id = self._create_memory(msg_content, embeddings, per_msg_meta)
 
                 returned_memories.append(
                     {
@@ -1149,11 +1258,10 @@ class Memory(MemoryBase):
             for r in records
         ]
 
-        keys, encoded_ids = process_telemetry_filters(filters)
         capture_event(
             "mem0.add",
             self,
-            {"version": self.api_version, "keys": keys, "encoded_ids": encoded_ids, "sync_type": "sync"},
+            {"version": self.api_version, "filters": TelemetryFilters(filters), "sync_type": "sync"},
         )
         return returned_memories
 
@@ -1262,9 +1370,8 @@ class Memory(MemoryBase):
         fetch_limit = limit if show_expired else max(limit * 4, 60)
         scale_threshold_notice = detect_scale_threshold_from_top_k(top_k)
 
-        keys, encoded_ids = process_telemetry_filters(effective_filters)
         capture_event(
-            "mem0.get_all", self, {"limit": limit, "keys": keys, "encoded_ids": encoded_ids, "sync_type": "sync"}
+            "mem0.get_all", self, {"limit": limit, "filters": TelemetryFilters(effective_filters), "sync_type": "sync"}
         )
 
         all_memories_result = self._get_all_from_vector_store(effective_filters, fetch_limit, show_expired, limit)
@@ -1426,15 +1533,13 @@ class Memory(MemoryBase):
                     effective_filters.pop(fk, None)
             effective_filters.update(processed_filters)
 
-        keys, encoded_ids = process_telemetry_filters(effective_filters)
         capture_event(
             "mem0.search",
             self,
             {
                 "limit": limit,
                 "version": self.api_version,
-                "keys": keys,
-                "encoded_ids": encoded_ids,
+                "filters": TelemetryFilters(effective_filters),
                 "sync_type": "sync",
                 "threshold": threshold,
                 "explain": explain,
@@ -1442,19 +1547,35 @@ class Memory(MemoryBase):
             },
         )
 
-        search_start = time.perf_counter()
-        original_memories = self._search_vector_store(
-            query, effective_filters, limit, threshold, explain=explain, show_expired=show_expired
-        )
-        search_elapsed_seconds = time.perf_counter() - search_start
+        # Only the caller that actually executes the search reports its
+        # latency; coalesced and cached callers leave it at zero.
+        search_elapsed_seconds = 0.0
 
-        # Apply reranking if enabled and reranker is available
-        if rerank and self.reranker and original_memories:
-            try:
-                reranked_memories = self.reranker.rerank(query, original_memories, limit)
-                original_memories = reranked_memories
-            except Exception as e:
-                logger.warning(f"Reranking failed, using original results: {e}")
+        def run_search():
+            nonlocal search_elapsed_seconds
+            search_start = time.perf_counter()
+            memories = self._search_vector_store(
+                query, effective_filters, limit, threshold, explain=explain, show_expired=show_expired
+            )
+            search_elapsed_seconds = time.perf_counter() - search_start
+
+            # Apply reranking if enabled and reranker is available
+            if rerank and self.reranker and memories:
+                try:
+                    memories = self.reranker.rerank(query, memories, limit)
+                except Exception as e:
+                    logger.warning(f"Reranking failed, using original results: {e}")
+            return memories
+
+        search_cache = getattr(self, "search_cache", None)
+        if search_cache is None:
+            original_memories = run_search()
+        else:
+            original_memories = search_cache.run(
+                make_search_key(query, effective_filters, limit, threshold, rerank, explain, show_expired),
+                scope_of(effective_filters),
+                run_search,
+            )
 
         if temporal_usage_notice:
             display_temporal_usage_notice(self, "sync", "search", *temporal_usage_notice)
@@ -1589,15 +1710,11 @@ class Memory(MemoryBase):
         # Step 2: Embed query
         embeddings = self.embedding_model.embed(query, "search")
 
-        # Step 3: Semantic search (over-fetch for scoring pool)
+        # Steps 3-4: Semantic search (over-fetch for scoring pool) and keyword
+        # search (if store supports it)
         internal_limit = max(limit * 4, 60)
-        semantic_results = self.vector_store.search(
-            query=query, vectors=embeddings, top_k=internal_limit, filters=filters
-        )
-
-        # Step 4: Keyword search (if store supports it)
-        keyword_results = self.vector_store.keyword_search(
-            query=query_lemmatized, top_k=internal_limit, filters=filters
+        semantic_results, keyword_results = _semantic_and_keyword_search(
+            self.vector_store, query, query_lemmatized, embeddings, internal_limit, filters
         )
 
         # Step 5: Compute BM25 scores from keyword results
@@ -1852,12 +1969,12 @@ class Memory(MemoryBase):
                 "At least one filter is required to delete all memories. If you want to delete all memories, use the `reset()` method."
             )
 
-        keys, encoded_ids = process_telemetry_filters(filters)
-        capture_event("mem0.delete_all", self, {"keys": keys, "encoded_ids": encoded_ids, "sync_type": "sync"})
+        capture_event("mem0.delete_all", self, {"filters": TelemetryFilters(filters), "sync_type": "sync"})
         # delete all vector memories and reset the collections
         memories = self.vector_store.list(filters=filters)[0]
         for memory in memories:
             self._delete_memory(memory.id)
+        _record_scope_write(self, filters)
 
         logger.info(f"Deleted {len(memories)} memories")
 
@@ -1883,6 +2000,33 @@ class Memory(MemoryBase):
         display_first_run_notice(self, "sync", "history")
         return history
 
+    def get_scope_version(
+        self,
+        *,
+        user_id: Optional[str] = None,
+        agent_id: Optional[str] = None,
+        run_id: Optional[str] = None,
+    ) -> int:
+        """
+        Get a monotonic version for the memories visible under the given ids.
+
+        The version changes whenever add, update, delete, delete_all or reset
+        writes to a matching scope, so callers can cache results (or derive
+        HTTP ETags) and revalidate with a single indexed SQLite read instead
+        of querying the vector store. Writes to a narrower scope count: a
+        version read for ``user_id`` alone changes when any of that user's
+        agent- or run-scoped memories change.
+
+        Args:
+            user_id (str, optional): User ID to scope by.
+            agent_id (str, optional): Agent ID to scope by.
+            run_id (str, optional): Run ID to scope by.
+
+        Returns:
+            int: The current version. Only comparable within one history DB.
+        """
+        return self.db.get_scope_version(user_id=user_id, agent_id=agent_id, run_id=run_id)
+
     def _create_memory(self, data, existing_embeddings, metadata=None):
         logger.debug(f"Creating memory with {data=}")
         if data in existing_embeddings:
@@ -2018,6 +2162,9 @@ class Memory(MemoryBase):
             self._remove_memory_from_entity_store(memory_id, session_filters)
             self._link_entities_for_memory(memory_id, data, session_filters)
 
+        _record_scope_write(self, scope_of(existing_memory.payload))
+        if session_filters != scope_of(existing_memory.payload):
+            _record_scope_write(self, session_filters)
         return memory_id
 
     def _delete_memory(self, memory_id, existing_memory=None):
@@ -2048,6 +2195,7 @@ class Memory(MemoryBase):
         # that linked to it. Non-fatal — the helper swallows errors.
         self._remove_memory_from_entity_store(memory_id, session_filters)
 
+        _record_scope_write(self, session_filters)
         return memory_id
 
     def reset(self):
@@ -2059,6 +2207,9 @@ class Memory(MemoryBase):
         """
         logger.warning("Resetting all memories")
 
+        # Carry the scope version across the reset so it never goes backwards,
+        # even when the history DB is in-memory and recreated below.
+        version = self.db.get_scope_version()
         self.db.reset()
         self.db.close()
         self.db = SQLiteManager(self.config.history_db_path)
@@ -2079,6 +2230,7 @@ class Memory(MemoryBase):
                 logger.warning(f"Failed to reset entity store: {e}")
             self._entity_store = None
 
+        _record_scope_write(self, floor=version + 1)
         capture_event("mem0.reset", self, {"sync_type": "sync"})
         display_first_run_notice(self, "sync", "reset")
 
@@ -2110,6 +2262,7 @@ class AsyncMemory(MemoryBase):
         self.api_version = self.config.version
         self.custom_instructions = self.config.custom_instructions
         self._entity_store = None
+        self.search_cache = _create_search_cache(self.config)
 
         # Initialize reranker if configured
         self.reranker = None
@@ -2420,10 +2573,13 @@ class AsyncMemory(MemoryBase):
             )
 
         if agent_id is not None and memory_type == MemoryType.PROCEDURAL.value:
-            results = await self._create_procedural_memory(
-                messages, metadata=processed_metadata, prompt=prompt, llm=llm
-            )
-            scale_threshold_notice = await asyncio.to_thread(detect_scale_threshold_from_add_result, self, results)
+            async with _scope_write_async(self, scope_of(effective_filters)):
+                results = await self._create_procedural_memory(
+                    messages, metadata=processed_metadata, prompt=prompt, llm=llm
+                )
+            scale_threshold_notice = None
+            if notices_enabled(self):
+                scale_threshold_notice = await asyncio.to_thread(detect_scale_threshold_from_add_result, self, results)
             if temporal_usage_notice:
                 await display_temporal_usage_notice_async(self, "async", "add", *temporal_usage_notice)
             elif scale_threshold_notice:
@@ -2437,8 +2593,13 @@ class AsyncMemory(MemoryBase):
         else:
             messages = parse_vision_messages(messages)
 
-        vector_store_result = await self._add_to_vector_store(messages, processed_metadata, effective_filters, infer, prompt=prompt)
-        scale_threshold_notice = await asyncio.to_thread(detect_scale_threshold_from_add_result, self, vector_store_result)
+        async with _scope_write_async(self, scope_of(effective_filters)):
+            vector_store_result = await self._add_to_vector_store(
+                messages, processed_metadata, effective_filters, infer, prompt=prompt
+            )
+        scale_threshold_notice = None
+        if notices_enabled(self):
+            scale_threshold_notice = await asyncio.to_thread(detect_scale_threshold_from_add_result, self, vector_store_result)
         if temporal_usage_notice:
             await display_temporal_usage_notice_async(self, "async", "add", *temporal_usage_notice)
         elif scale_threshold_notice:
@@ -2457,6 +2618,7 @@ class AsyncMemory(MemoryBase):
     ):
         if not infer:
             returned_memories = []
+            embeddings = await asyncio.to_thread(_embed_raw_messages, self.embedding_model, messages)
             for message_dict in messages:
                 if (
                     not isinstance(message_dict, dict)
@@ -2477,8 +2639,7 @@ class AsyncMemory(MemoryBase):
                     per_msg_meta["actor_id"] = actor_name
 
                 msg_content = message_dict["content"]
-                msg_embeddings = await asyncio.to_thread(self.embedding_model.embed, msg_content, "add")
-                mem_id = await self._create_memory(msg_content, {msg_content: msg_embeddings}, per_msg_meta)
+                mem_id = await self._create_memory(msg_content, embeddings, per_msg_meta)
 
                 returned_memories.append(
                     {
@@ -2772,11 +2933,10 @@ class AsyncMemory(MemoryBase):
             for r in records
         ]
 
-        keys, encoded_ids = process_telemetry_filters(effective_filters)
         capture_event(
             "mem0.add",
             self,
-            {"version": self.api_version, "keys": keys, "encoded_ids": encoded_ids, "sync_type": "async"},
+            {"version": self.api_version, "filters": TelemetryFilters(effective_filters), "sync_type": "async"},
         )
         return returned_memories
 
@@ -2885,9 +3045,8 @@ class AsyncMemory(MemoryBase):
         fetch_limit = limit if show_expired else max(limit * 4, 60)
         scale_threshold_notice = detect_scale_threshold_from_top_k(top_k)
 
-        keys, encoded_ids = process_telemetry_filters(effective_filters)
         capture_event(
-            "mem0.get_all", self, {"limit": limit, "keys": keys, "encoded_ids": encoded_ids, "sync_type": "async"}
+            "mem0.get_all", self, {"limit": limit, "filters": TelemetryFilters(effective_filters), "sync_type": "async"}
         )
 
         all_memories_result = await self._get_all_from_vector_store(effective_filters, fetch_limit, show_expired, limit)
@@ -3053,15 +3212,13 @@ class AsyncMemory(MemoryBase):
                     effective_filters.pop(fk, None)
             effective_filters.update(processed_filters)
 
-        keys, encoded_ids = process_telemetry_filters(effective_filters)
         capture_event(
             "mem0.search",
             self,
             {
                 "limit": limit,
                 "version": self.api_version,
-                "keys": keys,
-                "encoded_ids": encoded_ids,
+                "filters": TelemetryFilters(effective_filters),
                 "sync_type": "async",
                 "threshold": threshold,
                 "explain": explain,
@@ -3069,22 +3226,36 @@ class AsyncMemory(MemoryBase):
             },
         )
 
-        search_start = time.perf_counter()
-        original_memories = await self._search_vector_store(
-            query, effective_filters, limit, threshold, explain=explain, show_expired=show_expired
-        )
-        search_elapsed_seconds = time.perf_counter() - search_start
+        # Only the caller that actually executes the search reports its
+        # latency; coalesced and cached callers leave it at zero.
+        search_elapsed_seconds = 0.0
 
-        # Apply reranking if enabled and reranker is available
-        if rerank and self.reranker and original_memories:
-            try:
-                # Run reranking in thread pool to avoid blocking async loop
-                reranked_memories = await asyncio.to_thread(
-                    self.reranker.rerank, query, original_memories, limit
-                )
-                original_memories = reranked_memories
-            except Exception as e:
-                logger.warning(f"Reranking failed, using original results: {e}")
+        async def run_search():
+            nonlocal search_elapsed_seconds
+            search_start = time.perf_counter()
+            memories = await self._search_vector_store(
+                query, effective_filters, limit, threshold, explain=explain, show_expired=show_expired
+            )
+            search_elapsed_seconds = time.perf_counter() - search_start
+
+            # Apply reranking if enabled and reranker is available
+            if rerank and self.reranker and memories:
+                try:
+                    # Run reranking in thread pool to avoid blocking async loop
+                    memories = await asyncio.to_thread(self.reranker.rerank, query, memories, limit)
+                except Exception as e:
+                    logger.warning(f"Reranking failed, using original results: {e}")
+            return memories
+
+        search_cache = getattr(self, "search_cache", None)
+        if search_cache is None:
+            original_memories = await run_search()
+        else:
+            original_memories = await search_cache.run_async(
+                make_search_key(query, effective_filters, limit, threshold, rerank, explain, show_expired),
+                scope_of(effective_filters),
+                run_search,
+            )
 
         if temporal_usage_notice:
             await display_temporal_usage_notice_async(self, "async", "search", *temporal_usage_notice)
@@ -3218,15 +3389,16 @@ class AsyncMemory(MemoryBase):
         # Step 2: Embed query
         embeddings = await asyncio.to_thread(self.embedding_model.embed, query, "search")
 
-        # Step 3: Semantic search (over-fetch)
+        # Steps 3-4: Semantic search (over-fetch) and keyword search (if store supports it)
         internal_limit = max(limit * 4, 60)
-        semantic_results = await asyncio.to_thread(
-            self.vector_store.search, query=query, vectors=embeddings, top_k=internal_limit, filters=filters
-        )
-
-        # Step 4: Keyword search (if store supports it)
-        keyword_results = await asyncio.to_thread(
-            self.vector_store.keyword_search, query=query_lemmatized, top_k=internal_limit, filters=filters
+        semantic_results, keyword_results = await asyncio.to_thread(
+            _semantic_and_keyword_search,
+            self.vector_store,
+            query,
+            query_lemmatized,
+            embeddings,
+            internal_limit,
+            filters,
         )
 
         # Step 5: Compute BM25 scores
@@ -3473,8 +3645,7 @@ class AsyncMemory(MemoryBase):
                 "At least one filter is required to delete all memories. If you want to delete all memories, use the `reset()` method."
             )
 
-        keys, encoded_ids = process_telemetry_filters(filters)
-        capture_event("mem0.delete_all", self, {"keys": keys, "encoded_ids": encoded_ids, "sync_type": "async"})
+        capture_event("mem0.delete_all", self, {"filters": TelemetryFilters(filters), "sync_type": "async"})
         memories = await asyncio.to_thread(self.vector_store.list, filters=filters)
 
         delete_tasks = []
@@ -3485,6 +3656,7 @@ class AsyncMemory(MemoryBase):
 
         if self._entity_store is not None:
             await self._bulk_clear_entity_store(filters)
+        await _record_scope_write_async(self, filters)
 
         errors = [r for r in results if isinstance(r, BaseException)]
         if errors:
@@ -3516,6 +3688,22 @@ class AsyncMemory(MemoryBase):
         await display_first_run_notice_async(self, "async", "history")
         return history
 
+    async def get_scope_version(
+        self,
+        *,
+        user_id: Optional[str] = None,
+        agent_id: Optional[str] = None,
+        run_id: Optional[str] = None,
+    ) -> int:
+        """
+        Get a monotonic version for the memories visible under the given ids asynchronously.
+
+        See ``Memory.get_scope_version``.
+        """
+        return await asyncio.to_thread(
+            self.db.get_scope_version, user_id=user_id, agent_id=agent_id, run_id=run_id
+        )
+
     async def _create_memory(self, data, existing_embeddings, metadata=None):
         logger.debug(f"Creating memory with {data=}")
         if data in existing_embeddings:
@@ -3672,6 +3860,9 @@ class AsyncMemory(MemoryBase):
             await self._remove_memory_from_entity_store(memory_id, session_filters)
             await self._link_entities_for_memory(memory_id, data, session_filters)
 
+        await _record_scope_write_async(self, scope_of(existing_memory.payload))
+        if session_filters != scope_of(existing_memory.payload):
+            await _record_scope_write_async(self, session_filters)
         return memory_id
 
     async def _delete_memory(self, memory_id, existing_memory=None, skip_entity_cleanup=False):
@@ -3703,6 +3894,7 @@ class AsyncMemory(MemoryBase):
         if not skip_entity_cleanup:
             await self._remove_memory_from_entity_store(memory_id, session_filters)
 
+        await _record_scope_write_async(self, session_filters)
         return memory_id
 
     async def reset(self):
@@ -3720,6 +3912,7 @@ class AsyncMemory(MemoryBase):
         if hasattr(self.vector_store, "client") and hasattr(self.vector_store.client, "close"):
             await asyncio.to_thread(self.vector_store.client.close)
 
+        version = await asyncio.to_thread(self.db.get_scope_version)
         await asyncio.to_thread(self.db.reset)
         await asyncio.to_thread(self.db.close)
         self.db = SQLiteManager(self.config.history_db_path)
@@ -3735,6 +3928,7 @@ class AsyncMemory(MemoryBase):
                 logger.warning(f"Failed to reset entity store: {e}")
             self._entity_store = None
 
+        await _record_scope_write_async(self, floor=version + 1)
         capture_event("mem0.reset", self, {"sync_type": "async"})
         await display_first_run_notice_async(self, "async", "reset")
 
@@ -1,8 +1,12 @@
 import asyncio
+import atexit
 import json
 import re
 import sys
 import threading
+import time
+import weakref
+from copy import deepcopy
 from datetime import date, datetime, timedelta, timezone
 from typing import Any, Dict, Optional, Tuple
 
@@ -47,6 +51,10 @@ TEMPORAL_FEATURE_ERROR_MESSAGES = {
     "reference_date": "The reference_date parameter is not supported by the OSS Memory SDK.",
 }
 DECAY_FEATURE_ERROR_MESSAGE = "The decay parameter is not supported by the OSS Memory SDK."
+# Notice state is held in memory; ~/.mem0/config.json is read once per process
+# and written back at most once per debounce interval (and at exit).
+PERSIST_DEBOUNCE_SECONDS = 5.0
+PROVIDER_COUNT_TTL_SECONDS = 300.0
 
 _ISO_DATE_RE = re.compile(
     r"\b\d{4}-\d{2}-\d{2}(?:[T\s]\d{2}:\d{2}(?::\d{2})?(?:\.\d+)?(?:Z|[+-]\d{2}:?\d{2})?)?\b"
@@ -75,11 +83,73 @@ _feature_error_capacity_reached_in_process = set()
 _scale_memory_count_adds_since_check = 0
 _scale_memory_count_checked_in_process = False
 _scale_memory_count_threshold_evaluated_in_process = False
+_notice_config_cache: Optional[Dict[str, Any]] = None
+_persist_pending = False
+_persist_timer: Optional[threading.Timer] = None
+_persist_lock = threading.Lock()
+_atexit_registered = False
+# vector store -> (expires_at, count); keeps count()/col_info() off the add path.
+_provider_counts: "weakref.WeakKeyDictionary" = weakref.WeakKeyDictionary()
+
+
+def notices_enabled(memory_instance) -> bool:
+    """Whether notices run for ``memory_instance``: telemetry on and ``config.notices`` not False."""
+    if not telemetry_module.MEM0_TELEMETRY:
+        return False
+    return getattr(getattr(memory_instance, "config", None), "notices", True) is not False
+
+
+def flush_notice_state() -> None:
+    """Write pending notice state to ~/.mem0/config.json now."""
+    global _persist_pending
+    with _persist_lock:
+        with _state_lock:
+            if not _persist_pending or _notice_config_cache is None:
+                return
+            _persist_pending = False
+            state = deepcopy(_notice_config_cache.get(STATE_SECTION))
+        _write_notice_state(state)
+
+
+def _notice_config() -> Dict[str, Any]:
+    """In-memory config, loaded on first use. Call with ``_state_lock`` held."""
+    global _notice_config_cache
+    if _notice_config_cache is None:
+        _notice_config_cache = _load_config()
+    return _notice_config_cache
+
+
+def _persist_notice_state() -> None:
+    """Schedule a debounced write of the notice state. Call with ``_state_lock`` held."""
+    global _persist_pending, _persist_timer, _atexit_registered
+    _persist_pending = True
+    if PERSIST_DEBOUNCE_SECONDS <= 0:
+        _persist_pending = False
+        _write_notice_state(deepcopy(_notice_config_cache.get(STATE_SECTION)))
+        return
+
+    if not _atexit_registered:
+        atexit.register(flush_notice_state)
+        _atexit_registered = True
+    if _persist_timer is None or not _persist_timer.is_alive():
+        _persist_timer = threading.Timer(PERSIST_DEBOUNCE_SECONDS, flush_notice_state)
+        _persist_timer.daemon = True
+        _persist_timer.start()
+
+
+def _write_notice_state(state: Any) -> None:
+    # Re-read the file so sections written by other code (user_id, ...) are kept.
+    try:
+        config = _load_config()
+        config[STATE_SECTION] = state
+        _write_config(config)
+    except Exception:
+        return
 
 
 def display_first_run_notice(memory_instance, sync_type: str, trigger_function: str) -> None:
     """Best-effort first-run notice check. Never raises or writes unless displayed."""
-    if not telemetry_module.MEM0_TELEMETRY:
+    if not notices_enabled(memory_instance):
         return
 
     if not _claim_first_run_notice(trigger_function):
@@ -147,7 +217,7 @@ def display_first_run_notice(memory_instance, sync_type: str, trigger_function:
 
 
 async def display_first_run_notice_async(memory_instance, sync_type: str, trigger_function: str) -> None:
-    if not telemetry_module.MEM0_TELEMETRY or _first_run_claimed_in_process:
+    if not notices_enabled(memory_instance) or _first_run_claimed_in_process:
         return
     await asyncio.to_thread(display_first_run_notice, memory_instance, sync_type, trigger_function)
 
@@ -160,7 +230,7 @@ def display_temporal_usage_notice(
     trigger_reason: str,
 ) -> None:
     """Best-effort temporal usage notice. Never raises or writes unless displayed."""
-    if not telemetry_module.MEM0_TELEMETRY:
+    if not notices_enabled(memory_instance):
         return
 
     if _temporal_usage_at_capacity():
@@ -243,6 +313,8 @@ async def display_temporal_usage_notice_async(
     trigger_source: str,
     trigger_reason: str,
 ) -> None:
+    if not notices_enabled(memory_instance):
+        return
     await asyncio.to_thread(
         display_temporal_usage_notice,
         memory_instance,
@@ -294,7 +366,7 @@ def display_decay_usage_notice(
     deleted_count: Optional[int] = None,
 ) -> None:
     """Best-effort decay usage notice. Never raises or writes unless displayed."""
-    if not telemetry_module.MEM0_TELEMETRY:
+    if not notices_enabled(memory_instance):
         return
 
     if _decay_usage_at_capacity():
@@ -383,6 +455,8 @@ async def display_decay_usage_notice_async(
     delete_count: Optional[int] = None,
     deleted_count: Optional[int] = None,
 ) -> None:
+    if not notices_enabled(memory_instance):
+        return
     await asyncio.to_thread(
         display_decay_usage_notice,
         memory_instance,
@@ -411,7 +485,7 @@ def detect_scale_threshold_from_add_result(
     memory_instance,
     add_result: Any,
 ) -> Optional[Tuple[str, str, Optional[int], Optional[int], int]]:
-    if not telemetry_module.MEM0_TELEMETRY:
+    if not notices_enabled(memory_instance):
         return None
 
     added_count = _count_added_memories(add_result)
@@ -437,7 +511,7 @@ def detect_scale_threshold_from_add_result(
             _scale_memory_count_checked_in_process = True
             _scale_memory_count_adds_since_check = 0
 
-            config = _load_config()
+            config = _notice_config()
             scale_state = _get_notice_state(config, SCALE_THRESHOLD_STATE_KEY)
             if scale_state.get("memory_count_threshold_evaluated"):
                 _scale_memory_count_threshold_evaluated_in_process = True
@@ -472,7 +546,7 @@ def display_scale_threshold_notice(
     threshold: Optional[int] = None,
 ) -> None:
     """Best-effort scale notice. Never raises or writes unless displayed."""
-    if not telemetry_module.MEM0_TELEMETRY:
+    if not notices_enabled(memory_instance):
         return
 
     if _scale_threshold_at_capacity():
@@ -566,6 +640,8 @@ async def display_scale_threshold_notice_async(
     memory_count: Optional[int] = None,
     threshold: Optional[int] = None,
 ) -> None:
+    if not notices_enabled(memory_instance):
+        return
     await asyncio.to_thread(
         display_scale_threshold_notice,
         memory_instance,
@@ -588,7 +664,7 @@ def display_performance_slow_query_notice(
     result_count: int,
 ) -> None:
     """Best-effort slow-query notice. Never raises or writes unless displayed."""
-    if not telemetry_module.MEM0_TELEMETRY:
+    if not notices_enabled(memory_instance):
         return
 
     if _performance_slow_query_at_capacity():
@@ -675,6 +751,8 @@ async def display_performance_slow_query_notice_async(
     top_k: int,
     result_count: int,
 ) -> None:
+    if not notices_enabled(memory_instance):
+        return
     await asyncio.to_thread(
         display_performance_slow_query_notice,
         memory_instance,
@@ -857,7 +935,7 @@ def _claim_first_run_notice(trigger_function: str) -> bool:
         if _first_run_claimed_in_process:
             return False
 
-        config = _load_config()
+        config = _notice_config()
         state = config.get(STATE_SECTION)
         if isinstance(state, dict):
             first_run = state.get(STATE_KEY)
@@ -875,7 +953,7 @@ def _claim_first_run_notice(trigger_function: str) -> bool:
             "variant": None,
         }
         config[STATE_SECTION] = state
-        _write_config(config)
+        _persist_notice_state()
         _first_run_claimed_in_process = True
         return True
 
@@ -883,7 +961,7 @@ def _claim_first_run_notice(trigger_function: str) -> bool:
 def _update_first_run_variant(variant) -> None:
     try:
         with _state_lock:
-            config = _load_config()
+            config = _notice_config()
             state = config.get(STATE_SECTION)
             if not isinstance(state, dict):
                 state = {}
@@ -893,7 +971,7 @@ def _update_first_run_variant(variant) -> None:
             first_run["variant"] = variant
             state[STATE_KEY] = first_run
             config[STATE_SECTION] = state
-            _write_config(config)
+            _persist_notice_state()
     except Exception:
         return
 
@@ -904,7 +982,7 @@ def _feature_error_at_capacity(notice_id: str) -> bool:
 
     try:
         with _state_lock:
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_feature_error_entries(config, notice_id, datetime.now(timezone.utc))
             at_capacity = len(entries) >= FEATURE_ERROR_CAP
             if at_capacity:
@@ -925,7 +1003,7 @@ def _record_feature_error_opportunity(
     try:
         with _state_lock:
             now = datetime.now(timezone.utc)
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_feature_error_entries(config, notice_id, now)
             if len(entries) >= FEATURE_ERROR_CAP:
                 _feature_error_capacity_reached_in_process.add(notice_id)
@@ -950,7 +1028,7 @@ def _record_feature_error_opportunity(
             feature_state["events"] = entries
             state[notice_id] = feature_state
             config[STATE_SECTION] = state
-            _write_config(config)
+            _persist_notice_state()
             if len(entries) >= FEATURE_ERROR_CAP:
                 _feature_error_capacity_reached_in_process.add(notice_id)
             return True
@@ -989,7 +1067,7 @@ def _temporal_usage_at_capacity() -> bool:
 
     try:
         with _state_lock:
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_temporal_usage_entries(config, datetime.now(timezone.utc))
             at_capacity = len(entries) >= TEMPORAL_USAGE_CAP
             if at_capacity:
@@ -1011,7 +1089,7 @@ def _record_temporal_usage_opportunity(
     try:
         with _state_lock:
             now = datetime.now(timezone.utc)
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_temporal_usage_entries(config, now)
             if len(entries) >= TEMPORAL_USAGE_CAP:
                 _temporal_usage_capacity_reached_in_process = True
@@ -1037,7 +1115,7 @@ def _record_temporal_usage_opportunity(
             temporal_state["events"] = entries
             state[TEMPORAL_USAGE_STATE_KEY] = temporal_state
             config[STATE_SECTION] = state
-            _write_config(config)
+            _persist_notice_state()
             if len(entries) >= TEMPORAL_USAGE_CAP:
                 _temporal_usage_capacity_reached_in_process = True
             return True
@@ -1076,7 +1154,7 @@ def _decay_usage_at_capacity() -> bool:
 
     try:
         with _state_lock:
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_decay_usage_entries(config, datetime.now(timezone.utc))
             at_capacity = len(entries) >= DECAY_USAGE_CAP
             if at_capacity:
@@ -1100,7 +1178,7 @@ def _record_decay_usage_opportunity(
     try:
         with _state_lock:
             now = datetime.now(timezone.utc)
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_decay_usage_entries(config, now)
             if len(entries) >= DECAY_USAGE_CAP:
                 _decay_usage_capacity_reached_in_process = True
@@ -1129,7 +1207,7 @@ def _record_decay_usage_opportunity(
             decay_state["events"] = entries
             state[DECAY_USAGE_STATE_KEY] = decay_state
             config[STATE_SECTION] = state
-            _write_config(config)
+            _persist_notice_state()
             if len(entries) >= DECAY_USAGE_CAP:
                 _decay_usage_capacity_reached_in_process = True
             return True
@@ -1168,7 +1246,7 @@ def _scale_threshold_at_capacity() -> bool:
 
     try:
         with _state_lock:
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_scale_threshold_entries(config, datetime.now(timezone.utc))
             at_capacity = len(entries) >= SCALE_THRESHOLD_CAP
             if at_capacity:
@@ -1193,7 +1271,7 @@ def _record_scale_threshold_opportunity(
     try:
         with _state_lock:
             now = datetime.now(timezone.utc)
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_scale_threshold_entries(config, now)
             if len(entries) >= SCALE_THRESHOLD_CAP:
                 _scale_threshold_capacity_reached_in_process = True
@@ -1226,7 +1304,7 @@ def _record_scale_threshold_opportunity(
                 scale_state["memory_count_threshold_evaluated"] = True
             state[SCALE_THRESHOLD_STATE_KEY] = scale_state
             config[STATE_SECTION] = state
-            _write_config(config)
+            _persist_notice_state()
             if len(entries) >= SCALE_THRESHOLD_CAP:
                 _scale_threshold_capacity_reached_in_process = True
             return True
@@ -1238,7 +1316,7 @@ def _mark_scale_memory_count_threshold_evaluated() -> bool:
     global _scale_memory_count_threshold_evaluated_in_process
     try:
         with _state_lock:
-            config = _load_config()
+            config = _notice_config()
             state = config.get(STATE_SECTION)
             if not isinstance(state, dict):
                 state = {}
@@ -1252,7 +1330,7 @@ def _mark_scale_memory_count_threshold_evaluated() -> bool:
             scale_state["memory_count_threshold_evaluated"] = True
             state[SCALE_THRESHOLD_STATE_KEY] = scale_state
             config[STATE_SECTION] = state
-            _write_config(config)
+            _persist_notice_state()
             _scale_memory_count_threshold_evaluated_in_process = True
             return True
     except Exception:
@@ -1290,7 +1368,7 @@ def _performance_slow_query_at_capacity() -> bool:
 
     try:
         with _state_lock:
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_performance_slow_query_entries(config, datetime.now(timezone.utc))
             at_capacity = len(entries) >= PERFORMANCE_SLOW_QUERY_CAP
             if at_capacity:
@@ -1311,7 +1389,7 @@ def _record_performance_slow_query_opportunity(
     try:
         with _state_lock:
             now = datetime.now(timezone.utc)
-            config = _load_config()
+            config = _notice_config()
             entries = _recent_performance_slow_query_entries(config, now)
             if len(entries) >= PERFORMANCE_SLOW_QUERY_CAP:
                 _performance_slow_query_capacity_reached_in_process = True
@@ -1336,7 +1414,7 @@ def _record_performance_slow_query_opportunity(
             performance_state["events"] = entries
             state[PERFORMANCE_SLOW_QUERY_STATE_KEY] = performance_state
             config[STATE_SECTION] = state
-            _write_config(config)
+            _persist_notice_state()
             if len(entries) >= PERFORMANCE_SLOW_QUERY_CAP:
                 _performance_slow_query_capacity_reached_in_process = True
             return True
@@ -1406,6 +1484,23 @@ def _get_provider_memory_count(memory_instance) -> Optional[int]:
     if vector_store is None:
         return None
 
+    now = time.monotonic()
+    try:
+        cached = _provider_counts.get(vector_store)
+    except TypeError:
+        cached = None
+    if cached is not None and cached[0] > now:
+        return cached[1]
+
+    value = _query_provider_memory_count(vector_store)
+    try:
+        _provider_counts[vector_store] = (now + PROVIDER_COUNT_TTL_SECONDS, value)
+    except TypeError:
+        pass
+    return value
+
+
+def _query_provider_memory_count(vector_store) -> Optional[int]:
     try:
         count = getattr(vector_store, "count", None)
         if callable(count):
@@ -0,0 +1,199 @@
+"""Single-flight coalescing and a short-lived result cache for ``search``.
+
+Identical searches issued within a few milliseconds of each other (common
+when an agent fans out several tool calls) share one execution: the first
+caller runs the search, later callers with the same key wait for its result.
+Completed results can optionally be kept for a short TTL.
+
+Entries are tagged with the entity scope (user_id / agent_id / run_id) of the
+search and dropped whenever a write touches an overlapping scope, so a search
+issued after a write always sees it.
+"""
+
+import asyncio
+import json
+import threading
+import time
+from collections import OrderedDict
+from copy import deepcopy
+from typing import Any, Awaitable, Callable, Dict, Hashable, Optional, Tuple
+
+SCOPE_KEYS = ("user_id", "agent_id", "run_id")
+
+
+def scope_of(filters: Optional[Dict[str, Any]]) -> Dict[str, Any]:
+    """Entity scope of a filters dict or memory payload."""
+    filters = filters or {}
+    return {k: filters[k] for k in SCOPE_KEYS if filters.get(k)}
+
+
+def make_search_key(query: str, filters: Dict[str, Any], *params: Any) -> Tuple[Hashable, ...]:
+    """Cache key for a search: the query, canonical filters and result-shaping params."""
+    return (query, json.dumps(filters, sort_keys=True, default=str), *params)
+
+
+def _values_overlap(a: Any, b: Any) -> bool:
+    # The "*" wildcard and operator values such as {"in": [...]} or {"ne": ...}
+    # can match many ids, so they are treated as overlapping anything rather
+    # than interpreted.
+    if not isinstance(a, (str, int, float)) or not isinstance(b, (str, int, float)):
+        return True
+    return a == "*" or b == "*" or a == b
+
+
+def _scopes_overlap(a: Dict[str, Any], b: Dict[str, Any]) -> bool:
+    # A write to {user_id: u, agent_id: x} is visible to a search scoped to
+    # {user_id: u}, but not to one scoped to {user_id: u, agent_id: y}.
+    return all(_values_overlap(a[k], b[k]) for k in a.keys() & b.keys())
+
+
+class SearchCoalescer:
+    """Merge identical in-flight searches and cache their results briefly.
+
+    ``ttl_seconds=0`` coalesces concurrent calls without caching completed
+    results. Callers always get their own deep copy of the result.
+    """
+
+    def __init__(self, ttl_seconds: float = 2.0, max_entries: int = 1024):
+        self.ttl_seconds = ttl_seconds
+        self.max_entries = max_entries
+        self._lock = threading.Lock()
+        self._cache: "OrderedDict[Hashable, Tuple[float, Dict[str, Any], Any]]" = OrderedDict()
+        self._inflight: Dict[Hashable, "_Flight"] = {}
+        self._inflight_async: Dict[Hashable, Tuple[Dict[str, Any], asyncio.Future]] = {}
+        # Bumped by every invalidation; a flight only caches its result if no
+        # write happened while it was running.
+        self._generation = 0
+        self._requests = 0
+        self._cache_hits = 0
+        self._coalesced = 0
+
+    def run(self, key: Hashable, scope: Dict[str, Any], fn: Callable[[], Any]) -> Any:
+        with self._lock:
+            self._requests += 1
+            hit = self._lookup(key)
+            if hit is not None:
+                self._cache_hits += 1
+                return deepcopy(hit)
+            flight = self._inflight.get(key)
+            if flight is not None:
+                self._coalesced += 1
+                leader = False
+            else:
+                flight = _Flight(scope)
+                self._inflight[key] = flight
+                leader = True
+                generation = self._generation
+
+        if not leader:
+            flight.done.wait()
+            if flight.error is not None:
+                raise flight.error
+            return deepcopy(flight.result)
+
+        try:
+            result = fn()
+            flight.result = deepcopy(result)
+            return result
+        except BaseException as e:
+            flight.error = e
+            raise
+        finally:
+            with self._lock:
+                if self._inflight.get(key) is flight:
+                    del self._inflight[key]
+                if flight.error is None:
+                    self._store(key, scope, flight.result, generation)
+            flight.done.set()
+
+    async def run_async(self, key: Hashable, scope: Dict[str, Any], fn: Callable[[], Awaitable[Any]]) -> Any:
+        with self._lock:
+            self._requests += 1
+            hit = self._lookup(key)
+            if hit is not None:
+                self._cache_hits += 1
+                return deepcopy(hit)
+            entry = self._inflight_async.get(key)
+            if entry is not None:
+                self._coalesced += 1
+                task = entry[1]
+            else:
+                task = asyncio.ensure_future(self._execute_async(key, scope, fn, self._generation))
+                self._inflight_async[key] = (scope, task)
+
+        # Shield so one caller being cancelled does not cancel the search
+        # for everyone else waiting on it.
+        return deepcopy(await asyncio.shield(task))
+
+    async def _execute_async(self, key, scope, fn, generation):
+        task = asyncio.current_task()
+        try:
+            result = deepcopy(await fn())
+            with self._lock:
+                self._store(key, scope, result, generation)
+            return result
+        finally:
+            with self._lock:
+                entry = self._inflight_async.get(key)
+                if entry is not None and entry[1] is task:
+                    del self._inflight_async[key]
+
+    def invalidate(self, scope: Optional[Dict[str, Any]] = None) -> None:
+        """Drop cached and in-flight entries overlapping ``scope`` (all if None)."""
+        with self._lock:
+            self._generation += 1
+            if scope is None:
+                self._cache.clear()
+                self._inflight.clear()
+                self._inflight_async.clear()
+                return
+            for key in [k for k, (_, s, _) in self._cache.items() if _scopes_overlap(s, scope)]:
+                del self._cache[key]
+            # Detach overlapping flights so searches issued after this write
+            # start a fresh execution; existing waiters still get their result.
+            for key in [k for k, f in self._inflight.items() if _scopes_overlap(f.scope, scope)]:
+                del self._inflight[key]
+            for key in [k for k, (s, _) in self._inflight_async.items() if _scopes_overlap(s, scope)]:
+                del self._inflight_async[key]
+
+    def stats(self) -> Dict[str, Any]:
+        """Request counters; ``dedup_rate`` is the share of searches that did not execute."""
+        with self._lock:
+            deduped = self._cache_hits + self._coalesced
+            return {
+                "requests": self._requests,
+                "executions": self._requests - deduped,
+                "coalesced": self._coalesced,
+                "cache_hits": self._cache_hits,
+                "dedup_rate": deduped / self._requests if self._requests else 0.0,
+                "cached_entries": len(self._cache),
+            }
+
+    def _lookup(self, key):
+        entry = self._cache.get(key)
+        if entry is None:
+            return None
+        expires_at, _, result = entry
+        if expires_at < time.monotonic():
+            del self._cache[key]
+            return None
+        self._cache.move_to_end(key)
+        return result
+
+    def _store(self, key, scope, result, generation):
+        if self.ttl_seconds <= 0 or generation != self._generation:
+            return
+        self._cache[key] = (time.monotonic() + self.ttl_seconds, scope, result)
+        self._cache.move_to_end(key)
+        while len(self._cache) > self.max_entries:
+            self._cache.popitem(last=False)
+
+
+class _Flight:
+    __slots__ = ("scope", "done", "result", "error")
+
+    def __init__(self, scope: Dict[str, Any]):
+        self.scope = scope
+        self.done = threading.Event()
+        self.result: Any = None
+        self.error: Optional[BaseException] = None
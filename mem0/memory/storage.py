@@ -16,6 +16,7 @@ class SQLiteManager:
         self._migrate_history_table()
         self._create_history_table()
         self._create_messages_table()
+        self._create_scope_versions_table()
 
     def _migrate_history_table(self) -> None:
         """
@@ -147,6 +148,96 @@ class SQLiteManager:
                 logger.error(f"Failed to create messages table: {e}")
                 raise
 
+    def _create_scope_versions_table(self) -> None:
+        # One row per exact (user_id, agent_id, run_id) scope, with "" for
+        # unset ids. The all-empty row is the store-wide epoch bumped by reset.
+        with self._lock:
+            try:
+                self.connection.execute("BEGIN")
+                self.connection.execute(
+                    """
+                    CREATE TABLE IF NOT EXISTS scope_versions (
+                        user_id  TEXT NOT NULL DEFAULT '',
+                        agent_id TEXT NOT NULL DEFAULT '',
+                        run_id   TEXT NOT NULL DEFAULT '',
+                        version  INTEGER NOT NULL DEFAULT 0,
+                        PRIMARY KEY (user_id, agent_id, run_id)
+                    )
+                """
+                )
+                self.connection.execute(
+                    "CREATE INDEX IF NOT EXISTS idx_scope_versions_agent ON scope_versions (agent_id, run_id)"
+                )
+                self.connection.execute("CREATE INDEX IF NOT EXISTS idx_scope_versions_run ON scope_versions (run_id)")
+                self.connection.execute("COMMIT")
+            except Exception as e:
+                self.connection.execute("ROLLBACK")
+                logger.error(f"Failed to create scope_versions table: {e}")
+                raise
+
+    def bump_scope_version(
+        self,
+        user_id: Optional[str] = None,
+        agent_id: Optional[str] = None,
+        run_id: Optional[str] = None,
+        *,
+        floor: int = 0,
+    ) -> None:
+        """Record a write to the exact scope given; no ids bumps the store-wide epoch.
+
+        ``floor`` raises the counter to at least that value, which lets a
+        caller carry versions across a recreated database.
+        """
+        with self._lock:
+            try:
+                self.connection.execute("BEGIN")
+                self.connection.execute(
+                    """
+                    INSERT INTO scope_versions (user_id, agent_id, run_id, version)
+                    VALUES (?, ?, ?, MAX(?, 1))
+                    ON CONFLICT (user_id, agent_id, run_id)
+                    DO UPDATE SET version = MAX(version + 1, excluded.version)
+                """,
+                    (user_id or "", agent_id or "", run_id or "", floor),
+                )
+                self.connection.execute("COMMIT")
+            except Exception as e:
+                self.connection.execute("ROLLBACK")
+                logger.error(f"Failed to bump scope version: {e}")
+                raise
+
+    def get_scope_version(
+        self,
+        user_id: Optional[str] = None,
+        agent_id: Optional[str] = None,
+        run_id: Optional[str] = None,
+    ) -> int:
+        """Monotonic version of everything visible to a search with these filters.
+
+        Sums the counters of every exact scope the filters match (a user-level
+        read includes writes made under any of that user's agents or runs)
+        plus the store-wide epoch. Counters only grow, so the sum changes
+        whenever a matching write happens and never goes backwards.
+        """
+        conditions = []
+        params: List[str] = []
+        for column, value in (("user_id", user_id), ("agent_id", agent_id), ("run_id", run_id)):
+            if value:
+                conditions.append(f"{column} = ?")
+                params.append(value)
+        if conditions:
+            sql = f"""
+                SELECT
+                    (SELECT COALESCE(SUM(version), 0) FROM scope_versions WHERE {' AND '.join(conditions)})
+                    + (SELECT COALESCE(MAX(version), 0) FROM scope_versions
+                       WHERE user_id = '' AND agent_id = '' AND run_id = '')
+            """
+        else:
+            sql = "SELECT COALESCE(SUM(version), 0) FROM scope_versions"
+        with self._lock:
+            (version,) = self.connection.execute(sql, params).fetchone()
+        return int(version)
+
     def add_history(
         self,
         memory_id: str,
@@ -324,7 +415,10 @@ class SQLiteManager:
         ]
 
     def reset(self) -> None:
-        """Drop both tables. Caller is expected to replace this instance."""
+        """Drop history and messages. Caller is expected to replace this instance.
+
+        ``scope_versions`` is kept so versions stay monotonic across a reset.
+        """
         if not self.connection:
             raise RuntimeError("Cannot reset a closed SQLiteManager")
         with self._lock:
@@ -1,10 +1,14 @@
 import atexit
+import functools
+import hashlib
 import logging
 import os
 import platform
 import random
 import sys
 import threading
+import time
+from collections import deque
 
 from posthog import Posthog
 
@@ -55,24 +59,56 @@ _LIFECYCLE_EVENTS = frozenset(
 )
 
 
+# Set by capture_event() on events it already sampled; stripped before sending.
+_PRESAMPLED_PROPERTY = "$mem0_presampled"
+
+# Upper bound on events waiting for the telemetry worker; further events are dropped.
+MAX_QUEUED_EVENTS = 10000
+
+
+def _sample(event_name):
+    """Sample rate for an event that is kept, or None if it is dropped."""
+    if event_name in _LIFECYCLE_EVENTS:
+        return 1.0
+    # >= so that rate=0 drops everything and rate=1 keeps everything (random ∈ [0, 1)).
+    if random.random() >= MEM0_TELEMETRY_SAMPLE_RATE:
+        return None
+    return MEM0_TELEMETRY_SAMPLE_RATE
+
+
 def _sampling_before_send(msg):
     """PostHog before_send hook: drop sampled hot-path events, annotate survivors with sample_rate."""
     if not isinstance(msg, dict):
         return None
 
-    event_name = msg.get("event", "")
-    is_lifecycle = event_name in _LIFECYCLE_EVENTS
+    properties = msg.setdefault("properties", {})
+    if isinstance(properties, dict) and properties.pop(_PRESAMPLED_PROPERTY, False):
+        return msg
 
-    # >= so that rate=0 drops everything and rate=1 keeps everything (random ∈ [0, 1)).
-    if not is_lifecycle and random.random() >= MEM0_TELEMETRY_SAMPLE_RATE:
+    sample_rate = _sample(msg.get("event", ""))
+    if sample_rate is None:
         return None
 
     # Annotate so PostHog dashboards can extrapolate true counts via 1/sample_rate.
-    properties = msg.setdefault("properties", {})
-    properties["sample_rate"] = 1.0 if is_lifecycle else MEM0_TELEMETRY_SAMPLE_RATE
+    properties["sample_rate"] = sample_rate
     return msg
 
 
+@functools.lru_cache(maxsize=1)
+def _platform_properties():
+    # platform.processor() can fork a subprocess; these never change in a process.
+    return {
+        "client_source": "python",
+        "client_version": mem0.__version__,
+        "python_version": sys.version,
+        "os": sys.platform,
+        "os_version": platform.version(),
+        "os_release": platform.release(),
+        "processor": platform.processor(),
+        "machine": platform.machine(),
+    }
+
+
 class AnonymousTelemetry:
     def __init__(self, vector_store=None, before_send=None):
         if not MEM0_TELEMETRY:
@@ -100,17 +136,7 @@ class AnonymousTelemetry:
 
         if properties is None:
             properties = {}
-        properties = {
-            "client_source": "python",
-            "client_version": mem0.__version__,
-            "python_version": sys.version,
-            "os": sys.platform,
-            "os_version": platform.version(),
-            "os_release": platform.release(),
-            "processor": platform.processor(),
-            "machine": platform.machine(),
-            **properties,
-        }
+        properties = {**_platform_properties(), **properties}
         try:
             capture_kwargs = {"distinct_id": distinct_id, "properties": properties}
             if flags is not None:
@@ -142,6 +168,159 @@ class AnonymousTelemetry:
             self.posthog = None
 
 
+class LocalTelemetrySink:
+    """In-process stand-in for AnonymousTelemetry that keeps events instead of sending them.
+
+    Used when MEM0_TELEMETRY_SINK=local, and by tests. Has no PostHog client,
+    so notices (which evaluate feature flags) stay silent.
+    """
+
+    def __init__(self, max_events=MAX_QUEUED_EVENTS):
+        self.posthog = None
+        self.user_id = "local"
+        self._events = deque(maxlen=max_events)
+
+    @property
+    def events(self):
+        return list(self._events)
+
+    def capture_event(self, event_name, properties=None, user_email=None, flags=None):
+        properties = dict(properties or {})
+        properties.pop(_PRESAMPLED_PROPERTY, None)
+        self._events.append((event_name, properties))
+
+    def capture_identify(self, anon_id, email):
+        return False
+
+    def close(self):
+        pass
+
+
+class TelemetryFilters:
+    """Search/add filters whose keys and hashed entity ids are computed by the telemetry worker."""
+
+    __slots__ = ("filters",)
+
+    def __init__(self, filters):
+        self.filters = dict(filters) if filters else {}
+
+    def properties(self):
+        encoded_ids = {}
+        for key in ("user_id", "agent_id", "run_id"):
+            if key in self.filters:
+                encoded_ids[key] = hashlib.md5(str(self.filters[key]).encode()).hexdigest()
+        return {"keys": list(self.filters.keys()), "encoded_ids": encoded_ids}
+
+
+class _EventQueue:
+    """Bounded queue of OSS telemetry events drained by one daemon thread.
+
+    capture_event() only samples, snapshots the few Memory attributes an
+    event reports and appends; hashing filter ids, adding platform info and
+    handing the event to PostHog happen on the worker. deque appends and
+    pops are atomic, so the request path takes no lock. When
+    MAX_QUEUED_EVENTS are waiting, new events are dropped and counted.
+    """
+
+    def __init__(self, max_events=MAX_QUEUED_EVENTS):
+        self.max_events = max_events
+        self.dropped = 0
+        self._events = deque()
+        self._wake = threading.Event()
+        self._idle = threading.Condition()
+        self._busy = False
+        self._thread = None
+        self._start_lock = threading.Lock()
+
+    def put(self, item):
+        if len(self._events) >= self.max_events:
+            self.dropped += 1
+            return False
+        self._events.append(item)
+        if self._thread is None:
+            self._start()
+        if not self._wake.is_set():
+            self._wake.set()
+        return True
+
+    def flush(self, timeout=5.0):
+        """Block until every queued event has been handed to its sink."""
+        if self._thread is None:
+            return not self._events
+        self._wake.set()
+        deadline = time.monotonic() + timeout
+        with self._idle:
+            while self._events or self._busy:
+                remaining = deadline - time.monotonic()
+                if remaining <= 0:
+                    return False
+                self._idle.wait(min(remaining, 0.05))
+        return True
+
+    def _start(self):
+        with self._start_lock:
+            if self._thread is not None:
+                return
+            self._thread = threading.Thread(target=self._run, name="mem0-telemetry", daemon=True)
+            self._thread.start()
+            # Registered after the telemetry singleton's shutdown hook, so it runs first.
+            atexit.register(self.flush, 2.0)
+
+    def _run(self):
+        while True:
+            self._wake.wait()
+            self._wake.clear()
+            self._busy = True
+            try:
+                while self._events:
+                    _send_event(*self._events.popleft())
+            finally:
+                with self._idle:
+                    self._busy = False
+                    self._idle.notify_all()
+
+
+def _send_event(telemetry, event_name, snapshot, additional_data, sample_rate):
+    try:
+        event_data = dict(snapshot)
+        if additional_data:
+            for key, value in additional_data.items():
+                if isinstance(value, TelemetryFilters):
+                    event_data.update(value.properties())
+                else:
+                    event_data[key] = value
+        event_data["sample_rate"] = sample_rate
+        event_data[_PRESAMPLED_PROPERTY] = True
+        telemetry.capture_event(event_name, event_data)
+    except Exception as e:
+        _logger.debug("Failed to capture OSS telemetry event %r: %s", event_name, e)
+
+
+def _event_data(memory_instance):
+    """Plain values describing ``memory_instance``; queued instead of the instance itself."""
+
+    def qualname(obj):
+        return f"{obj.__class__.__module__}.{obj.__class__.__name__}"
+
+    return {
+        "collection": memory_instance.collection_name,
+        "vector_size": memory_instance.embedding_model.config.embedding_dims,
+        "history_store": "sqlite",
+        "vector_store": qualname(memory_instance.vector_store),
+        "llm": qualname(memory_instance.llm),
+        "embedding_model": qualname(memory_instance.embedding_model),
+        "function": f"{qualname(memory_instance)}.{memory_instance.api_version}",
+    }
+
+
+_event_queue = _EventQueue()
+
+
+def flush_events(timeout=5.0):
+    """Wait until queued OSS telemetry events have been handed to PostHog (or the local sink)."""
+    return _event_queue.flush(timeout)
+
+
 # Thread-safe lazy singleton for OSS telemetry.
 # A single AnonymousTelemetry instance (and its underlying PostHog client /
 # background thread) is reused for the lifetime of the process instead of
@@ -169,7 +348,10 @@ def _get_oss_telemetry():
         # Double-checked locking
         if _oss_telemetry_instance is not None:
             return _oss_telemetry_instance
-        _oss_telemetry_instance = AnonymousTelemetry(before_send=_sampling_before_send)
+        if os.environ.get("MEM0_TELEMETRY_SINK", "").lower() == "local":
+            _oss_telemetry_instance = LocalTelemetrySink()
+        else:
+            _oss_telemetry_instance = AnonymousTelemetry(before_send=_sampling_before_send)
         atexit.register(_shutdown_oss_telemetry)
         return _oss_telemetry_instance
 
@@ -192,30 +374,27 @@ atexit.register(client_telemetry.close)
 def capture_event(event_name, memory_instance, additional_data=None):
     """Capture telemetry event for OSS Memory instances.
 
-    This function is designed to never raise exceptions - telemetry failures
-    should not affect the main application flow.
+    Sampling is decided first. A kept event queues a snapshot of the Memory
+    attributes it reports, never the instance, so the queue does not keep
+    Memory objects (and their vector store clients) alive. Filter hashing
+    and sending happen on a background thread. This function is designed
+    to never raise exceptions - telemetry failures should not affect the
+    main application flow.
     """
     if not MEM0_TELEMETRY:
         return
 
     try:
+        sample_rate = _sample(event_name)
+        if sample_rate is None:
+            return
+
         oss_telemetry = _get_oss_telemetry()
         if oss_telemetry is None:
             return
 
-        event_data = {
-            "collection": memory_instance.collection_name,
-            "vector_size": memory_instance.embedding_model.config.embedding_dims,
-            "history_store": "sqlite",
-            "vector_store": f"{memory_instance.vector_store.__class__.__module__}.{memory_instance.vector_store.__class__.__name__}",
-            "llm": f"{memory_instance.llm.__class__.__module__}.{memory_instance.llm.__class__.__name__}",
-            "embedding_model": f"{memory_instance.embedding_model.__class__.__module__}.{memory_instance.embedding_model.__class__.__name__}",
-            "function": f"{memory_instance.__class__.__module__}.{memory_instance.__class__.__name__}.{memory_instance.api_version}",
-        }
-        if additional_data:
-            event_data.update(additional_data)
-
-        oss_telemetry.capture_event(event_name, event_data)
+        snapshot = _event_data(memory_instance)
+        _event_queue.put((oss_telemetry, event_name, snapshot, additional_data, sample_rate))
     except Exception as e:
         _logger.debug("Failed to capture OSS telemetry event %r: %s", event_name, e)
 
@@ -1,7 +1,8 @@
 import logging
 import subprocess
 import sys
-import threading
+from concurrent.futures import ThreadPoolExecutor
+from functools import partial
 from typing import List, Optional, Union
 
 import httpx
@@ -21,33 +22,57 @@ except ImportError:
 from mem0 import Memory, MemoryClient
 from mem0.configs.prompts import MEMORY_ANSWER_PROMPT
 from mem0.memory.telemetry import capture_client_event, capture_event
+from mem0.proxy.write_queue import MemoryWriteQueue, conversation_key
 
 logger = logging.getLogger(__name__)
 
 
+def _add_to_memory(mem0_client, messages, **kwargs):
+    kwargs = {k: v for k, v in kwargs.items() if v is not None}
+    if isinstance(mem0_client, Memory):
+        # Memory.add takes no filters argument; only the platform client does.
+        kwargs.pop("filters", None)
+    mem0_client.add(messages=messages, **kwargs)
+
+
 class Mem0:
     def __init__(
         self,
         config: Optional[dict] = None,
         api_key: Optional[str] = None,
         host: Optional[str] = None,
+        max_pending_writes: int = 1000,
+        write_workers: int = 2,
     ):
         if api_key:
             self.mem0_client = MemoryClient(api_key, host)
         else:
             self.mem0_client = Memory.from_config(config) if config else Memory()
 
-        self.chat = Chat(self.mem0_client)
+        self.chat = Chat(self.mem0_client, max_pending_writes=max_pending_writes, write_workers=write_workers)
 
 
 class Chat:
-    def __init__(self, mem0_client):
-        self.completions = Completions(mem0_client)
+    def __init__(self, mem0_client, max_pending_writes: int = 1000, write_workers: int = 2):
+        self.completions = Completions(
+            mem0_client, max_pending_writes=max_pending_writes, write_workers=write_workers
+        )
 
 
 class Completions:
-    def __init__(self, mem0_client):
+    def __init__(self, mem0_client, max_pending_writes: int = 1000, write_workers: int = 2):
         self.mem0_client = mem0_client
+        # Memory writes run on a bounded, coalescing queue; searches run on
+        # their own pool so they overlap with preparing the prompt and never
+        # wait behind writes.
+        self.write_queue = MemoryWriteQueue(
+            partial(_add_to_memory, mem0_client), max_pending=max_pending_writes, workers=write_workers
+        )
+        self._search_pool = ThreadPoolExecutor(max_workers=8, thread_name_prefix="mem0-proxy-search")
+
+    def stats(self) -> dict:
+        """Depth and write/coalesce/drop counters of the background write queue."""
+        return {"writes": self.write_queue.stats()}
 
     def create(
         self,
@@ -97,17 +122,32 @@ class Completions:
         if not any([user_id, agent_id, run_id]):
             raise ValueError("One of user_id, agent_id, run_id must be provided")
 
+        # Start retrieval first so it runs while the request is validated and
+        # the prompt is prepared.
+        retrieval = None
+        if messages and messages[-1]["role"] == "user":
+            retrieval = self._search_pool.submit(
+                self._fetch_relevant_memories, messages, user_id, agent_id, run_id, filters, top_k
+            )
+
         if not litellm.supports_function_calling(model):
+            if retrieval is not None:
+                retrieval.cancel()
             raise ValueError(
                 f"Model '{model}' does not support function calling. Please use a model that supports function calling."
             )
 
         prepared_messages = self._prepare_messages(messages)
-        if prepared_messages[-1]["role"] == "user":
+        if retrieval is not None:
             self._async_add_to_memory(messages, user_id, agent_id, run_id, metadata, filters)
-            relevant_memories = self._fetch_relevant_memories(messages, user_id, agent_id, run_id, filters, top_k)
+            relevant_memories = retrieval.result()
             logger.debug(f"Retrieved {len(relevant_memories)} relevant memories")
-            prepared_messages[-1]["content"] = self._format_query_with_memories(messages, relevant_memories)
+            # Replace rather than edit the last message: the caller's dict is
+            # also what the queued write stores.
+            prepared_messages[-1] = {
+                **prepared_messages[-1],
+                "content": self._format_query_with_memories(messages, relevant_memories),
+            }
 
         response = litellm.completion(
             model=model,
@@ -152,18 +192,16 @@ class Completions:
         return messages
 
     def _async_add_to_memory(self, messages, user_id, agent_id, run_id, metadata, filters):
-        def add_task():
-            logger.debug("Adding to memory asynchronously")
-            self.mem0_client.add(
-                messages=messages,
-                user_id=user_id,
-                agent_id=agent_id,
-                run_id=run_id,
-                metadata=metadata,
-                filters=filters,
-            )
-
-        threading.Thread(target=add_task, daemon=True).start()
+        logger.debug("Queueing memory write")
+        self.write_queue.submit(
+            conversation_key(user_id, agent_id, run_id, metadata, filters, messages),
+            messages,
+            user_id=user_id,
+            agent_id=agent_id,
+            run_id=run_id,
+            metadata=metadata,
+            filters=filters,
+        )
 
     def _fetch_relevant_memories(self, messages, user_id, agent_id, run_id, filters, top_k):
         # Currently, only pass the last 6 messages to the search API to prevent long query
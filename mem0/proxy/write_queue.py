@@ -0,0 +1,213 @@
+"""Bounded background queue for the memory writes of proxied chat completions.
+
+Every proxied completion sends the whole conversation so far, so adding it
+verbatim on each turn re-extracts the same prefix again and again. The queue
+keeps at most one pending write per conversation (entity ids, metadata and
+filters, plus the messages that open the thread): a turn that arrives while
+the previous one is still queued replaces it, and a conversation only sends
+the messages that follow what it already stored, starting from the user turn
+the first of them answers. A fixed set of worker threads drains the queue; when ``max_pending``
+conversations are waiting, new writes are dropped and counted instead of
+spawning more work.
+"""
+
+import hashlib
+import json
+import logging
+import threading
+import time
+from collections import OrderedDict, deque
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+logger = logging.getLogger(__name__)
+
+ConversationKey = Tuple[Any, ...]
+
+
+def conversation_key(
+    user_id: Optional[str] = None,
+    agent_id: Optional[str] = None,
+    run_id: Optional[str] = None,
+    metadata: Optional[dict] = None,
+    filters: Optional[dict] = None,
+    messages: Optional[List[dict]] = None,
+) -> ConversationKey:
+    """Identify a conversation by its scope and the messages that open it.
+
+    Chat APIs carry no thread id, so two threads of the same user with the
+    same ``run_id`` are told apart by their messages up to and including the
+    first user turn, which every later request of a thread repeats.
+    """
+    return (
+        user_id,
+        agent_id,
+        run_id,
+        json.dumps(metadata, sort_keys=True, default=str) if metadata else None,
+        json.dumps(filters, sort_keys=True, default=str) if filters else None,
+        _digest(_opening(messages)) if messages else None,
+    )
+
+
+def _opening(messages: List[dict]) -> List[dict]:
+    for i, message in enumerate(messages):
+        if message.get("role") == "user":
+            return messages[: i + 1]
+    return messages
+
+
+def _digest(messages: List[dict]) -> str:
+    return hashlib.sha1(json.dumps(messages, sort_keys=True, default=str).encode()).hexdigest()
+
+
+def _merge(queued: List[dict], latest: List[dict]) -> List[dict]:
+    """Messages covering both a queued turn and a later one of the same conversation."""
+    if latest[: len(queued)] == queued:
+        return latest
+    if queued[: len(latest)] == latest:
+        return queued
+    # The history was edited or regenerated; the latest request is the
+    # conversation as it stands now.
+    return latest
+
+
+class MemoryWriteQueue:
+    """Coalesce and run ``add`` calls on a fixed number of worker threads.
+
+    ``add(messages, **kwargs)`` is the memory client's add. Writes for one
+    conversation never run concurrently, so each one can skip the messages
+    the previous one stored.
+    """
+
+    def __init__(
+        self,
+        add: Callable[..., Any],
+        max_pending: int = 1000,
+        workers: int = 2,
+        max_conversations: int = 10000,
+    ):
+        self._add = add
+        self.max_pending = max_pending
+        self.workers = workers
+        self.max_conversations = max_conversations
+
+        self._cond = threading.Condition()
+        # Pending write per conversation, and the conversations ready to run
+        # (pending and not already being written).
+        self._pending: Dict[ConversationKey, Tuple[List[dict], Dict[str, Any]]] = {}
+        self._ready: deque = deque()
+        self._in_flight: set = set()
+        # Per conversation: how many leading messages are stored, and their digest.
+        self._stored: "OrderedDict[ConversationKey, Tuple[int, str]]" = OrderedDict()
+        self._threads: List[threading.Thread] = []
+
+        self._enqueued = 0
+        self._coalesced = 0
+        self._dropped = 0
+        self._written = 0
+        self._skipped = 0
+        self._failed = 0
+        self._messages_sent = 0
+        self._messages_trimmed = 0
+
+    def submit(self, key: ConversationKey, messages: List[dict], **kwargs) -> bool:
+        """Queue a write of ``messages``; False if the queue is full and it was dropped."""
+        messages = [dict(m) for m in messages]
+        with self._cond:
+            queued = self._pending.get(key)
+            if queued is not None:
+                self._pending[key] = (_merge(queued[0], messages), kwargs)
+                self._coalesced += 1
+                return True
+            if len(self._pending) >= self.max_pending:
+                self._dropped += 1
+                logger.debug("Memory write queue is full; dropping write")
+                return False
+            self._pending[key] = (messages, kwargs)
+            self._enqueued += 1
+            if key not in self._in_flight:
+                self._ready.append(key)
+            self._ensure_started()
+            self._cond.notify()
+            return True
+
+    def flush(self, timeout: Optional[float] = None) -> bool:
+        """Block until every queued write has run (for shutdown and tests)."""
+        with self._cond:
+            return self._cond.wait_for(lambda: not self._pending and not self._in_flight, timeout)
+
+    def stats(self) -> Dict[str, Any]:
+        with self._cond:
+            return {
+                "depth": len(self._pending),
+                "in_flight": len(self._in_flight),
+                "max_pending": self.max_pending,
+                "workers": self.workers,
+                "enqueued": self._enqueued,
+                "coalesced": self._coalesced,
+                "dropped": self._dropped,
+                "written": self._written,
+                "skipped": self._skipped,
+                "failed": self._failed,
+                "messages_sent": self._messages_sent,
+                "messages_trimmed": self._messages_trimmed,
+            }
+
+    def _ensure_started(self) -> None:
+        while len(self._threads) < self.workers:
+            thread = threading.Thread(
+                target=self._run, name=f"mem0-proxy-writer-{len(self._threads)}", daemon=True
+            )
+            self._threads.append(thread)
+            thread.start()
+
+    def _run(self) -> None:
+        while True:
+            with self._cond:
+                self._cond.wait_for(lambda: self._ready)
+                key = self._ready.popleft()
+                messages, kwargs = self._pending.pop(key)
+                self._in_flight.add(key)
+                new_messages = self._unstored_locked(key, messages)
+            started = time.monotonic()
+            ok = True
+            try:
+                if new_messages:
+                    self._add(new_messages, **kwargs)
+            except Exception as e:
+                ok = False
+                logger.warning(f"Background memory add failed: {e}")
+            with self._cond:
+                self._in_flight.discard(key)
+                if not new_messages:
+                    self._skipped += 1
+                elif ok:
+                    self._written += 1
+                    self._messages_sent += len(new_messages)
+                    self._messages_trimmed += len(messages) - len(new_messages)
+                    self._remember_locked(key, messages)
+                else:
+                    self._failed += 1
+                if key in self._pending:
+                    self._ready.append(key)
+                self._cond.notify_all()
+            logger.debug(f"Memory write took {time.monotonic() - started:.3f}s")
+
+    def _unstored_locked(self, key: ConversationKey, messages: List[dict]) -> List[dict]:
+        stored = self._stored.get(key)
+        if stored is not None:
+            count, digest = stored
+            if count <= len(messages) and _digest(messages[:count]) == digest:
+                if count == len(messages):
+                    return []
+                # Start from the user turn that a leading reply answers.
+                start = count
+                while start > 0 and messages[start].get("role") != "user":
+                    start -= 1
+                return messages[start:]
+        return messages
+
+    def _remember_locked(self, key: ConversationKey, messages: List[dict]) -> None:
+        self._stored[key] = (len(messages), _digest(messages))
+        self._stored.move_to_end(key)
+        while len(self._stored) > self.max_conversations:
+            self._stored.popitem(last=False)
@@ -5,12 +5,18 @@ Provides:
 - **BM25 normalization**: Sigmoid normalization of raw BM25 scores to [0, 1].
 - **BM25 parameter selection**: Query-length-adaptive sigmoid parameters.
 - **Additive scoring**: Combined scoring with semantic + BM25 + entity boost.
+- **BM25 ranking**: Okapi BM25 over candidate documents, for stores whose text
+  engine can match terms but not rank them.
 """
 
 from __future__ import annotations
 
 import math
-from typing import Any, Dict, List, Optional
+import re
+from collections import Counter
+from typing import Any, Dict, List, Optional, Tuple
+
+_TOKEN_RE = re.compile(r"\w+")
 
 
 def get_bm25_params(query: str, *, lemmatized: Optional[str] = None) -> tuple:
@@ -137,3 +143,56 @@ def score_and_rank(
 
     scored.sort(key=lambda x: x["score"], reverse=True)
     return scored[:top_k]
+
+
+def bm25_terms(text: Optional[str]) -> List[str]:
+    """Lowercased word tokens of ``text``, in order, for BM25 matching."""
+    return _TOKEN_RE.findall(text.lower()) if text else []
+
+
+def bm25_rank(
+    query: str,
+    documents: Dict[str, str],
+    total_docs: Optional[int] = None,
+    k1: float = 1.2,
+    b: float = 0.75,
+) -> List[Tuple[str, float]]:
+    """Rank candidate documents against ``query`` with Okapi BM25.
+
+    Meant for stores that can fetch the documents containing any query term
+    (Chroma ``where_document``, SAI text indexes) but return them unranked.
+    Document frequencies are counted over the candidates, which hold every
+    document containing a term unless the store capped the fetch.
+
+    Args:
+        query: Keyword query (lemmatized, like the indexed text).
+        documents: Candidate text keyed by memory ID.
+        total_docs: Documents in the searched scope, if known; defaults to
+            the number of candidates.
+        k1: Term frequency saturation.
+        b: Document length normalization.
+
+    Returns:
+        (memory ID, raw BM25 score) pairs with a positive score, best first.
+    """
+    terms = set(bm25_terms(query))
+    if not terms or not documents:
+        return []
+
+    tokenized = {doc_id: bm25_terms(text) for doc_id, text in documents.items()}
+    avg_len = sum(len(tokens) for tokens in tokenized.values()) / len(tokenized) or 1.0
+    doc_freq = Counter(term for tokens in tokenized.values() for term in terms.intersection(tokens))
+    n_docs = max(total_docs or 0, len(tokenized))
+    idf = {term: math.log(1.0 + (n_docs - df + 0.5) / (df + 0.5)) for term, df in doc_freq.items()}
+
+    ranked = []
+    for doc_id, tokens in tokenized.items():
+        counts = Counter(tokens)
+        norm = k1 * (1.0 - b + b * len(tokens) / avg_len)
+        score = sum(
+            idf[term] * counts[term] * (k1 + 1.0) / (counts[term] + norm) for term in terms if counts[term]
+        )
+        if score > 0:
+            ranked.append((doc_id, score))
+    ranked.sort(key=lambda item: item[1], reverse=True)
+    return ranked
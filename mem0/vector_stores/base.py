@@ -98,3 +98,27 @@ class VectorStoreBase(ABC):
             List of result lists, one per query.
         """
         return [self.search(q, v, top_k=top_k, filters=filters) for q, v in zip(queries, vectors_list)]
+
+    def hybrid_search(self, query: str, keyword_query: str, vectors: list, top_k: int = 5, filters: dict = None):
+        """Semantic and keyword search for one query.
+
+        Default implementation calls search() and keyword_search() one after
+        the other. Override in subclasses that can serve both in a single
+        request (e.g., Elasticsearch/OpenSearch _msearch); the raw scores of
+        each side must be kept, since hybrid scoring normalizes them itself.
+
+        Args:
+            query: The original query text.
+            keyword_query: The query text for keyword search (lemmatized).
+            vectors: The query vector.
+            top_k: Maximum number of results per side.
+            filters: Optional metadata filters applied to both sides.
+
+        Returns:
+            Tuple of (semantic results, keyword results); keyword results are
+            None if keyword search is not supported.
+        """
+        return (
+            self.search(query=query, vectors=vectors, top_k=top_k, filters=filters),
+            self.keyword_search(query=keyword_query, top_k=top_k, filters=filters),
+        )
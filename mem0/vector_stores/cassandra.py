@@ -1,27 +1,48 @@
 import json
 import logging
 import re
+import time
 import uuid
-from typing import Any, Dict, List, Optional
+from typing import Any, Dict, List, Optional, Tuple
 
-import numpy as np
 from pydantic import BaseModel
 
 try:
     from cassandra.auth import PlainTextAuthProvider
     from cassandra.cluster import Cluster
+    from cassandra.concurrent import execute_concurrent_with_args
+    from cassandra.query import SimpleStatement
 except ImportError:
     raise ImportError(
         "Apache Cassandra vector store requires cassandra-driver. "
         "Please install it using 'pip install cassandra-driver'"
     )
 
+from mem0.utils.scoring import bm25_rank, bm25_terms
 from mem0.vector_stores.base import VectorStoreBase
 
 logger = logging.getLogger(__name__)
 
 _SAFE_IDENTIFIER_RE = re.compile(r'^[a-zA-Z_][a-zA-Z0-9_]{0,127}$')
 
+# Payload fields stored as their own SAI-indexed columns so searches and
+# lists can filter on them server-side.
+ENTITY_COLUMNS = ("user_id", "agent_id", "run_id")
+
+# Largest LIMIT an ANN query is widened to when filters that are not entity
+# columns are applied to its results.
+MAX_ANN_LIMIT = 1000
+
+# Rows read and rewritten per page when migrating a legacy table.
+MIGRATION_PAGE_SIZE = 500
+
+# Rows fetched per query term from the text index before BM25 ranking.
+MAX_KEYWORD_CANDIDATES = 1000
+
+# Seconds a scope's row count (or a failure to count it) is reused as the
+# BM25 corpus size.
+SCOPE_COUNT_TTL = 300
+
 
 def _validate_identifier(name: str, label: str = "identifier") -> str:
     if not _SAFE_IDENTIFIER_RE.match(name):
@@ -81,8 +102,13 @@ class CassandraDB(VectorStoreBase):
         # Initialize connection
         self.cluster = None
         self.session = None
+        self._prepared: Dict[str, Any] = {}
+        # Cleared if the cluster cannot build an analyzed SAI index.
+        self._text_index = True
+        # Entity filters -> (monotonic time counted, rows in that scope or None if the count failed).
+        self._scope_counts: Dict[Tuple[Tuple[str, str], ...], Tuple[float, Optional[int]]] = {}
         self._setup_connection()
-        
+
         # Create keyspace and table if they don't exist
         self._create_keyspace()
         self._create_table()
@@ -143,17 +169,13 @@ class CassandraDB(VectorStoreBase):
             raise
 
     def _create_table(self):
-        """Create table with vector column if it doesn't exist."""
+        """Create the table and its indexes, migrating a legacy table if needed."""
         try:
-            # Create table with vector stored as list<float> and payload as text (JSON)
-            query = f"""
-                CREATE TABLE IF NOT EXISTS {self.keyspace}.{self.collection_name} (
-                    id text PRIMARY KEY,
-                    vector list<float>,
-                    payload text
-                )
-            """
-            self.session.execute(query)
+            columns = self._table_columns(self.collection_name)
+            if columns.get("vector", "").startswith("list<") or (columns and "text_lemmatized" not in columns):
+                self.migrate()
+            else:
+                self.create_col()
             logger.info(f"Table '{self.collection_name}' is ready")
         except Exception as e:
             logger.error(f"Failed to create table: {e}")
@@ -163,28 +185,177 @@ class CassandraDB(VectorStoreBase):
         """
         Create a new collection (table in Cassandra).
 
+        The vector is a native ``vector<float, N>`` column with a
+        storage-attached (SAI) ANN index; user_id, agent_id and run_id get
+        their own SAI-indexed columns, and the lemmatized memory text an
+        analyzed SAI index for keyword search.
+
         Args:
             name (str, optional): Collection name (uses self.collection_name if not provided)
             vector_size (int, optional): Vector dimension (uses self.embedding_model_dims if not provided)
-            distance (str): Distance metric (cosine, euclidean, dot_product)
+            distance (str): Similarity function of the ANN index (cosine, euclidean, dot_product)
         """
         table_name = _validate_identifier(name, "table_name") if name else self.collection_name
-        dims = vector_size or self.embedding_model_dims
+        dims = int(vector_size or self.embedding_model_dims)
 
         try:
             query = f"""
                 CREATE TABLE IF NOT EXISTS {self.keyspace}.{table_name} (
                     id text PRIMARY KEY,
-                    vector list<float>,
+                    embedding vector<float, {dims}>,
+                    user_id text,
+                    agent_id text,
+                    run_id text,
+                    text_lemmatized text,
                     payload text
                 )
             """
             self.session.execute(query)
+            self._create_indexes(table_name, distance)
             logger.info(f"Created collection '{table_name}' with vector dimension {dims}")
         except Exception as e:
             logger.error(f"Failed to create collection: {e}")
             raise
 
+    def _create_indexes(self, table_name: str, distance: str = "cosine"):
+        similarity = {"dot_product": "dot_product", "euclidean": "euclidean"}.get(distance, "cosine")
+        self.session.execute(
+            f"CREATE CUSTOM INDEX IF NOT EXISTS {table_name}_embedding_idx "
+            f"ON {self.keyspace}.{table_name} (embedding) USING 'StorageAttachedIndex' "
+            f"WITH OPTIONS = {{'similarity_function': '{similarity}'}}"
+        )
+        for column in ENTITY_COLUMNS:
+            self.session.execute(
+                f"CREATE CUSTOM INDEX IF NOT EXISTS {table_name}_{column}_idx "
+                f"ON {self.keyspace}.{table_name} ({column}) USING 'StorageAttachedIndex'"
+            )
+        try:
+            self.session.execute(
+                f"CREATE CUSTOM INDEX IF NOT EXISTS {table_name}_text_lemmatized_idx "
+                f"ON {self.keyspace}.{table_name} (text_lemmatized) USING 'StorageAttachedIndex' "
+                f"WITH OPTIONS = {{'index_analyzer': 'standard'}}"
+            )
+        except Exception as e:
+            self._text_index = False
+            logger.warning(f"SAI text analyzers are not available, keyword search is disabled: {e}")
+
+    def _table_columns(self, table_name: str) -> Dict[str, str]:
+        rows = self.session.execute(
+            "SELECT column_name, type FROM system_schema.columns WHERE keyspace_name = %s AND table_name = %s",
+            (self.keyspace, table_name),
+        )
+        return {row.column_name: row.type for row in rows}
+
+    def migrate(self):
+        """
+        Bring an older table up to the current schema in place.
+
+        Legacy tables (``vector list<float>``, entity ids only inside the JSON
+        payload) get the ``embedding`` and entity columns; tables from before
+        keyword search get ``text_lemmatized``. The new columns are backfilled
+        page by page from the old ones, the SAI indexes created and finally
+        the old ``vector`` column dropped. Every step is idempotent, so an
+        interrupted migration is finished by the next start.
+        """
+        table = f"{self.keyspace}.{self.collection_name}"
+        columns = self._table_columns(self.collection_name)
+        legacy = "vector" in columns
+        logger.info(f"Migrating Cassandra table '{self.collection_name}' to the current schema")
+
+        if "embedding" not in columns:
+            self.session.execute(f"ALTER TABLE {table} ADD embedding vector<float, {int(self.embedding_model_dims)}>")
+        for column in (*ENTITY_COLUMNS, "text_lemmatized"):
+            if column not in columns:
+                self.session.execute(f"ALTER TABLE {table} ADD {column} text")
+
+        if legacy:
+            update = self._prepare(
+                f"UPDATE {table} SET embedding = ?, user_id = ?, agent_id = ?, run_id = ?, text_lemmatized = ? "
+                "WHERE id = ?"
+            )
+            select = f"SELECT id, vector, payload FROM {table}"
+        else:
+            update = self._prepare(f"UPDATE {table} SET text_lemmatized = ? WHERE id = ?")
+            select = f"SELECT id, payload FROM {table}"
+        rows = self.session.execute(SimpleStatement(select, fetch_size=MIGRATION_PAGE_SIZE))
+        batch: List[Tuple] = []
+        migrated = skipped = 0
+        for row in rows:
+            payload = json.loads(row.payload) if row.payload else {}
+            if not legacy:
+                batch.append((payload.get("text_lemmatized"), row.id))
+            elif not row.vector or len(row.vector) != self.embedding_model_dims:
+                skipped += 1
+                continue
+            else:
+                batch.append((list(row.vector), *self._entity_values(payload), payload.get("text_lemmatized"), row.id))
+            if len(batch) >= MIGRATION_PAGE_SIZE:
+                execute_concurrent_with_args(self.session, update, batch, raise_on_first_error=True)
+                migrated += len(batch)
+                batch = []
+        if batch:
+            execute_concurrent_with_args(self.session, update, batch, raise_on_first_error=True)
+            migrated += len(batch)
+
+        self._create_indexes(self.collection_name)
+        if legacy:
+            self.session.execute(f"ALTER TABLE {table} DROP vector")
+        self._prepared.clear()
+        if skipped:
+            logger.warning(f"Skipped {skipped} rows without a {self.embedding_model_dims}-dim vector")
+        logger.info(f"Migrated {migrated} rows of '{self.collection_name}'")
+
+    def _prepare(self, query: str):
+        prepared = self._prepared.get(query)
+        if prepared is None:
+            prepared = self._prepared[query] = self.session.prepare(query)
+        return prepared
+
+    @staticmethod
+    def _entity_values(payload: Dict) -> List[Optional[str]]:
+        return [str(payload[c]) if payload.get(c) is not None else None for c in ENTITY_COLUMNS]
+
+    @staticmethod
+    def _split_filters(filters: Optional[Dict]) -> Tuple[Dict[str, Any], Dict[str, Any]]:
+        """Split filters into entity-column equalities and the rest (matched on the payload)."""
+        indexed, remaining = {}, {}
+        for key, value in (filters or {}).items():
+            if key in ENTITY_COLUMNS and isinstance(value, (str, int)):
+                indexed[key] = str(value)
+            else:
+                remaining[key] = value
+        return indexed, remaining
+
+    @staticmethod
+    def _matches(payload: Dict, filters: Dict[str, Any]) -> bool:
+        return all(payload.get(k) == v for k, v in filters.items())
+
+    def _scope_count(self, indexed: Dict[str, str]) -> Optional[int]:
+        """Rows matching the entity-column filters, cached for SCOPE_COUNT_TTL seconds.
+
+        COUNT(*) reads the whole scope, so the result is an estimate that is
+        refreshed only now and then. None without entity filters (that would
+        be a full-table scan) or if the count failed; failures are cached too
+        so a scope that times out is not recounted on every search.
+        """
+        if not indexed:
+            return None
+        key = tuple(sorted(indexed.items()))
+        now = time.monotonic()
+        cached = self._scope_counts.get(key)
+        if cached is not None and now - cached[0] < SCOPE_COUNT_TTL:
+            return cached[1]
+        where = " AND ".join(f"{column} = ?" for column in indexed)
+        query = f"SELECT COUNT(*) AS count FROM {self.keyspace}.{self.collection_name} WHERE {where}"
+        try:
+            row = self.session.execute(self._prepare(query), tuple(indexed.values())).one()
+            count = row.count if row else 0
+        except Exception as e:
+            logger.debug(f"Failed to count rows for keyword search: {e}")
+            count = None
+        self._scope_counts[key] = (now, count)
+        return count
+
     def insert(
         self,
         vectors: List[List[float]],
@@ -208,15 +379,23 @@ class CassandraDB(VectorStoreBase):
 
         try:
             query = f"""
-                INSERT INTO {self.keyspace}.{self.collection_name} (id, vector, payload)
-                VALUES (?, ?, ?)
+                INSERT INTO {self.keyspace}.{self.collection_name}
+                    (id, embedding, user_id, agent_id, run_id, text_lemmatized, payload)
+                VALUES (?, ?, ?, ?, ?, ?, ?)
             """
-            prepared = self.session.prepare(query)
+            prepared = self._prepare(query)
 
             for vector, payload, vec_id in zip(vectors, payloads, ids):
+                payload = payload or {}
                 self.session.execute(
                     prepared,
-                    (vec_id, vector, json.dumps(payload))
+                    (
+                        vec_id,
+                        vector,
+                        *self._entity_values(payload),
+                        payload.get("text_lemmatized"),
+                        json.dumps(payload),
+                    ),
                 )
         except Exception as e:
             logger.error(f"Failed to insert vectors: {e}")
@@ -230,7 +409,11 @@ class CassandraDB(VectorStoreBase):
         filters: Optional[Dict] = None,
     ) -> List[OutputData]:
         """
-        Search for similar vectors using cosine similarity.
+        Search for similar vectors with the SAI ANN index.
+
+        user_id / agent_id / run_id filters are indexed predicates of the ANN
+        query. Other filters are matched on the payload of the returned rows,
+        widening the ANN limit until ``top_k`` rows match or the table runs out.
 
         Args:
             query (str): Query string (not used in vector search)
@@ -241,51 +424,84 @@ class CassandraDB(VectorStoreBase):
         Returns:
             List[OutputData]: Search results
         """
+        indexed, remaining = self._split_filters(filters)
+        where = " AND ".join(f"{column} = ?" for column in indexed)
+        query_cql = f"""
+            SELECT id, payload, similarity_cosine(embedding, ?) AS score
+            FROM {self.keyspace}.{self.collection_name}
+            {f"WHERE {where}" if where else ""}
+            ORDER BY embedding ANN OF ?
+            LIMIT ?
+        """
         try:
-            # Fetch all vectors (in production, you'd want pagination or filtering)
-            query_cql = f"""
-                SELECT id, vector, payload
-                FROM {self.keyspace}.{self.collection_name}
-            """
-            rows = self.session.execute(query_cql)
+            prepared = self._prepare(query_cql)
+            limit = top_k if not remaining else min(top_k * 4, MAX_ANN_LIMIT)
+            while True:
+                rows = list(self.session.execute(prepared, (vectors, *indexed.values(), vectors, limit)))
+                results = []
+                for row in rows:
+                    payload = json.loads(row.payload) if row.payload else {}
+                    if remaining and not self._matches(payload, remaining):
+                        continue
+                    # similarity_cosine is scaled to [0, 1]; report the cosine itself.
+                    results.append(OutputData(id=row.id, score=2 * float(row.score) - 1, payload=payload))
+                if len(results) >= top_k or len(rows) < limit or limit >= MAX_ANN_LIMIT:
+                    return results[:top_k]
+                limit = min(limit * 4, MAX_ANN_LIMIT)
+        except Exception as e:
+            logger.error(f"Search failed: {e}")
+            raise
 
-            # Calculate cosine similarity in Python
-            query_vec = np.array(vectors)
-            scored_results = []
+    def keyword_search(self, query: str, top_k: int = 5, filters: Optional[Dict] = None) -> Optional[List[OutputData]]:
+        """
+        Search for memories by keyword with the analyzed SAI text index.
 
-            for row in rows:
-                if not row.vector:
-                    continue
+        SAI matches terms but does not rank them, so each query term is
+        looked up concurrently and the matching rows are ranked with BM25.
 
-                vec = np.array(row.vector)
+        Args:
+            query (str): The search query text (lemmatized)
+            top_k (int): Number of results to return
+            filters (Dict, optional): Filters to apply to the search
 
-                similarity = float(np.dot(query_vec, vec) / (np.linalg.norm(query_vec) * np.linalg.norm(vec)))
+        Returns:
+            List[OutputData]: Search results with raw BM25 scores, or None if
+            the cluster has no SAI text analyzers
+        """
+        if not self._text_index:
+            return None
+        terms = list(dict.fromkeys(bm25_terms(query)))
+        if not terms:
+            return []
 
-                # Apply filters if provided
-                if filters:
-                    try:
-                        payload = json.loads(row.payload) if row.payload else {}
-                        match = all(payload.get(k) == v for k, v in filters.items())
-                        if not match:
-                            continue
-                    except json.JSONDecodeError:
+        indexed, remaining = self._split_filters(filters)
+        where = " AND ".join(["text_lemmatized : ?", *(f"{column} = ?" for column in indexed)])
+        query_cql = f"""
+            SELECT id, text_lemmatized, payload
+            FROM {self.keyspace}.{self.collection_name}
+            WHERE {where}
+            LIMIT ?
+        """
+        try:
+            prepared = self._prepare(query_cql)
+            args = [(term, *indexed.values(), MAX_KEYWORD_CANDIDATES) for term in terms]
+            documents: Dict[str, str] = {}
+            payloads: Dict[str, Dict] = {}
+            for success, rows in execute_concurrent_with_args(self.session, prepared, args, raise_on_first_error=True):
+                for row in rows:
+                    if row.id in payloads:
                         continue
-
-                scored_results.append((row.id, similarity, row.payload))
-
-            scored_results.sort(key=lambda x: x[1], reverse=True)
-            scored_results = scored_results[:top_k]
-
-            return [
-                OutputData(
-                    id=r[0],
-                    score=float(r[1]),
-                    payload=json.loads(r[2]) if r[2] else {}
-                )
-                for r in scored_results
-            ]
+                    payload = json.loads(row.payload) if row.payload else {}
+                    if remaining and not self._matches(payload, remaining):
+                        continue
+                    documents[row.id] = row.text_lemmatized or ""
+                    payloads[row.id] = payload
+            # IDF needs the scope's size, not just the rows containing a term.
+            total_docs = max(self._scope_count(indexed) or 0, len(documents))
+            ranked = bm25_rank(query, documents, total_docs=total_docs)
+            return [OutputData(id=row_id, score=score, payload=payloads[row_id]) for row_id, score in ranked[:top_k]]
         except Exception as e:
-            logger.error(f"Search failed: {e}")
+            logger.error(f"Keyword search failed: {e}")
             raise
 
     def delete(self, vector_id: str):
@@ -300,7 +516,7 @@ class CassandraDB(VectorStoreBase):
                 DELETE FROM {self.keyspace}.{self.collection_name}
                 WHERE id = ?
             """
-            prepared = self.session.prepare(query)
+            prepared = self._prepare(query)
             self.session.execute(prepared, (vector_id,))
             logger.info(f"Deleted vector with id: {vector_id}")
         except Exception as e:
@@ -325,20 +541,23 @@ class CassandraDB(VectorStoreBase):
             if vector is not None:
                 query = f"""
                     UPDATE {self.keyspace}.{self.collection_name}
-                    SET vector = ?
+                    SET embedding = ?
                     WHERE id = ?
                 """
-                prepared = self.session.prepare(query)
+                prepared = self._prepare(query)
                 self.session.execute(prepared, (vector, vector_id))
 
             if payload is not None:
                 query = f"""
                     UPDATE {self.keyspace}.{self.collection_name}
-                    SET payload = ?
+                    SET payload = ?, user_id = ?, agent_id = ?, run_id = ?, text_lemmatized = ?
                     WHERE id = ?
                 """
-                prepared = self.session.prepare(query)
-                self.session.execute(prepared, (json.dumps(payload), vector_id))
+                prepared = self._prepare(query)
+                self.session.execute(
+                    prepared,
+                    (json.dumps(payload), *self._entity_values(payload), payload.get("text_lemmatized"), vector_id),
+                )
 
             logger.info(f"Updated vector with id: {vector_id}")
         except Exception as e:
@@ -357,11 +576,11 @@ class CassandraDB(VectorStoreBase):
         """
         try:
             query = f"""
-                SELECT id, vector, payload
+                SELECT id, payload
                 FROM {self.keyspace}.{self.collection_name}
                 WHERE id = ?
             """
-            prepared = self.session.prepare(query)
+            prepared = self._prepare(query)
             row = self.session.execute(prepared, (vector_id,)).one()
 
             if not row:
@@ -446,33 +665,28 @@ class CassandraDB(VectorStoreBase):
         Returns:
             List[List[OutputData]]: List of vectors
         """
+        indexed, remaining = self._split_filters(filters)
+        where = " AND ".join(f"{column} = ?" for column in indexed)
         try:
             query = f"""
-                SELECT id, vector, payload
+                SELECT id, payload
                 FROM {self.keyspace}.{self.collection_name}
-                LIMIT {top_k}
+                {f"WHERE {where}" if where else ""}
+                LIMIT ?
             """
-            rows = self.session.execute(query)
+            rows = self.session.execute(self._prepare(query), (*indexed.values(), top_k))
 
             results = []
             for row in rows:
-                # Apply filters if provided
-                if filters:
-                    try:
-                        payload = json.loads(row.payload) if row.payload else {}
-                        match = all(payload.get(k) == v for k, v in filters.items())
-                        if not match:
-                            continue
-                    except json.JSONDecodeError:
-                        continue
+                try:
+                    payload = json.loads(row.payload) if row.payload else {}
+                except json.JSONDecodeError:
+                    continue
+                # Filters on fields other than the entity columns
+                if remaining and not self._matches(payload, remaining):
+                    continue
 
-                results.append(
-                    OutputData(
-                        id=row.id,
-                        score=None,
-                        payload=json.loads(row.payload) if row.payload else {}
-                    )
-                )
+                results.append(OutputData(id=row.id, score=None, payload=payload))
 
             return [results]
         except Exception as e:
@@ -487,6 +701,7 @@ class CassandraDB(VectorStoreBase):
                 TRUNCATE TABLE {self.keyspace}.{self.collection_name}
             """
             self.session.execute(query)
+            self._scope_counts.clear()
             logger.info(f"Collection '{self.collection_name}' has been reset")
         except Exception as e:
             logger.error(f"Failed to reset collection: {e}")
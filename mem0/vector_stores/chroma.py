@@ -9,10 +9,14 @@ try:
 except ImportError:
     raise ImportError("The 'chromadb' library is required. Please install it using 'pip install chromadb'.")
 
+from mem0.utils.scoring import bm25_rank, bm25_terms
 from mem0.vector_stores.base import VectorStoreBase
 
 logger = logging.getLogger(__name__)
 
+# Most documents fetched as keyword candidates before BM25 ranking.
+MAX_KEYWORD_CANDIDATES = 1000
+
 
 class OutputData(BaseModel):
     id: Optional[str]  # memory id
@@ -140,7 +144,11 @@ class ChromaDB(VectorStoreBase):
             ids (Optional[List[str]], optional): List of IDs corresponding to vectors. Defaults to None.
         """
         logger.info(f"Inserting {len(vectors)} vectors into collection {self.collection_name}")
-        self.collection.add(ids=ids, embeddings=vectors, metadatas=payloads)
+        documents = self._documents(payloads)
+        if documents:
+            self.collection.add(ids=ids, embeddings=vectors, metadatas=payloads, documents=documents)
+        else:
+            self.collection.add(ids=ids, embeddings=vectors, metadatas=payloads)
 
     def search(
         self, query: str, vectors: List[list], top_k: int = 5, filters: Optional[Dict] = None
@@ -162,6 +170,41 @@ class ChromaDB(VectorStoreBase):
         final_results = self._parse_output(results)
         return final_results
 
+    def keyword_search(self, query: str, top_k: int = 5, filters: Optional[Dict] = None) -> List[OutputData]:
+        """
+        Search for memories by keyword over their lemmatized text.
+
+        Chroma's ``where_document`` finds the documents containing any query
+        term but does not rank them, so the candidates are ranked with BM25.
+
+        Args:
+            query (str): The search query text (lemmatized).
+            top_k (int, optional): Number of results to return. Defaults to 5.
+            filters (Optional[Dict], optional): Filters to apply to the search. Defaults to None.
+
+        Returns:
+            List[OutputData]: Search results with raw BM25 scores.
+        """
+        terms = list(dict.fromkeys(bm25_terms(query)))
+        if not terms:
+            return []
+        contains = [{"$contains": term} for term in terms]
+        where_document = contains[0] if len(contains) == 1 else {"$or": contains}
+        where_clause = self._generate_where_clause(filters) if filters else None
+        results = self.collection.get(
+            where=where_clause,
+            where_document=where_document,
+            limit=MAX_KEYWORD_CANDIDATES,
+            include=["metadatas", "documents"],
+        )
+
+        ids = results.get("ids") or []
+        documents = results.get("documents") or []
+        metadatas = results.get("metadatas") or []
+        payloads = dict(zip(ids, metadatas))
+        ranked = bm25_rank(query, dict(zip(ids, documents)), total_docs=self.collection.count())
+        return [OutputData(id=doc_id, score=score, payload=payloads.get(doc_id)) for doc_id, score in ranked[:top_k]]
+
     def delete(self, vector_id: str):
         """
         Delete a vector by ID.
@@ -185,10 +228,21 @@ class ChromaDB(VectorStoreBase):
             vector (Optional[List[float]], optional): Updated vector. Defaults to None.
             payload (Optional[Dict], optional): Updated payload. Defaults to None.
         """
+        documents = self._documents([payload]) if payload is not None else None
+        if documents and vector is None:
+            # A document sent without its embedding is re-embedded by the
+            # collection's embedding function, so resend the stored one.
+            existing = self.collection.get(ids=[vector_id], include=["embeddings"])
+            embeddings = existing.get("embeddings")
+            if embeddings is not None and len(embeddings):
+                vector = list(embeddings[0])
+            else:
+                documents = None
         self.collection.update(
             ids=[vector_id],
             embeddings=[vector] if vector is not None else None,
             metadatas=[payload] if payload is not None else None,
+            **({"documents": documents} if documents else {}),
         )
 
     def get(self, vector_id: str) -> Optional[OutputData]:
@@ -244,6 +298,12 @@ class ChromaDB(VectorStoreBase):
         results = self.collection.get(where=where_clause, limit=top_k)
         return [self._parse_output(results)]
 
+    @staticmethod
+    def _documents(payloads: Optional[List[Dict]]) -> Optional[List[Optional[str]]]:
+        """Lemmatized text stored as each record's document, for ``where_document`` matching."""
+        documents = [(payload or {}).get("text_lemmatized") for payload in payloads or []]
+        return documents if any(documents) else None
+
     def reset(self):
         """Reset the index by deleting and recreating it."""
         logger.warning(f"Resetting index {self.collection_name}...")
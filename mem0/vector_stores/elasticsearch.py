@@ -14,6 +14,9 @@ from mem0.vector_stores.base import VectorStoreBase
 
 logger = logging.getLogger(__name__)
 
+# Elasticsearch rejects knn searches with num_candidates above this.
+MAX_NUM_CANDIDATES = 10000
+
 
 class OutputData(BaseModel):
     id: str
@@ -45,6 +48,7 @@ class ElasticsearchDB(VectorStoreBase):
 
         self.collection_name = config.collection_name
         self.embedding_model_dims = config.embedding_model_dims
+        self.num_candidates = config.num_candidates
 
         # Create index only if auto_create_index is True
         if config.auto_create_index:
@@ -145,27 +149,8 @@ class ElasticsearchDB(VectorStoreBase):
         1. Use custom search query if provided
         2. Use KNN search on vectors with pre-filtering if no custom search query is provided
         """
-        if self.custom_search_query:
-            search_query = self.custom_search_query(vectors, top_k, filters)
-        else:
-            search_query = {
-                "knn": {"field": "vector", "query_vector": vectors, "k": top_k, "num_candidates": top_k * 2}
-            }
-            if filters:
-                filter_conditions = []
-                for key, value in filters.items():
-                    filter_conditions.append({"term": {f"metadata.{key}": value}})
-                search_query["knn"]["filter"] = {"bool": {"must": filter_conditions}}
-
-        response = self.client.search(index=self.collection_name, body=search_query)
-
-        results = []
-        for hit in response["hits"]["hits"]:
-            results.append(
-                OutputData(id=hit["_id"], score=hit["_score"], payload=hit.get("_source", {}).get("metadata", {}))
-            )
-
-        return results
+        response = self.client.search(index=self.collection_name, body=self._semantic_query(vectors, top_k, filters))
+        return self._parse_hits(response)
 
     def keyword_search(self, query, top_k=5, filters=None):
         """Search for memories using BM25 keyword matching.
@@ -178,6 +163,58 @@ class ElasticsearchDB(VectorStoreBase):
         Returns:
             List[OutputData]: Search results with id, score, and payload.
         """
+        response = self.client.search(index=self.collection_name, body=self._keyword_query(query, top_k, filters))
+        return self._parse_hits(response)
+
+    def hybrid_search(self, query, keyword_query, vectors, top_k=5, filters=None):
+        """Run the KNN and BM25 searches in a single _msearch request.
+
+        Elasticsearch's own rank fusion (RRF retrievers) would return one fused
+        rank, but hybrid scoring needs each side's raw score, so both queries
+        are sent together and their hits returned separately.
+
+        Returns:
+            Tuple of (semantic results, keyword results).
+        """
+        semantic, keyword = self._msearch(
+            [self._semantic_query(vectors, top_k, filters), self._keyword_query(keyword_query, top_k, filters)]
+        )
+        if "error" in semantic:
+            raise RuntimeError(f"Elasticsearch KNN search failed: {semantic['error']}")
+        if "error" in keyword:
+            logger.warning(f"Elasticsearch keyword search failed: {keyword['error']}")
+            return self._parse_hits(semantic), None
+        return self._parse_hits(semantic), self._parse_hits(keyword)
+
+    def search_batch(self, queries, vectors_list, top_k=1, filters=None):
+        """Run one KNN search per query vector in a single _msearch request."""
+        if not vectors_list:
+            return []
+        responses = self._msearch([self._semantic_query(vectors, top_k, filters) for vectors in vectors_list])
+        results = []
+        for response in responses:
+            if "error" in response:
+                raise RuntimeError(f"Elasticsearch KNN search failed: {response['error']}")
+            results.append(self._parse_hits(response))
+        return results
+
+    def _semantic_query(self, vectors: List[float], top_k: int, filters: Optional[Dict]) -> Dict:
+        if self.custom_search_query:
+            return self.custom_search_query(vectors, top_k, filters)
+        num_candidates = max(self.num_candidates, top_k) if self.num_candidates else max(top_k * 4, 100)
+        search_query = {
+            "knn": {
+                "field": "vector",
+                "query_vector": vectors,
+                "k": top_k,
+                "num_candidates": min(num_candidates, MAX_NUM_CANDIDATES),
+            }
+        }
+        if filters:
+            search_query["knn"]["filter"] = {"bool": {"must": self._filter_conditions(filters)}}
+        return search_query
+
+    def _keyword_query(self, query: str, top_k: int, filters: Optional[Dict]) -> Dict:
         # Build a multi_match query across text fields in metadata
         should_clauses = [
             {"match": {"metadata.data": query}},
@@ -190,25 +227,30 @@ class ElasticsearchDB(VectorStoreBase):
         }
 
         if filters:
-            filter_conditions = []
-            for key, value in filters.items():
-                filter_conditions.append({"term": {f"metadata.{key}": value}})
-            bool_query["filter"] = filter_conditions
+            bool_query["filter"] = self._filter_conditions(filters)
 
-        search_query = {
+        return {
             "size": top_k,
             "query": {"bool": bool_query},
         }
 
-        response = self.client.search(index=self.collection_name, body=search_query)
-
-        results = []
-        for hit in response["hits"]["hits"]:
-            results.append(
-                OutputData(id=hit["_id"], score=hit["_score"], payload=hit.get("_source", {}).get("metadata", {}))
-            )
-
-        return results
+    @staticmethod
+    def _filter_conditions(filters: Dict) -> List[Dict]:
+        return [{"term": {f"metadata.{key}": value}} for key, value in filters.items()]
+
+    def _msearch(self, bodies: List[Dict]) -> List[Dict]:
+        searches = []
+        for body in bodies:
+            searches.append({"index": self.collection_name})
+            searches.append(body)
+        return self.client.msearch(body=searches)["responses"]
+
+    @staticmethod
+    def _parse_hits(response: Dict) -> List[OutputData]:
+        return [
+            OutputData(id=hit["_id"], score=hit["_score"], payload=hit.get("_source", {}).get("metadata", {}))
+            for hit in response["hits"]["hits"]
+        ]
 
     def delete(self, vector_id: str) -> None:
         """Delete a vector by ID."""
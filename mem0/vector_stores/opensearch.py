@@ -53,6 +53,7 @@ class OpenSearchDB(VectorStoreBase):
         self.collection_name = config.collection_name
         self.embedding_model_dims = config.embedding_model_dims
         self.auto_refresh = config.auto_refresh
+        self.ef_search = config.ef_search
 
         self.create_col(self.collection_name, self.embedding_model_dims)
 
@@ -189,45 +190,11 @@ class OpenSearchDB(VectorStoreBase):
         self, query: str, vectors: List[float], top_k: int = 5, filters: Optional[Dict] = None
     ) -> List[OutputData]:
         """Search for similar vectors using OpenSearch k-NN search with optional filters."""
-
-        # Base KNN query
-        knn_query = {
-            "knn": {
-                "vector_field": {
-                    "vector": vectors,
-                    "k": top_k * 2,
-                }
-            }
-        }
-
-        # Start building the full query
-        query_body = {"size": top_k * 2, "query": None}
-
-        # Prepare filter conditions if applicable
-        filter_clauses = []
-        if filters:
-            for key in ["user_id", "run_id", "agent_id"]:
-                value = filters.get(key)
-                if value:
-                    _validate_filter(key, value)
-                    filter_clauses.append({"term": {f"payload.{key}.keyword": value}})
-
-        # Combine knn with filters if needed
-        if filter_clauses:
-            query_body["query"] = {"bool": {"must": knn_query, "filter": filter_clauses}}
-        else:
-            query_body["query"] = knn_query
-
+        query_body = self._knn_query(vectors, top_k, filters)
         try:
             # Execute search
             response = self.client.search(index=self.collection_name, body=query_body)
-
-            hits = response["hits"]["hits"]
-            results = [
-                OutputData(id=hit["_source"].get("id"), score=hit["_score"], payload=hit["_source"].get("payload", {}))
-                for hit in hits[:top_k]  # Ensure we don't exceed top_k
-            ]
-            return results
+            return self._parse_hits(response, top_k)
         except Exception as e:
             logger.error(f"Error during search: {e}", exc_info=True)
             return []
@@ -243,6 +210,71 @@ class OpenSearchDB(VectorStoreBase):
         Returns:
             List[OutputData]: Search results with id, score, and payload.
         """
+        query_body = self._keyword_query(query, top_k, filters)
+        try:
+            response = self.client.search(index=self.collection_name, body=query_body)
+            return self._parse_hits(response, top_k)
+        except Exception as e:
+            logger.error(f"Error during keyword search: {e}")
+            return []
+
+    def hybrid_search(self, query, keyword_query, vectors, top_k=5, filters=None):
+        """Run the k-NN and BM25 searches in a single _msearch request.
+
+        A ``hybrid`` query would normalize and combine the scores in a search
+        pipeline, but hybrid scoring needs each side's raw score, so both
+        queries are sent together and their hits returned separately.
+
+        Returns:
+            Tuple of (semantic results, keyword results).
+        """
+        bodies = [self._knn_query(vectors, top_k, filters), self._keyword_query(keyword_query, top_k, filters)]
+        try:
+            semantic, keyword = self._msearch(bodies)
+        except Exception as e:
+            logger.error(f"Error during hybrid search: {e}", exc_info=True)
+            return [], []
+        results = []
+        for kind, response in (("search", semantic), ("keyword search", keyword)):
+            if "error" in response:
+                logger.error(f"Error during {kind}: {response['error']}")
+                results.append([])
+            else:
+                results.append(self._parse_hits(response, top_k))
+        return results[0], results[1]
+
+    def search_batch(self, queries, vectors_list, top_k=1, filters=None):
+        """Run one k-NN search per query vector in a single _msearch request."""
+        if not vectors_list:
+            return []
+        try:
+            responses = self._msearch([self._knn_query(vectors, top_k, filters) for vectors in vectors_list])
+        except Exception as e:
+            logger.error(f"Error during batch search: {e}", exc_info=True)
+            return [[] for _ in vectors_list]
+        results = []
+        for response in responses:
+            if "error" in response:
+                logger.error(f"Error during batch search: {response['error']}")
+                results.append([])
+            else:
+                results.append(self._parse_hits(response, top_k))
+        return results
+
+    def _knn_query(self, vectors: List[float], top_k: int, filters: Optional[Dict]) -> Dict:
+        # Base KNN query
+        knn_params = {"vector": vectors, "k": top_k * 2}
+        if self.ef_search:
+            knn_params["method_parameters"] = {"ef_search": max(self.ef_search, top_k * 2)}
+        knn_query = {"knn": {"vector_field": knn_params}}
+
+        # Combine knn with filters if needed
+        filter_clauses = self._filter_clauses(filters)
+        if filter_clauses:
+            return {"size": top_k * 2, "query": {"bool": {"must": knn_query, "filter": filter_clauses}}}
+        return {"size": top_k * 2, "query": knn_query}
+
+    def _keyword_query(self, query: str, top_k: int, filters: Optional[Dict]) -> Dict:
         # Build a multi_match query across text fields in payload
         should_clauses = [
             {"match": {"payload.data": query}},
@@ -254,35 +286,40 @@ class OpenSearchDB(VectorStoreBase):
             "minimum_should_match": 1,
         }
 
-        # Apply filters consistently with the existing search() method
-        filter_clauses = []
-        if filters:
-            for key in ["user_id", "run_id", "agent_id"]:
-                value = filters.get(key)
-                if value:
-                    _validate_filter(key, value)
-                    filter_clauses.append({"term": {f"payload.{key}.keyword": value}})
-
+        # Apply filters consistently with the k-NN query
+        filter_clauses = self._filter_clauses(filters)
         if filter_clauses:
             bool_query["filter"] = filter_clauses
 
-        query_body = {
+        return {
             "size": top_k,
             "query": {"bool": bool_query},
         }
 
-        try:
-            response = self.client.search(index=self.collection_name, body=query_body)
-
-            hits = response["hits"]["hits"]
-            results = [
-                OutputData(id=hit["_source"].get("id"), score=hit["_score"], payload=hit["_source"].get("payload", {}))
-                for hit in hits[:top_k]
-            ]
-            return results
-        except Exception as e:
-            logger.error(f"Error during keyword search: {e}")
-            return []
+    @staticmethod
+    def _filter_clauses(filters: Optional[Dict]) -> List[Dict]:
+        filter_clauses = []
+        if filters:
+            for key in ["user_id", "run_id", "agent_id"]:
+                value = filters.get(key)
+                if value:
+                    _validate_filter(key, value)
+                    filter_clauses.append({"term": {f"payload.{key}.keyword": value}})
+        return filter_clauses
+
+    def _msearch(self, bodies: List[Dict]) -> List[Dict]:
+        searches = []
+        for body in bodies:
+            searches.append({"index": self.collection_name})
+            searches.append(body)
+        return self.client.msearch(body=searches)["responses"]
+
+    @staticmethod
+    def _parse_hits(response: Dict, top_k: int) -> List[OutputData]:
+        return [
+            OutputData(id=hit["_source"].get("id"), score=hit["_score"], payload=hit["_source"].get("payload", {}))
+            for hit in response["hits"]["hits"][:top_k]  # Ensure we don't exceed top_k
+        ]
 
     def delete(self, vector_id: str) -> None:
         """Delete a vector by custom ID."""
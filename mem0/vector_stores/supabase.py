@@ -3,6 +3,7 @@ import uuid
 from typing import List, Optional
 
 from pydantic import BaseModel
+from sqlalchemy import func, literal_column, select, text
 
 try:
     import vecs
@@ -88,6 +89,7 @@ class Supabase(VectorStoreBase):
         try:
             self.collection = self.db.get_or_create_collection(name=self.collection_name, dimension=dims)
             self.collection.create_index(method=self.index_method.value, measure=self.index_measure.value)
+            self._create_text_index()
             logger.info(f"Successfully created collection {self.collection_name} with dimension {dims}")
         except Exception as e:
             logger.error(f"Failed to create collection: {str(e)}")
@@ -137,6 +139,52 @@ class Supabase(VectorStoreBase):
 
         return [OutputData(id=str(result[0]), score=max(0.0, 1.0 - float(result[1])), payload=result[2]) for result in results]
 
+    def _text_vector(self):
+        return func.to_tsvector(literal_column("'simple'"), self.collection.table.c.metadata["text_lemmatized"].astext)
+
+    def _create_text_index(self):
+        """Create the GIN full-text index used by keyword_search."""
+        try:
+            preparer = self.db.engine.dialect.identifier_preparer
+            with self.db.engine.begin() as conn:
+                conn.execute(
+                    text(
+                        f"CREATE INDEX IF NOT EXISTS {preparer.quote(f'{self.collection_name}_text_lemmatized_idx')} "
+                        f"ON {preparer.format_table(self.collection.table)} "
+                        "USING gin(to_tsvector('simple', metadata->>'text_lemmatized'))"
+                    )
+                )
+        except Exception as e:
+            logger.warning(f"Failed to create full-text index, keyword search will scan the collection: {e}")
+
+    def keyword_search(self, query: str, top_k: int = 5, filters: Optional[dict] = None) -> Optional[List[OutputData]]:
+        """
+        Search using PostgreSQL full-text search on lemmatized text.
+
+        Args:
+            query (str): The search query text.
+            top_k (int, optional): Number of results to return. Defaults to 5.
+            filters (Dict, optional): Filters to apply to the search. Defaults to None.
+
+        Returns:
+            List[OutputData]: Search results ranked by text relevance.
+        """
+        try:
+            table = self.collection.table
+            text_vector = self._text_vector()
+            text_query = func.plainto_tsquery(literal_column("'simple'"), query)
+            score = func.ts_rank_cd(text_vector, text_query).label("score")
+            stmt = select(table.c.id, score, table.c.metadata).where(text_vector.op("@@")(text_query))
+            if filters:
+                stmt = stmt.where(table.c.metadata.contains(filters))
+            stmt = stmt.order_by(score.desc()).limit(top_k)
+            with self.db.Session() as session:
+                rows = session.execute(stmt).fetchall()
+            return [OutputData(id=str(row[0]), score=float(row[1]), payload=row[2]) for row in rows]
+        except Exception as e:
+            logger.debug(f"Keyword search failed: {e}")
+            return None
+
     def delete(self, vector_id: str):
         """
         Delete a vector by ID.
@@ -15,6 +15,9 @@ from mem0.vector_stores.base import VectorStoreBase
 
 logger = logging.getLogger(__name__)
 
+# Declared on every write so the lemmatized memory text gets a BM25 index.
+TEXT_SCHEMA = {"text_lemmatized": {"type": "string", "full_text_search": True}}
+
 
 class OutputData(BaseModel):
     id: Optional[str]
@@ -103,14 +106,17 @@ class TurbopufferDB(VectorStoreBase):
             self.namespace.write(
                 upsert_rows=rows,
                 distance_metric=self.distance_metric,
+                schema=TEXT_SCHEMA,
             )
 
-    def _parse_output(self, rows) -> List[OutputData]:
+    def _parse_output(self, rows, distance: bool = True) -> List[OutputData]:
         """
         Parse the output data from Turbopuffer query results.
 
         Args:
             rows: List of Row objects from Turbopuffer query.
+            distance (bool, optional): Whether ``$dist`` is a vector distance
+                (turned into a similarity) rather than a BM25 score. Defaults to True.
 
         Returns:
             List[OutputData]: Parsed output data.
@@ -122,7 +128,7 @@ class TurbopufferDB(VectorStoreBase):
             dist = row_dict.pop("$dist", None)
             row_dict.pop("vector", None)
 
-            score = 1 - dist if dist is not None else None
+            score = 1 - dist if dist is not None and distance else dist
 
             results.append(OutputData(
                 id=row_id,
@@ -184,6 +190,39 @@ class TurbopufferDB(VectorStoreBase):
         response = self.namespace.query(**query_params)
         return self._parse_output(response.rows or [])
 
+    def keyword_search(self, query: str, top_k: int = 5, filters: Optional[Dict] = None) -> Optional[List[OutputData]]:
+        """
+        Search for memories by keyword with Turbopuffer's BM25 full-text index.
+
+        Args:
+            query (str): The search query text (lemmatized).
+            top_k (int, optional): Number of results to return. Defaults to 5.
+            filters (dict, optional): Filters to apply to the search. Defaults to None.
+
+        Returns:
+            list: Search results with raw BM25 scores, or None if the namespace
+            has no full-text index (e.g. rows written before it was declared).
+        """
+        if not query or not query.strip():
+            return []
+
+        query_params = {
+            "rank_by": ("text_lemmatized", "BM25", query),
+            "top_k": top_k,
+            "include_attributes": True,
+        }
+
+        tpuf_filters = self._convert_filters(filters)
+        if tpuf_filters is not None:
+            query_params["filters"] = tpuf_filters
+
+        try:
+            response = self.namespace.query(**query_params)
+        except Exception as e:
+            logger.debug(f"Keyword search failed: {e}")
+            return None
+        return self._parse_output(response.rows or [], distance=False)
+
     def delete(self, vector_id: Union[str, int]):
         """
         Delete a vector by ID.
@@ -216,11 +255,12 @@ class TurbopufferDB(VectorStoreBase):
             self.namespace.write(
                 upsert_rows=[row],
                 distance_metric=self.distance_metric,
+                schema=TEXT_SCHEMA,
             )
         elif payload is not None:
             row = dict(payload)
             row["id"] = str(vector_id)
-            self.namespace.write(patch_rows=[row])
+            self.namespace.write(patch_rows=[row], schema=TEXT_SCHEMA)
 
     def get(self, vector_id: Union[str, int]) -> Optional[OutputData]:
         """
@@ -7,9 +7,11 @@ import numpy as np
 import pytz
 import valkey
 from pydantic import BaseModel
+from valkey.commands.search.query import Query
 from valkey.exceptions import ResponseError
 
 from mem0.memory.utils import extract_json
+from mem0.utils.scoring import bm25_terms
 from mem0.vector_stores.base import VectorStoreBase
 
 logger = logging.getLogger(__name__)
@@ -22,6 +24,7 @@ DEFAULT_FIELDS = [
     {"name": "run_id", "type": "tag"},
     {"name": "user_id", "type": "tag"},
     {"name": "memory", "type": "text"},  # TEXT for full-text search over memory content (see #5006)
+    {"name": "text_lemmatized", "type": "text"},  # TEXT for keyword (BM25) search
     {"name": "metadata", "type": "tag"},  # Using TAG instead of TEXT for Valkey compatibility
     {"name": "created_at", "type": "numeric"},
     {"name": "updated_at", "type": "numeric"},
@@ -183,6 +186,8 @@ class ValkeyDB(VectorStoreBase):
             "TAG",
             "memory",
             "TEXT",
+            "text_lemmatized",
+            "TEXT",
             "metadata",
             "TAG",
             "created_at",
@@ -313,6 +318,7 @@ class ValkeyDB(VectorStoreBase):
                     "memory_id": id,
                     "hash": payload.get("hash", f"hash_{id}"),  # Use a default hash if not provided
                     "memory": payload.get("data", f"data_{id}"),  # Use a default data if not provided
+                    "text_lemmatized": payload.get("text_lemmatized", ""),
                     "created_at": int(datetime.fromisoformat(payload["created_at"]).timestamp()),
                     "embedding": np.array(vector, dtype=np.float32).tobytes(),
                 }
@@ -389,20 +395,25 @@ class ValkeyDB(VectorStoreBase):
             logger.error(f"Search failed with query '{query}': {e}")
             raise
 
-    def _process_search_results(self, results):
+    def _process_search_results(self, results, text_scores=False):
         """
         Process search results into OutputData objects.
 
         Args:
             results: The search results from Valkey.
+            text_scores (bool, optional): Use the full-text score of each document
+                (WITHSCORES) instead of the vector distance. Defaults to False.
 
         Returns:
             list: List of OutputData objects.
         """
         memory_results = []
         for doc in results.docs:
-            raw_distance = float(doc.vector_score) if hasattr(doc, "vector_score") else None
-            score = max(0.0, 1.0 - raw_distance) if raw_distance is not None else None
+            if text_scores:
+                score = float(getattr(doc, "score", 1.0))
+            else:
+                raw_distance = float(doc.vector_score) if hasattr(doc, "vector_score") else None
+                score = max(0.0, 1.0 - raw_distance) if raw_distance is not None else None
 
             # Create the payload
             payload = {
@@ -472,6 +483,39 @@ class ValkeyDB(VectorStoreBase):
         # Process the results
         return self._process_search_results(results)
 
+    def keyword_search(self, query: str, top_k: int = 5, filters: dict = None):
+        """
+        Search for memories by keyword over the ``text_lemmatized`` TEXT field.
+
+        Args:
+            query (str): The search query text (lemmatized).
+            top_k (int, optional): Maximum number of results to return. Defaults to 5.
+            filters (dict, optional): Tag filters, as for search(). Defaults to None.
+
+        Returns:
+            list: List of OutputData objects scored by the engine's text scorer,
+                or None if the index has no ``text_lemmatized`` field (indexes
+                created before it was added).
+        """
+        terms = list(dict.fromkeys(bm25_terms(query)))
+        if not terms:
+            return []
+
+        filter_parts = [
+            f"@{key}:{{{self._escape_tag_value(value)}}}" for key, value in (filters or {}).items() if value is not None
+        ]
+        # Tokens are word characters only, so they need no escaping.
+        text_expr = f"@text_lemmatized:({' | '.join(terms)})"
+        q = Query(" ".join([*filter_parts, text_expr])).with_scores().paging(0, top_k)
+        logger.debug(f"Valkey keyword query: {q.query_string()}")
+
+        try:
+            results = self.client.ft(self.collection_name).search(q)
+        except ResponseError as e:
+            logger.debug(f"Keyword search failed: {e}")
+            return None
+        return self._process_search_results(results, text_scores=True)
+
     def delete(self, vector_id):
         """
         Delete a vector from the index.
@@ -513,6 +557,7 @@ class ValkeyDB(VectorStoreBase):
                 "memory_id": vector_id,
                 "hash": payload.get("hash", f"hash_{vector_id}"),  # Use a default hash if not provided
                 "memory": payload.get("data", f"data_{vector_id}"),  # Use a default data if not provided
+                "text_lemmatized": payload.get("text_lemmatized", ""),
                 "created_at": int(datetime.fromisoformat(payload["created_at"]).timestamp()),
             }
 
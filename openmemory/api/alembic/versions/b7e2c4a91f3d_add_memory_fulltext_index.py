@@ -0,0 +1,27 @@
+"""add_memory_fulltext_index
+
+Revision ID: b7e2c4a91f3d
+Revises: afd00efbd06b
+Create Date: 2026-10-17 10:00:00.000000
+
+"""
+from typing import Sequence, Union
+
+from alembic import op
+from app.utils.fulltext import create_fulltext_index, drop_fulltext_index
+
+# revision identifiers, used by Alembic.
+revision: str = 'b7e2c4a91f3d'
+down_revision: Union[str, None] = 'afd00efbd06b'
+branch_labels: Union[str, Sequence[str], None] = None
+depends_on: Union[str, Sequence[str], None] = None
+
+
+def upgrade() -> None:
+    """Index memory content for full-text search (FTS5 on SQLite, GIN on Postgres)."""
+    create_fulltext_index(op.get_bind())
+
+
+def downgrade() -> None:
+    """Drop the memory full-text index."""
+    drop_fulltext_index(op.get_bind())
@@ -0,0 +1,26 @@
+"""add_memory_user_id_index
+
+Revision ID: c3d9f0a6e2b8
+Revises: b7e2c4a91f3d
+Create Date: 2026-10-17 12:00:00.000000
+
+"""
+from typing import Sequence, Union
+
+from alembic import op
+
+# revision identifiers, used by Alembic.
+revision: str = 'c3d9f0a6e2b8'
+down_revision: Union[str, None] = 'b7e2c4a91f3d'
+branch_labels: Union[str, Sequence[str], None] = None
+depends_on: Union[str, Sequence[str], None] = None
+
+
+def upgrade() -> None:
+    """Index (user_id, id) so backup export pages through a user's memories in id order."""
+    op.create_index('idx_memory_user_id', 'memories', ['user_id', 'id'], unique=False)
+
+
+def downgrade() -> None:
+    """Drop the (user_id, id) memory index."""
+    op.drop_index('idx_memory_user_id', table_name='memories')
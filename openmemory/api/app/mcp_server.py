@@ -19,21 +19,34 @@ import contextvars
 import datetime
 import json
 import logging
+import os
 import uuid
 
 import anyio
 
 from app.database import SessionLocal
-from app.models import Memory, MemoryAccessLog, MemoryState, MemoryStatusHistory
+from app.models import (
+    Memory,
+    MemoryAccessLog,
+    MemoryState,
+    MemoryStatusHistory,
+    access_log_sink,
+)
 from app.utils.db import get_user_and_app
+from app.utils.mcp_sessions import ClientBusy, McpSessionRegistry
 from app.utils.memory import get_memory_client
-from app.utils.permissions import check_memory_access_permissions
+from app.utils.permissions import (
+    check_memory_access_permissions,
+    get_memory_permissions,
+    search_permitted_memories,
+    search_permitted_memories_batch,
+)
 from dotenv import load_dotenv
 from fastapi import FastAPI, Request
 from fastapi.routing import APIRouter
 from mcp.server.fastmcp import FastMCP
 from mcp.server.sse import SseServerTransport
-from mcp.server.streamable_http import StreamableHTTPServerTransport
+from mcp.server.streamable_http import MCP_SESSION_ID_HEADER, StreamableHTTPServerTransport
 from starlette.responses import Response
 
 # Load environment variables
@@ -61,6 +74,95 @@ mcp_router = APIRouter(prefix="/mcp")
 # Initialize SSE transport
 sse = SseServerTransport("/mcp/messages/")
 
+# Upper bound on items in one batch tool call, and on the LLM extractions an
+# inferring batch add runs at once when called with parallel=True
+MAX_BATCH_ITEMS = int(os.environ.get("MCP_MAX_BATCH_ITEMS", "50"))
+BATCH_ADD_CONCURRENCY = int(os.environ.get("MCP_BATCH_ADD_CONCURRENCY", "4"))
+
+# Persistent Streamable HTTP sessions, one long-lived server run each
+mcp_sessions = McpSessionRegistry(
+    lambda read_stream, write_stream: mcp._mcp_server.run(
+        read_stream, write_stream, mcp._mcp_server.create_initialization_options()
+    ),
+    idle_timeout=float(os.environ.get("MCP_SESSION_IDLE_TIMEOUT_SECONDS", "1800")),
+    max_sessions=int(os.environ.get("MCP_MAX_SESSIONS", "1000")),
+    max_sessions_per_client=int(os.environ.get("MCP_MAX_SESSIONS_PER_CLIENT", "8")),
+    max_concurrent_per_client=int(os.environ.get("MCP_MAX_CONCURRENT_PER_CLIENT", "8")),
+    queue_timeout=float(os.environ.get("MCP_CLIENT_QUEUE_TIMEOUT_SECONDS", "5")),
+)
+
+
+def _record_add_results(db, user, app, results) -> None:
+    """Mirror the ADD/DELETE events of a memory client ``add`` into the database."""
+    for result in results:
+        memory_id = uuid.UUID(result['id'])
+        memory = db.query(Memory).filter(Memory.id == memory_id).first()
+
+        if result['event'] == 'ADD':
+            if not memory:
+                memory = Memory(
+                    id=memory_id,
+                    user_id=user.id,
+                    app_id=app.id,
+                    content=result['memory'],
+                    state=MemoryState.active
+                )
+                db.add(memory)
+            else:
+                memory.state = MemoryState.active
+                memory.content = result['memory']
+
+            # Create history entry
+            history = MemoryStatusHistory(
+                memory_id=memory_id,
+                changed_by=user.id,
+                old_state=MemoryState.deleted if memory else None,
+                new_state=MemoryState.active
+            )
+            db.add(history)
+
+        elif result['event'] == 'DELETE':
+            if memory:
+                memory.state = MemoryState.deleted
+                memory.deleted_at = datetime.datetime.now(datetime.UTC)
+                # Create history entry
+                history = MemoryStatusHistory(
+                    memory_id=memory_id,
+                    changed_by=user.id,
+                    old_state=MemoryState.active,
+                    new_state=MemoryState.deleted
+                )
+                db.add(history)
+
+
+def _format_hits(hits) -> list:
+    results = []
+    for h in hits:
+        # All vector db search functions return OutputData class
+        id, score, payload = h.id, h.score, h.payload
+        results.append({
+            "id": id,
+            "memory": payload.get("data"),
+            "hash": payload.get("hash"),
+            "created_at": payload.get("created_at"),
+            "updated_at": payload.get("updated_at"),
+            "score": score,
+        })
+    return results
+
+
+def _log_search_access(app, query: str, results: list) -> None:
+    # Access logs go through the buffered sink; the read never waits on them.
+    for r in results:
+        if r.get("id"):
+            access_log_sink.record(
+                r["id"],
+                app.id,
+                "search",
+                {"query": query, "score": r.get("score"), "hash": r.get("hash")},
+            )
+
+
 @mcp.tool(description="Add a new memory. This method is called everytime the user informs anything about themselves, their preferences, or anything that has any relevant information which can be useful in the future conversation. This can also be called when the user asks you to remember something. Set infer to False to store the memory verbatim without LLM fact extraction.")
 async def add_memories(text: str, infer: bool = True) -> str:
     uid = user_id_var.get(None)
@@ -96,46 +198,7 @@ async def add_memories(text: str, infer: bool = True) -> str:
 
             # Process the response and update database
             if isinstance(response, dict) and 'results' in response:
-                for result in response['results']:
-                    memory_id = uuid.UUID(result['id'])
-                    memory = db.query(Memory).filter(Memory.id == memory_id).first()
-
-                    if result['event'] == 'ADD':
-                        if not memory:
-                            memory = Memory(
-                                id=memory_id,
-                                user_id=user.id,
-                                app_id=app.id,
-                                content=result['memory'],
-                                state=MemoryState.active
-                            )
-                            db.add(memory)
-                        else:
-                            memory.state = MemoryState.active
-                            memory.content = result['memory']
-
-                        # Create history entry
-                        history = MemoryStatusHistory(
-                            memory_id=memory_id,
-                            changed_by=user.id,
-                            old_state=MemoryState.deleted if memory else None,
-                            new_state=MemoryState.active
-                        )
-                        db.add(history)
-
-                    elif result['event'] == 'DELETE':
-                        if memory:
-                            memory.state = MemoryState.deleted
-                            memory.deleted_at = datetime.datetime.now(datetime.UTC)
-                            # Create history entry
-                            history = MemoryStatusHistory(
-                                memory_id=memory_id,
-                                changed_by=user.id,
-                                old_state=MemoryState.active,
-                                new_state=MemoryState.deleted
-                            )
-                            db.add(history)
-
+                _record_add_results(db, user, app, response['results'])
                 db.commit()
 
             return json.dumps(response)
@@ -166,9 +229,9 @@ async def search_memory(query: str) -> str:
             # Get or create user and app
             user, app = get_user_and_app(db, user_id=uid, app_id=client_name)
 
-            # Get accessible memory IDs based on ACL
-            user_memories = db.query(Memory).filter(Memory.user_id == user.id).all()
-            accessible_memory_ids = [memory.id for memory in user_memories if check_memory_access_permissions(db, memory, app.id)]
+            # The app's permission set is cached and applied inside the vector
+            # search, so the store returns permitted hits only.
+            permissions = get_memory_permissions(db, user.id, app.id)
 
             filters = {
                 "user_id": uid
@@ -176,52 +239,153 @@ async def search_memory(query: str) -> str:
 
             embeddings = memory_client.embedding_model.embed(query, "search")
 
-            hits = memory_client.vector_store.search(
-                query=query, 
-                vectors=embeddings, 
-                limit=10, 
+            hits = search_permitted_memories(
+                memory_client.vector_store,
+                query=query,
+                vectors=embeddings,
                 filters=filters,
+                permissions=permissions,
+                top_k=10,
             )
 
-            allowed = set(str(mid) for mid in accessible_memory_ids) if accessible_memory_ids else None
+            results = _format_hits(hits)
+            _log_search_access(app, query, results)
 
-            results = []
-            for h in hits:
-                # All vector db search functions return OutputData class
-                id, score, payload = h.id, h.score, h.payload
-                if allowed and (h.id is None or h.id not in allowed):
-                    continue
-                
-                results.append({
-                    "id": id, 
-                    "memory": payload.get("data"), 
-                    "hash": payload.get("hash"),
-                    "created_at": payload.get("created_at"), 
-                    "updated_at": payload.get("updated_at"), 
-                    "score": score,
-                })
-
-            for r in results: 
-                if r.get("id"): 
-                    access_log = MemoryAccessLog(
-                        memory_id=uuid.UUID(r["id"]),
-                        app_id=app.id,
-                        access_type="search",
-                        metadata_={
-                            "query": query,
-                            "score": r.get("score"),
-                            "hash": r.get("hash"),
-                        },
-                    )
-                    db.add(access_log)
+            return json.dumps({"results": results})
+        finally:
+            db.close()
+    except Exception as e:
+        logging.exception(e)
+        return f"Error searching memory: {e}"
+
+
+@mcp.tool(description="Add several memories in one call. Use this instead of repeated add_memories calls when a turn has more than one thing to remember. Returns one result per text, in order. Set infer to False to store the texts verbatim without LLM fact extraction. Set parallel to True only for unrelated texts: their extractions then run concurrently and do not see each other, so overlapping facts may be stored twice or conflict.")
+async def add_memories_batch(texts: list[str], infer: bool = True, parallel: bool = False) -> str:
+    uid = user_id_var.get(None)
+    client_name = client_name_var.get(None)
+    if not uid:
+        return "Error: user_id not provided"
+    if not client_name:
+        return "Error: client_name not provided"
+    if len(texts) > MAX_BATCH_ITEMS:
+        return f"Error: at most {MAX_BATCH_ITEMS} texts per batch"
+
+    # Get memory client safely
+    memory_client = get_memory_client_safe()
+    if not memory_client:
+        return "Error: Memory system is currently unavailable. Please try again later."
+
+    try:
+        db = SessionLocal()
+        try:
+            user, app = get_user_and_app(db, user_id=uid, app_id=client_name)
+            if not app.is_active:
+                return f"Error: App {app.name} is currently paused on OpenMemory. Cannot create new memories."
+
+            metadata = {"source_app": "openmemory", "mcp_client": client_name}
+            items = [{"index": i, "text": text} for i, text in enumerate(texts)]
+            if not infer:
+                # Verbatim texts go through one add call, which embeds them
+                # with a single embed_batch; each stored message maps back to
+                # its text in order.
+                stored = [item for item in items if item["text"].strip()]
+                if stored:
+                    response = await anyio.to_thread.run_sync(lambda: memory_client.add(
+                        [{"role": "user", "content": item["text"]} for item in stored],
+                        user_id=uid, metadata=metadata, infer=False,
+                    ))
+                    for item, result in zip(stored, response.get("results", [])):
+                        item["results"] = [result]
+            else:
+                # All texts share the user's scope, so by default they are
+                # extracted in order and each one dedups against what the
+                # previous ones stored, like repeated add_memories calls.
+                # parallel=True trades that for a bounded number of
+                # concurrent extractions.
+                limiter = anyio.CapacityLimiter(BATCH_ADD_CONCURRENCY)
+
+                async def add_one(item):
+                    try:
+                        response = await anyio.to_thread.run_sync(
+                            lambda: memory_client.add(item["text"], user_id=uid, metadata=metadata, infer=True),
+                            limiter=limiter,
+                        )
+                        item["results"] = response.get("results", [])
+                    except Exception as e:
+                        logging.warning(f"Batch add failed for item {item['index']}: {e}")
+                        item["error"] = str(e)
+
+                pending = [item for item in items if item["text"].strip()]
+                if parallel:
+                    async with anyio.create_task_group() as tg:
+                        for item in pending:
+                            tg.start_soon(add_one, item)
+                else:
+                    for item in pending:
+                        await add_one(item)
+
+            for item in items:
+                if "results" in item:
+                    _record_add_results(db, user, app, item["results"])
+                elif "error" not in item:
+                    item["results"] = []
             db.commit()
 
-            return json.dumps({"results": results}, indent=2)
+            return json.dumps({"results": items})
+        finally:
+            db.close()
+    except Exception as e:
+        logging.exception(f"Error adding memories batch: {e}")
+        return f"Error adding memories batch: {e}"
+
+
+@mcp.tool(description="Search stored memories for several queries in one call. Use this instead of repeated search_memory calls when a turn needs more than one lookup. Returns the results of each query, in order.")
+async def search_memories_batch(queries: list[str]) -> str:
+    uid = user_id_var.get(None)
+    client_name = client_name_var.get(None)
+    if not uid:
+        return "Error: user_id not provided"
+    if not client_name:
+        return "Error: client_name not provided"
+    if len(queries) > MAX_BATCH_ITEMS:
+        return f"Error: at most {MAX_BATCH_ITEMS} queries per batch"
+    if not queries:
+        return json.dumps({"results": []})
+
+    # Get memory client safely
+    memory_client = get_memory_client_safe()
+    if not memory_client:
+        return "Error: Memory system is currently unavailable. Please try again later."
+
+    try:
+        db = SessionLocal()
+        try:
+            user, app = get_user_and_app(db, user_id=uid, app_id=client_name)
+            permissions = get_memory_permissions(db, user.id, app.id)
+
+            # One embedding call and one batched vector query for all queries.
+            embeddings = memory_client.embedding_model.embed_batch(queries, "search")
+            hits_per_query = search_permitted_memories_batch(
+                memory_client.vector_store,
+                queries=queries,
+                vectors_list=embeddings,
+                filters={"user_id": uid},
+                permissions=permissions,
+                top_k=10,
+            )
+
+            results = []
+            for query, hits in zip(queries, hits_per_query):
+                formatted = _format_hits(hits)
+                _log_search_access(app, query, formatted)
+                results.append({"query": query, "results": formatted})
+
+            return json.dumps({"results": results})
         finally:
             db.close()
     except Exception as e:
         logging.exception(e)
-        return f"Error searching memory: {e}"
+        return f"Error searching memories batch: {e}"
 
 
 @mcp.tool(description="List all memories in the user's memory")
@@ -256,36 +420,16 @@ async def list_memories() -> str:
                     if 'id' in memory_data:
                         memory_id = uuid.UUID(memory_data['id'])
                         if memory_id in accessible_memory_ids:
-                            # Create access log entry
-                            access_log = MemoryAccessLog(
-                                memory_id=memory_id,
-                                app_id=app.id,
-                                access_type="list",
-                                metadata_={
-                                    "hash": memory_data.get('hash')
-                                }
-                            )
-                            db.add(access_log)
+                            access_log_sink.record(memory_id, app.id, "list", {"hash": memory_data.get('hash')})
                             filtered_memories.append(memory_data)
-                db.commit()
             else:
                 for memory in memories:
                     memory_id = uuid.UUID(memory['id'])
                     memory_obj = db.query(Memory).filter(Memory.id == memory_id).first()
                     if memory_obj and check_memory_access_permissions(db, memory_obj, app.id):
-                        # Create access log entry
-                        access_log = MemoryAccessLog(
-                            memory_id=memory_id,
-                            app_id=app.id,
-                            access_type="list",
-                            metadata_={
-                                "hash": memory.get('hash')
-                            }
-                        )
-                        db.add(access_log)
+                        access_log_sink.record(memory_id, app.id, "list", {"hash": memory.get('hash')})
                         filtered_memories.append(memory)
-                db.commit()
-            return json.dumps(filtered_memories, indent=2)
+            return json.dumps(filtered_memories)
         finally:
             db.close()
     except Exception as e:
@@ -493,13 +637,54 @@ async def handle_post_message(request: Request):
         pass
 
 
+def _is_initialize(body: bytes) -> bool:
+    try:
+        message = json.loads(body)
+    except ValueError:
+        return False
+    return isinstance(message, dict) and message.get("method") == "initialize"
+
+
+def _session_error(message: str, status_code: int) -> Response:
+    body = {"jsonrpc": "2.0", "id": "server-error", "error": {"code": -32600, "message": message}}
+    return Response(content=json.dumps(body), status_code=status_code, media_type="application/json")
+
+
+async def _run_stateless(scope, receive, send):
+    transport = StreamableHTTPServerTransport(
+        mcp_session_id=None,
+        is_json_response_enabled=True,
+    )
+
+    async with anyio.create_task_group() as tg:
+        async def run_server(*, task_status=anyio.TASK_STATUS_IGNORED):
+            async with transport.connect() as (read_stream, write_stream):
+                task_status.started()
+                await mcp._mcp_server.run(
+                    read_stream,
+                    write_stream,
+                    mcp._mcp_server.create_initialization_options(),
+                    stateless=True,
+                )
+
+        await tg.start(run_server)
+        await transport.handle_request(scope, receive, send)
+        await transport.terminate()
+        tg.cancel_scope.cancel()
+
+
 @mcp_router.api_route("/{client_name}/http/{user_id}", methods=["POST", "GET", "DELETE"])
 async def handle_streamable_http(request: Request):
     """Handle Streamable HTTP connections for a specific user and client.
 
     Uses the Streamable HTTP transport (MCP spec 2025-03-26+) which replaces
-    the deprecated SSE transport. Runs in stateless mode — each request is
-    handled independently with no persistent session.
+    the deprecated SSE transport. An ``initialize`` request without an
+    ``mcp-session-id`` header opens a persistent session (see
+    ``app.utils.mcp_sessions``) whose id is returned in that header; requests
+    carrying it are served by the session's long-lived server. Requests
+    without a session id are handled statelessly, each by its own server run.
+    Responses are JSON only, so GET (a server-to-client SSE stream) is
+    answered with 405.
 
     The transport writes its response directly to the ASGI ``send`` callable.
     We intercept it via ``capture_send`` so we can return a proper ``Response``
@@ -510,6 +695,7 @@ async def handle_streamable_http(request: Request):
     user_token = user_id_var.set(uid or "")
     client_name = request.path_params.get("client_name")
     client_token = client_name_var.set(client_name or "")
+    client = (client_name or "", uid or "")
 
     # Intercept the ASGI messages the transport sends so we can return them
     # as a single Response to FastAPI.  Without this, FastAPI would attempt to
@@ -529,27 +715,34 @@ async def handle_streamable_http(request: Request):
             response_body.extend(message.get("body", b""))
 
     try:
-        transport = StreamableHTTPServerTransport(
-            mcp_session_id=None,
-            is_json_response_enabled=True,
-        )
-
-        async with anyio.create_task_group() as tg:
-
-            async def run_server(*, task_status=anyio.TASK_STATUS_IGNORED):
-                async with transport.connect() as (read_stream, write_stream):
-                    task_status.started()
-                    await mcp._mcp_server.run(
-                        read_stream,
-                        write_stream,
-                        mcp._mcp_server.create_initialization_options(),
-                        stateless=True,
-                    )
-
-            await tg.start(run_server)
-            await transport.handle_request(request.scope, request.receive, capture_send)
-            await transport.terminate()
-            tg.cancel_scope.cancel()
+        session_id = request.headers.get(MCP_SESSION_ID_HEADER)
+        if session_id is not None:
+            session = mcp_sessions.get(session_id, client)
+            if session is None:
+                # Unknown, expired or another client's session: the client
+                # must initialize again (MCP spec).
+                return _session_error("Session not found", 404)
+            if request.method == "GET":
+                return Response(status_code=405, headers={"Allow": "POST, DELETE"})
+            await mcp_sessions.handle(session, request.scope, request.receive, capture_send)
+        else:
+            body = await request.body()
+
+            async def receive():
+                return {"type": "http.request", "body": body, "more_body": False}
+
+            session = None
+            if request.method == "POST" and _is_initialize(body):
+                session = await mcp_sessions.open(client)
+            if session is not None:
+                await mcp_sessions.handle(session, request.scope, receive, capture_send)
+                if response_status >= 400:
+                    await mcp_sessions.discard(session)
+            else:
+                async with mcp_sessions.slot(client):
+                    await _run_stateless(request.scope, receive, capture_send)
+    except ClientBusy:
+        return _session_error("Too many concurrent requests from this client", 429)
     finally:
         user_id_var.reset(user_token)
         client_name_var.reset(client_token)
@@ -557,8 +750,9 @@ async def handle_streamable_http(request: Request):
     if not response_started:
         return Response(status_code=500, content=b"Transport did not produce a response")
 
-    # Header dict conversion is safe here: the MCP transport in stateless JSON
-    # mode only emits single-valued headers (Content-Type, Content-Length).
+    # Header dict conversion is safe here: the MCP transport in JSON response
+    # mode only emits single-valued headers (Content-Type, Content-Length,
+    # mcp-session-id).
     return Response(
         content=bytes(response_body),
         status_code=response_status,
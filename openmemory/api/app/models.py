@@ -1,10 +1,14 @@
 import datetime
 import enum
+import os
 import uuid
 
 import sqlalchemy as sa
-from app.database import Base
-from app.utils.categorization import get_categories_for_memory
+from app.database import Base, SessionLocal
+from app.utils import commit_hooks
+from app.utils.access_log import AccessLogSink
+from app.utils.categorization import get_categories_for_memories
+from app.utils.categorization_queue import CategorizationQueue
 from sqlalchemy import (
     JSON,
     UUID,
@@ -106,6 +110,8 @@ class Memory(Base):
         Index('idx_memory_user_state', 'user_id', 'state'),
         Index('idx_memory_app_state', 'app_id', 'state'),
         Index('idx_memory_user_app', 'user_id', 'app_id'),
+        # Keyset pagination over one user's memories (backup export).
+        Index('idx_memory_user_id', 'user_id', 'id'),
     )
 
 
@@ -187,57 +193,110 @@ class MemoryAccessLog(Base):
         Index('idx_access_app_time', 'app_id', 'accessed_at'),
     )
 
-def categorize_memory(memory: Memory, db: Session) -> None:
-    """Categorize a memory using OpenAI and store the categories in the database."""
+def write_memory_categories(assignments: dict) -> None:
+    """Attach categories to memories, creating missing categories. Takes {memory_id: [category names]}."""
+    db = SessionLocal()
     try:
-        # Get categories from OpenAI
-        categories = get_categories_for_memory(memory.content)
-
-        # Get or create categories in the database
-        for category_name in categories:
-            category = db.query(Category).filter(Category.name == category_name).first()
-            if not category:
-                category = Category(
-                    name=category_name,
-                    description=f"Automatically created category for {category_name}"
-                )
-                db.add(category)
-                db.flush()  # Flush to get the category ID
-
-            # Check if the memory-category association already exists
-            existing = db.execute(
-                memory_categories.select().where(
-                    (memory_categories.c.memory_id == memory.id) &
-                    (memory_categories.c.category_id == category.id)
-                )
-            ).first()
-
-            if not existing:
-                # Create the association
-                db.execute(
-                    memory_categories.insert().values(
-                        memory_id=memory.id,
-                        category_id=category.id
-                    )
-                )
-
+        # Memories deleted while they waited in the queue are skipped.
+        memory_ids = set(db.scalars(sa.select(Memory.id).where(Memory.id.in_(list(assignments)))))
+        names = {name for memory_id, cats in assignments.items() if memory_id in memory_ids for name in cats}
+        if not names:
+            return
+        categories = {c.name: c for c in db.query(Category).filter(Category.name.in_(names))}
+        for name in names - categories.keys():
+            category = Category(name=name, description=f"Automatically created category for {name}")
+            db.add(category)
+            categories[name] = category
+        db.flush()
+
+        linked = set(
+            db.execute(
+                sa.select(memory_categories.c.memory_id, memory_categories.c.category_id)
+                .where(memory_categories.c.memory_id.in_(memory_ids))
+            ).all()
+        )
+        rows = []
+        for memory_id in memory_ids:
+            for name in set(assignments[memory_id]):
+                pair = (memory_id, categories[name].id)
+                if pair not in linked:
+                    linked.add(pair)
+                    rows.append({"memory_id": memory_id, "category_id": categories[name].id})
+        if rows:
+            db.execute(memory_categories.insert(), rows)
         db.commit()
-    except Exception as e:
+    except Exception:
         db.rollback()
-        print(f"Error categorizing memory: {e}")
+        raise
+    finally:
+        db.close()
+
+
+categorization_queue = CategorizationQueue(
+    categorize=get_categories_for_memories,
+    write=write_memory_categories,
+    batch_size=int(os.getenv("CATEGORIZATION_BATCH_SIZE", "20")),
+    max_wait=float(os.getenv("CATEGORIZATION_MAX_WAIT_SECONDS", "1.0")),
+)
+
+_PENDING_CATEGORIZATION = "pending_categorization"
+
+
+def _enqueue_categorizations(pending: dict) -> None:
+    for memory_id, content in pending.items():
+        categorization_queue.enqueue(memory_id, content)
+
+
+# Queue only once the row is committed, so the worker can see it and a
+# rolled-back insert is never categorized.
+commit_hooks.register(_PENDING_CATEGORIZATION, dict, _enqueue_categorizations)
+
+
+def _defer_categorization(target: Memory) -> None:
+    def add(pending: dict) -> None:
+        pending[target.id] = target.content
+
+    commit_hooks.defer(target, _PENDING_CATEGORIZATION, add)
+
+
+def skip_categorization(session: Session, memory_ids) -> None:
+    """Drop memories flushed in ``session`` from categorization, e.g. restored ones that carry their categories."""
+    pending = commit_hooks.pending(session, _PENDING_CATEGORIZATION)
+    if pending:
+        for memory_id in memory_ids:
+            pending.pop(memory_id, None)
 
 
 @event.listens_for(Memory, 'after_insert')
 def after_memory_insert(mapper, connection, target):
-    """Trigger categorization after a memory is inserted."""
-    db = Session(bind=connection)
-    categorize_memory(target, db)
-    db.close()
+    """Queue categorization for a new memory."""
+    _defer_categorization(target)
 
 
 @event.listens_for(Memory, 'after_update')
 def after_memory_update(mapper, connection, target):
-    """Trigger categorization after a memory is updated."""
-    db = Session(bind=connection)
-    categorize_memory(target, db)
-    db.close()
+    """Queue re-categorization when a memory's content changes (not on state changes)."""
+    if sa.inspect(target).attrs.content.history.has_changes():
+        _defer_categorization(target)
+
+
+def write_access_logs(rows: list) -> None:
+    """Insert access-log rows (dicts keyed by column name) in one multi-row statement."""
+    db = SessionLocal()
+    try:
+        db.execute(MemoryAccessLog.__table__.insert(), rows)
+        db.commit()
+    except Exception:
+        db.rollback()
+        raise
+    finally:
+        db.close()
+
+
+access_log_sink = AccessLogSink(
+    write=write_access_logs,
+    max_queue=int(os.getenv("ACCESS_LOG_MAX_QUEUE", "50000")),
+    batch_size=int(os.getenv("ACCESS_LOG_BATCH_SIZE", "500")),
+    flush_interval=float(os.getenv("ACCESS_LOG_FLUSH_INTERVAL_SECONDS", "1.0")),
+    overflow=os.getenv("ACCESS_LOG_OVERFLOW", "drop_newest"),
+)
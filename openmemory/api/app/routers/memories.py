@@ -1,11 +1,11 @@
 import logging
+import os
 from datetime import UTC, datetime
-from typing import List, Optional, Set
+from typing import List, Optional
 from uuid import UUID
 
 from app.database import get_db
 from app.models import (
-    AccessControl,
     App,
     Category,
     Memory,
@@ -16,7 +16,9 @@ from app.models import (
 )
 from app.schemas import MemoryResponse
 from app.utils.memory import get_memory_client
-from app.utils.permissions import check_memory_access_permissions
+from app.utils.fulltext import memory_content_matches
+from app.utils.permissions import memory_access_predicate
+from app.utils.related import find_neighbours, rank_related
 from fastapi import APIRouter, Depends, HTTPException, Query
 from fastapi_pagination import Page, Params
 from fastapi_pagination.ext.sqlalchemy import paginate as sqlalchemy_paginate
@@ -26,6 +28,9 @@ from sqlalchemy.orm import Session, joinedload
 
 router = APIRouter(prefix="/api/v1/memories", tags=["memories"])
 
+# Nearest neighbours fetched (and cached) per memory for vector-mode related memories.
+RELATED_MEMORIES_CANDIDATES = int(os.getenv("RELATED_MEMORIES_CANDIDATES", "50"))
+
 
 def get_memory_or_404(db: Session, memory_id: UUID) -> Memory:
     memory = db.query(Memory).filter(Memory.id == memory_id).first()
@@ -57,46 +62,6 @@ def update_memory_state(db: Session, memory_id: UUID, new_state: MemoryState, us
     return memory
 
 
-def get_accessible_memory_ids(db: Session, app_id: UUID) -> Set[UUID]:
-    """
-    Get the set of memory IDs that the app has access to based on app-level ACL rules.
-    Returns all memory IDs if no specific restrictions are found.
-    """
-    # Get app-level access controls
-    app_access = db.query(AccessControl).filter(
-        AccessControl.subject_type == "app",
-        AccessControl.subject_id == app_id,
-        AccessControl.object_type == "memory"
-    ).all()
-
-    # If no app-level rules exist, return None to indicate all memories are accessible
-    if not app_access:
-        return None
-
-    # Initialize sets for allowed and denied memory IDs
-    allowed_memory_ids = set()
-    denied_memory_ids = set()
-
-    # Process app-level rules
-    for rule in app_access:
-        if rule.effect == "allow":
-            if rule.object_id:  # Specific memory access
-                allowed_memory_ids.add(rule.object_id)
-            else:  # All memories access
-                return None  # All memories allowed
-        elif rule.effect == "deny":
-            if rule.object_id:  # Specific memory denied
-                denied_memory_ids.add(rule.object_id)
-            else:  # All memories denied
-                return set()  # No memories accessible
-
-    # Remove denied memories from allowed set
-    if allowed_memory_ids:
-        allowed_memory_ids -= denied_memory_ids
-
-    return allowed_memory_ids
-
-
 # List all memories with filtering
 @router.get("/", response_model=Page[MemoryResponse])
 async def list_memories(
@@ -128,9 +93,12 @@ async def list_memories(
         Memory.user_id == user.id,
         Memory.state != MemoryState.deleted,
         Memory.state != MemoryState.archived,
-        Memory.content.ilike(f"%{search_query}%") if search_query else True
+        memory_access_predicate(app_id),
     )
 
+    if search_query:
+        query = query.filter(memory_content_matches(db, search_query))
+
     # Apply filters
     if app_id:
         query = query.filter(Memory.app_id == app_id)
@@ -180,7 +148,6 @@ async def list_memories(
                 metadata_=memory.metadata_
             )
             for memory in items
-            if check_memory_access_permissions(db, memory, app_id)
         ]
     )
 
@@ -563,7 +530,7 @@ async def filter_memories(
 
     # Apply search filter
     if request.search_query:
-        query = query.filter(Memory.content.ilike(f"%{request.search_query}%"))
+        query = query.filter(memory_content_matches(db, request.search_query))
 
     # Apply app filter
     if request.app_ids:
@@ -641,6 +608,12 @@ async def get_related_memories(
     memory_id: UUID,
     user_id: str,
     params: Params = Depends(),
+    mode: str = Query(
+        "category", description="Relatedness: shared categories (category) or embedding similarity (vector)"
+    ),
+    category_weight: float = Query(
+        0.0, ge=0.0, le=1.0, description="In vector mode, weight of category overlap blended into similarity"
+    ),
     db: Session = Depends(get_db)
 ):
     # Validate user
@@ -650,6 +623,11 @@ async def get_related_memories(
     
     # Get the source memory
     memory = get_memory_or_404(db, memory_id)
+
+    if mode == "vector":
+        return _related_by_similarity(db, user, memory, params, category_weight)
+    if mode != "category":
+        raise HTTPException(status_code=400, detail="Invalid mode, expected 'category' or 'vector'")
     
     # Extract category IDs from the source memory
     category_ids = [category.id for category in memory.categories]
@@ -691,4 +669,48 @@ async def get_related_memories(
             )
             for memory in items
         ]
-    )
\ No newline at end of file
+    )
+
+
+def _related_by_similarity(db: Session, user: User, memory: Memory, params: Params, category_weight: float):
+    try:
+        memory_client = get_memory_client()
+        if not memory_client:
+            raise HTTPException(status_code=503, detail="Memory client is not available")
+    except HTTPException:
+        raise
+    except Exception as client_error:
+        logging.error(f"Memory client initialization failed: {client_error}")
+        raise HTTPException(status_code=503, detail=f"Memory service unavailable: {str(client_error)}")
+
+    # Neighbour lists are cached until the user's memories change.
+    neighbours = find_neighbours(memory_client, memory, user.user_id, RELATED_MEMORIES_CANDIDATES)
+    similarities = dict(neighbours)
+    candidates = db.query(Memory).filter(
+        Memory.id.in_([UUID(mid) for mid in similarities]),
+        Memory.user_id == user.id,
+        Memory.state != MemoryState.deleted
+    ).options(
+        joinedload(Memory.categories),
+        joinedload(Memory.app)
+    ).all()
+
+    ranked = rank_related(memory, candidates, similarities, category_weight)
+    start = (params.page - 1) * params.size
+    return Page.create(
+        [
+            MemoryResponse(
+                id=related.id,
+                content=related.content,
+                created_at=related.created_at,
+                state=related.state.value,
+                app_id=related.app_id,
+                app_name=related.app.name if related.app else None,
+                categories=[category.name for category in related.categories],
+                metadata_=related.metadata_
+            )
+            for related in ranked[start:start + params.size]
+        ],
+        total=len(ranked),
+        params=params,
+    )
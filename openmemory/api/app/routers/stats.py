@@ -1,5 +1,7 @@
 from app.database import get_db
-from app.models import App, Memory, MemoryState, User
+from app.mcp_server import mcp_sessions
+from app.models import App, Memory, MemoryState, User, access_log_sink, categorization_queue
+from app.utils.memory import memory_client_pool
 from fastapi import APIRouter, Depends, HTTPException
 from sqlalchemy.orm import Session
 
@@ -27,3 +29,27 @@ async def get_profile(
         "apps": apps.all()
     }
 
+
+
+@router.get("/categorization")
+async def get_categorization_stats():
+    """Depth, lag and dedup counters of the background categorization queue."""
+    return categorization_queue.stats()
+
+
+@router.get("/access-log")
+async def get_access_log_stats():
+    """Buffer depth and write/drop counters of the batched access-log sink."""
+    return access_log_sink.stats()
+
+
+@router.get("/memory-client")
+async def get_memory_client_stats():
+    """Readiness, startup time and last build/warmup timings of the memory client pool."""
+    return memory_client_pool.stats()
+
+
+@router.get("/mcp-sessions")
+async def get_mcp_session_stats():
+    """Open sessions, requests in flight, and eviction/rejection counters of the MCP session registry."""
+    return mcp_sessions.stats()
@@ -0,0 +1,148 @@
+"""Buffered, batched writes of memory access logs.
+
+Read tools record one access-log row per returned memory. Writing those rows
+inside the request transaction made logging the dominant database load under
+agent traffic, so reads only append events to an in-memory buffer here and a
+single worker thread flushes it with one multi-row insert per batch, either
+when ``batch_size`` events are waiting or every ``flush_interval`` seconds.
+
+Recording never blocks. When the buffer is full the overflow policy decides
+what is lost: ``drop_newest`` (default) rejects the incoming event,
+``drop_oldest`` evicts the oldest buffered one to make room.
+"""
+
+import datetime
+import logging
+import threading
+import uuid
+from collections import deque
+from typing import Any, Callable, Dict, List, Optional
+
+logger = logging.getLogger(__name__)
+
+OVERFLOW_POLICIES = ("drop_newest", "drop_oldest")
+
+
+class AccessLogSink:
+    """Collect access-log events and insert them in bulk from a background thread.
+
+    ``write`` receives a list of row dicts keyed by ``memory_access_logs``
+    column names and runs on the worker thread.
+    """
+
+    def __init__(
+        self,
+        write: Callable[[List[Dict[str, Any]]], None],
+        max_queue: int = 50_000,
+        batch_size: int = 500,
+        flush_interval: float = 1.0,
+        overflow: str = "drop_newest",
+    ):
+        if overflow not in OVERFLOW_POLICIES:
+            raise ValueError(f"Unknown access log overflow policy {overflow!r}; expected one of {OVERFLOW_POLICIES}")
+        self._write = write
+        self.max_queue = max_queue
+        self.batch_size = batch_size
+        self.flush_interval = flush_interval
+        self.overflow = overflow
+
+        self._cond = threading.Condition()
+        self._buffer: deque = deque()
+        self._in_flight = 0
+        self._flush_requested = False
+        self._thread: Optional[threading.Thread] = None
+
+        self._recorded = 0
+        self._written = 0
+        self._dropped = 0
+        self._failed = 0
+        self._batches = 0
+
+    def record(self, memory_id, app_id, access_type: str, metadata: Optional[Dict[str, Any]] = None) -> bool:
+        """Buffer one access event. Never blocks; returns False if the event was dropped."""
+        row = {
+            "id": uuid.uuid4(),
+            "memory_id": memory_id if isinstance(memory_id, uuid.UUID) else uuid.UUID(str(memory_id)),
+            "app_id": app_id,
+            # Stamped here rather than by the column default so batching does not shift it.
+            "accessed_at": datetime.datetime.now(datetime.UTC),
+            "access_type": access_type,
+            "metadata": metadata or {},
+        }
+        with self._cond:
+            self._recorded += 1
+            if len(self._buffer) >= self.max_queue:
+                self._dropped += 1
+                if self.overflow == "drop_newest":
+                    return False
+                self._buffer.popleft()
+            self._buffer.append(row)
+            self._ensure_started()
+            if len(self._buffer) >= self.batch_size:
+                self._cond.notify_all()
+        return True
+
+    def flush(self, timeout: float = 5.0) -> bool:
+        """Wait until everything buffered so far has been written (or failed). Returns False on timeout."""
+        with self._cond:
+            self._flush_requested = True
+            self._cond.notify_all()
+            return self._cond.wait_for(lambda: not self._buffer and self._in_flight == 0, timeout)
+
+    def stats(self) -> Dict[str, Any]:
+        with self._cond:
+            return {
+                "queued": len(self._buffer),
+                "in_flight": self._in_flight,
+                "recorded": self._recorded,
+                "written": self._written,
+                "batches": self._batches,
+                "dropped": self._dropped,
+                "failed": self._failed,
+                "overflow": self.overflow,
+            }
+
+    def _ensure_started(self) -> None:
+        if self._thread is None:
+            self._thread = threading.Thread(target=self._run, name="access-log-sink", daemon=True)
+            self._thread.start()
+
+    def _run(self) -> None:
+        while True:
+            with self._cond:
+                self._cond.wait_for(lambda: self._buffer)
+                # Give the batch up to flush_interval to fill; flush() cuts the wait short.
+                self._cond.wait_for(
+                    lambda: len(self._buffer) >= self.batch_size or self._flush_requested, self.flush_interval
+                )
+                batch = [self._buffer.popleft() for _ in range(min(self.batch_size, len(self._buffer)))]
+                if not self._buffer:
+                    self._flush_requested = False
+                self._in_flight += len(batch)
+            try:
+                failed = self._write_batch(batch)
+            finally:
+                with self._cond:
+                    self._in_flight -= len(batch)
+                    self._batches += 1
+                    self._written += len(batch) - failed
+                    self._failed += failed
+                    self._cond.notify_all()
+
+    def _write_batch(self, batch: List[Dict[str, Any]]) -> int:
+        try:
+            self._write(batch)
+            return 0
+        except Exception:
+            # One bad row (e.g. a vector hit with no memory row) must not lose
+            # the whole batch: retry row by row and count what still fails.
+            logger.warning("Access log batch of %d failed, retrying rows individually", len(batch))
+        failed = 0
+        for row in batch:
+            try:
+                self._write([row])
+            except Exception:
+                failed += 1
+        if failed:
+            logger.warning("Dropped %d access log rows that could not be written", failed)
+        return failed
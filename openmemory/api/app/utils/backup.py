@@ -0,0 +1,569 @@
+"""Streaming backup export and batched import.
+
+Exports stream a zip to the client while it is being built, so memory use
+does not grow with the number of memories:
+
+- ``manifest.json``: format version, user, apps, categories, access controls
+- ``memories.jsonl``: one memory per line; with ``include_vectors`` the
+  stored embedding rides along as base64 float32 so a restore into the same
+  embedding model does not re-embed
+- ``status_history.jsonl``: one state transition per line
+
+Imports read the uploaded zip from its spooled temporary file and process
+memories in batches: one existence query, one commit and one vector store
+insert per batch. Version 1 backups (a single ``memories.json``) are still
+accepted.
+"""
+
+import base64
+import json
+import logging
+import os
+import sys
+import time
+import zipfile
+from array import array
+from datetime import UTC, datetime
+from itertools import islice
+from typing import Any, Callable, Dict, Iterable, Iterator, List, NamedTuple, Optional, Tuple
+from uuid import UUID, uuid4
+
+from app.models import (
+    AccessControl,
+    App,
+    Category,
+    Memory,
+    MemoryState,
+    MemoryStatusHistory,
+    User,
+    memory_categories,
+    skip_categorization,
+)
+from app.utils.vectors import fetch_stored_vectors
+from sqlalchemy.orm import Session, selectinload
+
+BACKUP_FORMAT_VERSION = "2"
+# Memories per export query / import transaction.
+BACKUP_BATCH_SIZE = int(os.getenv("BACKUP_BATCH_SIZE", "1000"))
+# Bytes buffered before a chunk of the export zip is sent.
+EXPORT_CHUNK_SIZE = 1 << 20
+
+
+class ExportOptions(NamedTuple):
+    app_id: Optional[UUID] = None
+    from_date: Optional[int] = None
+    to_date: Optional[int] = None
+    include_vectors: bool = True
+
+
+def _iso(dt: Optional[datetime]) -> Optional[str]: 
+    if isinstance(dt, datetime): 
+        try: 
+            return dt.astimezone(UTC).isoformat()
+        except: 
+            return dt.replace(tzinfo=UTC).isoformat()
+    return None
+
+def _parse_iso(dt: Optional[str]) -> Optional[datetime]:
+    if not dt:
+        return None
+    try:
+        return datetime.fromisoformat(dt)
+    except Exception:
+        try:
+            return datetime.fromisoformat(dt.replace("Z", "+00:00"))
+        except Exception:
+            return None
+
+
+def _encode_vector(vector: List[float]) -> str:
+    packed = array("f", vector)
+    if sys.byteorder != "little":
+        packed.byteswap()
+    return base64.b64encode(packed.tobytes()).decode("ascii")
+
+
+def _decode_vector(encoded: str) -> List[float]:
+    packed = array("f")
+    packed.frombytes(base64.b64decode(encoded))
+    if sys.byteorder != "little":
+        packed.byteswap()
+    return packed.tolist()
+
+
+def batched(items: Iterable, size: int) -> Iterator[list]:
+    iterator = iter(items)
+    while batch := list(islice(iterator, size)):
+        yield batch
+
+
+# ---------------------------------------------------------------------------
+# Export
+# ---------------------------------------------------------------------------
+
+def _memory_filters(user: User, req: ExportOptions) -> list:
+    filters = [Memory.user_id == user.id]
+    if req.from_date:
+        filters.append(Memory.created_at >= datetime.fromtimestamp(req.from_date, tz=UTC))
+    if req.to_date:
+        filters.append(Memory.created_at <= datetime.fromtimestamp(req.to_date, tz=UTC))
+    if req.app_id:
+        filters.append(Memory.app_id == req.app_id)
+    return filters
+
+
+def _manifest(db: Session, user: User, req: ExportOptions, filters: list) -> Dict[str, Any]:
+    app_ids = [row[0] for row in db.query(Memory.app_id).filter(*filters).distinct() if row[0]]
+    apps = db.query(App).filter(App.id.in_(app_ids)).order_by(App.id).all() if app_ids else []
+    cats = (
+        db.query(Category)
+        .join(memory_categories, memory_categories.c.category_id == Category.id)
+        .join(Memory, Memory.id == memory_categories.c.memory_id)
+        .filter(*filters)
+        .distinct()
+        .order_by(Category.id)
+        .all()
+    )
+    acls = db.query(AccessControl).filter(
+        AccessControl.subject_type == "app",
+        AccessControl.subject_id.in_(app_ids)
+    ).all() if app_ids else []
+
+    return {
+        "version": BACKUP_FORMAT_VERSION,
+        "user": {
+            "id": str(user.id), 
+            "user_id": user.user_id, 
+            "name": user.name, 
+            "email": user.email, 
+            "metadata": user.metadata_, 
+            "created_at": _iso(user.created_at), 
+            "updated_at": _iso(user.updated_at)
+        }, 
+        "apps": [
+            {
+                "id": str(a.id), 
+                "owner_id": str(a.owner_id), 
+                "name": a.name, 
+                "description": a.description, 
+                "metadata": a.metadata_, 
+                "is_active": a.is_active, 
+                "created_at": _iso(a.created_at), 
+                "updated_at": _iso(a.updated_at),
+            }
+            for a in apps
+        ], 
+        "categories": [
+            {
+                "id": str(c.id), 
+                "name": c.name, 
+                "description": c.description, 
+                "created_at": _iso(c.created_at), 
+                "updated_at": _iso(c.updated_at), 
+            }
+            for c in cats
+        ], 
+        "access_controls": [
+            {
+                "id": str(ac.id), 
+                "subject_type": ac.subject_type, 
+                "subject_id": str(ac.subject_id) if ac.subject_id else None, 
+                "object_type": ac.object_type, 
+                "object_id": str(ac.object_id) if ac.object_id else None, 
+                "effect": ac.effect, 
+                "created_at": _iso(ac.created_at), 
+            }
+            for ac in acls
+        ], 
+        "export_meta": {
+            "app_id_filter": str(req.app_id) if req.app_id else None,
+            "from_date": req.from_date,
+            "to_date": req.to_date,
+            "include_vectors": req.include_vectors,
+            "version": BACKUP_FORMAT_VERSION,
+            "generated_at": datetime.now(UTC).isoformat(),
+        },
+    }
+
+
+def _iter_memory_batches(db: Session, filters: list) -> Iterator[List[Memory]]:
+    """Keyset-paginate the exported memories so no query holds more than one batch."""
+    last_id = None
+    while True:
+        query = db.query(Memory).options(selectinload(Memory.categories)).filter(*filters)
+        if last_id is not None:
+            query = query.filter(Memory.id > last_id)
+        batch = query.order_by(Memory.id).limit(BACKUP_BATCH_SIZE).all()
+        if not batch:
+            return
+        yield batch
+        last_id = batch[-1].id
+        # Keep the identity map from growing with the export.
+        db.expunge_all()
+
+
+def _iter_history_batches(db: Session, filters: list) -> Iterator[List[MemoryStatusHistory]]:
+    last_id = None
+    while True:
+        query = db.query(MemoryStatusHistory).join(Memory, Memory.id == MemoryStatusHistory.memory_id).filter(*filters)
+        if last_id is not None:
+            query = query.filter(MemoryStatusHistory.id > last_id)
+        batch = query.order_by(MemoryStatusHistory.id).limit(BACKUP_BATCH_SIZE).all()
+        if not batch:
+            return
+        yield batch
+        last_id = batch[-1].id
+        db.expunge_all()
+
+
+def _memory_record(m: Memory, app_names: Dict[UUID, str], vector: Optional[List[float]]) -> Dict[str, Any]:
+    record = {
+        "id": str(m.id), 
+        "user_id": str(m.user_id), 
+        "app_id": str(m.app_id) if m.app_id else None, 
+        "app": app_names.get(m.app_id),
+        "content": m.content, 
+        "metadata": m.metadata_, 
+        "state": m.state.value,
+        "created_at": _iso(m.created_at), 
+        "updated_at": _iso(m.updated_at), 
+        "archived_at": _iso(m.archived_at), 
+        "deleted_at": _iso(m.deleted_at), 
+        "category_ids": [str(c.id) for c in m.categories],
+        "categories": [c.name for c in m.categories],
+    }
+    if vector is not None:
+        record["embedding"] = _encode_vector(vector)
+    return record
+
+
+class ChunkSink:
+    """Write-only, unseekable file object that collects zip output for streaming."""
+
+    def __init__(self):
+        self._chunks: List[bytes] = []
+        self.size = 0
+
+    def write(self, data) -> int:
+        self._chunks.append(bytes(data))
+        self.size += len(data)
+        return len(data)
+
+    def flush(self) -> None:
+        pass
+
+    def drain(self) -> bytes:
+        data = b"".join(self._chunks)
+        self._chunks.clear()
+        self.size = 0
+        return data
+
+
+def stream_export(
+    session_factory: Callable[[], Session], user_pk: UUID, req: ExportOptions, vector_store=None
+) -> Iterator[bytes]:
+    """Yield the backup zip in chunks of about ``EXPORT_CHUNK_SIZE`` bytes.
+
+    Reads through its own session: the request session is closed once the
+    response starts streaming. Embeddings are included when
+    ``req.include_vectors`` is set and ``vector_store`` can return them.
+    """
+    db = session_factory()
+    try:
+        user = db.get(User, user_pk)
+        filters = _memory_filters(user, req)
+        manifest = _manifest(db, user, req, filters)
+        app_names = {UUID(a["id"]): a["name"] for a in manifest["apps"]}
+        if not req.include_vectors:
+            vector_store = None
+
+        started = time.perf_counter()
+        exported = 0
+        sink = ChunkSink()
+        with zipfile.ZipFile(sink, "w", compression=zipfile.ZIP_DEFLATED) as zf:
+            zf.writestr("manifest.json", json.dumps(manifest))
+
+            with zf.open("memories.jsonl", "w", force_zip64=True) as out:
+                for batch in _iter_memory_batches(db, filters):
+                    vectors = {}
+                    if vector_store is not None:
+                        try:
+                            vectors = fetch_stored_vectors(vector_store, [str(m.id) for m in batch])
+                        except Exception as e:
+                            # The zip is already half sent; finish it without embeddings.
+                            logging.warning(f"Exporting remaining memories without embeddings: {e}")
+                            vector_store = None
+                    for m in batch:
+                        out.write((json.dumps(_memory_record(m, app_names, vectors.get(str(m.id)))) + "\n").encode())
+                    exported += len(batch)
+                    if sink.size >= EXPORT_CHUNK_SIZE:
+                        yield sink.drain()
+
+            with zf.open("status_history.jsonl", "w", force_zip64=True) as out:
+                for batch in _iter_history_batches(db, filters):
+                    for h in batch:
+                        record = {
+                            "id": str(h.id), 
+                            "memory_id": str(h.memory_id), 
+                            "changed_by": str(h.changed_by), 
+                            "old_state": h.old_state.value, 
+                            "new_state": h.new_state.value, 
+                            "changed_at": _iso(h.changed_at), 
+                        }
+                        out.write((json.dumps(record) + "\n").encode())
+                    if sink.size >= EXPORT_CHUNK_SIZE:
+                        yield sink.drain()
+        yield sink.drain()
+
+        elapsed = time.perf_counter() - started
+        logging.info(
+            f"Exported {exported} memories for {manifest['user']['user_id']} in {elapsed:.1f}s "
+            f"({exported / elapsed if elapsed else 0:.0f} memories/s)"
+        )
+    finally:
+        db.close()
+
+
+# ---------------------------------------------------------------------------
+# Import
+# ---------------------------------------------------------------------------
+
+def iter_jsonl(zf: zipfile.ZipFile, member: Optional[str]) -> Iterator[Dict[str, Any]]:
+    if not member:
+        return
+    with zf.open(member) as f:
+        for raw in f:
+            if raw.strip():
+                yield json.loads(raw)
+
+
+class BackupImporter:
+    """Write backup records into the database and vector store, one batch per transaction."""
+
+    def __init__(self, db: Session, user: User, user_id: str, mode: str, memory_client):
+        self.db = db
+        # Batches expunge the session, so keep the key rather than the instance.
+        self.user_pk = user.id
+        self.user_id = user_id
+        self.mode = mode
+        self.memory_client = memory_client
+        self.vector_store = getattr(memory_client, "vector_store", None) if memory_client else None
+        # Only ids minted for cross-user collisions; everything else keeps its id.
+        self.remapped: Dict[str, UUID] = {}
+        self.category_ids: Dict[str, UUID] = {}
+        self.stats = {
+            "memories_imported": 0,
+            "memories_skipped": 0,
+            "embeddings_restored": 0,
+            "embeddings_computed": 0,
+            "vector_failures": 0,
+            "history_imported": 0,
+        }
+
+        app = db.query(App).filter(App.owner_id == user.id, App.name == "openmemory").first()
+        if not app: 
+            app = App(owner_id=user.id, name="openmemory", is_active=True, metadata_={})
+            db.add(app)
+            db.commit()
+            db.refresh(app)
+        self.app_id = app.id
+
+    def import_categories(self, categories: List[Dict[str, Any]]) -> None:
+        names = {c["name"] for c in categories}
+        existing = {c.name: c for c in self.db.query(Category).filter(Category.name.in_(names))} if names else {}
+        for c in categories:
+            if c["name"] not in existing:
+                existing[c["name"]] = Category(name=c["name"], description=c.get("description"))
+                self.db.add(existing[c["name"]])
+        self.db.commit()
+        for c in categories:
+            self.category_ids[c["id"]] = existing[c["name"]].id
+
+    def import_memories(self, records: List[Dict[str, Any]]) -> None:
+        db = self.db
+        incoming_ids = [UUID(r["id"]) for r in records]
+        existing = {m.id: m for m in db.query(Memory).filter(Memory.id.in_(incoming_ids))}
+
+        written = []
+        for record, incoming_id in zip(records, incoming_ids):
+            current = existing.get(incoming_id)
+            # Cross-user collision: always mint a new UUID and import as a new memory
+            if current is not None and current.user_id != self.user_pk:
+                target_id = uuid4()
+                self.remapped[record["id"]] = target_id
+                current = None
+            else:
+                target_id = incoming_id
+
+            # Same-user collision + skip mode: leave existing row untouched
+            if current is not None and self.mode == "skip":
+                self.stats["memories_skipped"] += 1
+                continue
+
+            try:
+                state = MemoryState(record.get("state") or "active")
+            except ValueError:
+                state = MemoryState.active
+
+            # Same-user collision + overwrite mode: treat import as ground truth
+            if current is not None:
+                current.app_id = self.app_id
+                current.content = record.get("content") or ""
+                current.metadata_ = record.get("metadata") or {}
+                current.state = state
+                current.archived_at = _parse_iso(record.get("archived_at"))
+                current.deleted_at = _parse_iso(record.get("deleted_at"))
+                current.created_at = _parse_iso(record.get("created_at")) or current.created_at
+                current.updated_at = _parse_iso(record.get("updated_at")) or current.updated_at
+            else:
+                db.add(Memory(
+                    id=target_id,
+                    user_id=self.user_pk,
+                    app_id=self.app_id,
+                    content=record.get("content") or "",
+                    metadata_=record.get("metadata") or {},
+                    state=state,
+                    created_at=_parse_iso(record.get("created_at")) or datetime.now(UTC),
+                    updated_at=_parse_iso(record.get("updated_at")) or datetime.now(UTC),
+                    archived_at=_parse_iso(record.get("archived_at")),
+                    deleted_at=_parse_iso(record.get("deleted_at")),
+                ))
+            written.append((target_id, record))
+        db.flush()
+
+        links = {
+            (target_id, self.category_ids[cid])
+            for target_id, record in written
+            for cid in record.get("category_ids") or []
+            if cid in self.category_ids
+        }
+        if links:
+            linked = {
+                (row.memory_id, row.category_id)
+                for row in db.execute(
+                    memory_categories.select().where(memory_categories.c.memory_id.in_([mid for mid, _ in links]))
+                )
+            }
+            new_links = [{"memory_id": mid, "category_id": cid} for mid, cid in links - linked]
+            if new_links:
+                db.execute(memory_categories.insert(), new_links)
+        # Restored memories carry their categories; only uncategorized ones go to the LLM.
+        skip_categorization(db, [target_id for target_id, record in written if record.get("category_ids")])
+        db.commit()
+        db.expunge_all()
+
+        self.stats["memories_imported"] += len(written)
+        self._index_vectors(written)
+
+    def _index_vectors(self, written) -> None:
+        if not self.vector_store or not written:
+            return
+        vectors: List[Optional[List[float]]] = [
+            _decode_vector(record["embedding"]) if record.get("embedding") else None for _, record in written
+        ]
+        restored = sum(v is not None for v in vectors)
+        try:
+            self._insert_vectors(written, vectors)
+            self.stats["embeddings_restored"] += restored
+        except Exception as e:
+            if not restored:
+                logging.warning(f"Vector upsert failed for {len(written)} imported memories: {e}")
+                self.stats["vector_failures"] += len(written)
+                return
+            # Stored embeddings may not fit this store (e.g. a different
+            # embedding model); re-embed the batch instead.
+            logging.warning(f"Stored embeddings rejected, re-embedding {len(written)} memories: {e}")
+            try:
+                self._insert_vectors(written, [None] * len(written))
+            except Exception as e:
+                logging.warning(f"Vector upsert failed for {len(written)} imported memories: {e}")
+                self.stats["vector_failures"] += len(written)
+
+    def _insert_vectors(self, written, vectors: List[Optional[List[float]]]) -> None:
+        missing = [i for i, vector in enumerate(vectors) if vector is None]
+        if missing:
+            texts = [written[i][1].get("content") or "" for i in missing]
+            for i, vector in zip(missing, self.memory_client.embedding_model.embed_batch(texts, "add")):
+                vectors[i] = vector
+
+        payloads = []
+        for _, record in written:
+            payload = dict(record.get("metadata") or {})
+            payload["data"] = record.get("content") or ""
+            if record.get("created_at"):
+                payload["created_at"] = record["created_at"]
+            if record.get("updated_at"):
+                payload["updated_at"] = record["updated_at"]
+            payload["user_id"] = self.user_id
+            payload.setdefault("source_app", "openmemory")
+            payloads.append(payload)
+
+        self.vector_store.insert(vectors=vectors, payloads=payloads, ids=[str(target_id) for target_id, _ in written])
+        self.stats["embeddings_computed"] += len(missing)
+
+    def import_history(self, records: List[Dict[str, Any]]) -> None:
+        db = self.db
+        ids = [UUID(h["id"]) for h in records]
+        existing = {h.id: h for h in db.query(MemoryStatusHistory).filter(MemoryStatusHistory.id.in_(ids))}
+        for h, hid in zip(records, ids):
+            rec = existing.get(hid)
+            if rec is not None and self.mode == "skip":
+                continue
+            if rec is None:
+                rec = MemoryStatusHistory(id=hid)
+                db.add(rec)
+            rec.memory_id = self.remapped.get(h["memory_id"], UUID(h["memory_id"]))
+            rec.changed_by = self.user_pk
+            try:
+                rec.old_state = MemoryState(h.get("old_state", "active"))
+                rec.new_state = MemoryState(h.get("new_state", "active"))
+            except Exception:
+                rec.old_state = MemoryState.active
+                rec.new_state = MemoryState.active
+            rec.changed_at = _parse_iso(h.get("changed_at")) or datetime.now(UTC)
+            self.stats["history_imported"] += 1
+        db.commit()
+        db.expunge_all()
+
+
+def legacy_memories(sqlite_data: Dict[str, Any]) -> Iterator[Dict[str, Any]]:
+    """Version 1 records, with their category links folded in as in version 2."""
+    links: Dict[str, List[str]] = {}
+    for link in sqlite_data.get("memory_categories", []):
+        links.setdefault(link["memory_id"], []).append(link["category_id"])
+    for m in sqlite_data.get("memories", []):
+        yield {**m, "category_ids": links.get(m["id"], [])}
+
+
+def find_member(names: List[str], filename: str) -> Optional[str]:
+    for name in names:
+        # Skip directory entries
+        if name.endswith('/'):
+            continue
+        if name.rsplit('/', 1)[-1] == filename:
+            return name
+    return None
+
+
+def read_backup(zf: zipfile.ZipFile) -> Tuple[Dict[str, Any], Iterator[Dict[str, Any]], Iterator[Dict[str, Any]]]:
+    """Return ``(manifest, memories, status_history)`` of a v2 or v1 backup.
+
+    Version 2 records are read lazily from the zip. Raises ``ValueError`` if
+    the archive is neither format.
+    """
+    names = zf.namelist()
+    manifest_member = find_member(names, "manifest.json")
+    if manifest_member:
+        manifest = json.loads(zf.read(manifest_member))
+        return (
+            manifest,
+            iter_jsonl(zf, find_member(names, "memories.jsonl")),
+            iter_jsonl(zf, find_member(names, "status_history.jsonl")),
+        )
+
+    sqlite_member = find_member(names, "memories.json")
+    if not sqlite_member:
+        raise ValueError("manifest.json or memories.json missing in zip")
+    # Version 1 backups keep everything in one JSON document.
+    sqlite_data = json.loads(zf.read(sqlite_member))
+    return sqlite_data, legacy_memories(sqlite_data), iter(sqlite_data.get("status_history", []))
@@ -1,7 +1,8 @@
+import json
 import logging
 from typing import List
 
-from app.utils.prompts import MEMORY_CATEGORIZATION_PROMPT
+from app.utils.prompts import BATCH_MEMORY_CATEGORIZATION_PROMPT, MEMORY_CATEGORIZATION_PROMPT
 from dotenv import load_dotenv
 from openai import OpenAI
 from pydantic import BaseModel
@@ -15,6 +16,15 @@ class MemoryCategories(BaseModel):
     categories: List[str]
 
 
+class IndexedMemoryCategories(BaseModel):
+    index: int
+    categories: List[str]
+
+
+class BatchMemoryCategories(BaseModel):
+    memories: List[IndexedMemoryCategories]
+
+
 @retry(stop=stop_after_attempt(3), wait=wait_exponential(multiplier=1, min=4, max=15))
 def get_categories_for_memory(memory: str) -> List[str]:
     try:
@@ -41,3 +51,35 @@ def get_categories_for_memory(memory: str) -> List[str]:
         except Exception as debug_e:
             logging.debug(f"[DEBUG] Could not extract raw response: {debug_e}")
         raise
+
+
+@retry(stop=stop_after_attempt(3), wait=wait_exponential(multiplier=1, min=4, max=15))
+def get_categories_for_memories(memories: List[str]) -> List[List[str]]:
+    """Categorize several memories with one structured-output call.
+
+    Returns one category list per input, in order. Memories the model skipped
+    get an empty list.
+    """
+    if not memories:
+        return []
+    messages = [
+        {"role": "system", "content": BATCH_MEMORY_CATEGORIZATION_PROMPT},
+        {"role": "user", "content": json.dumps([{"index": i, "memory": m} for i, m in enumerate(memories)])},
+    ]
+    try:
+        completion = openai_client.beta.chat.completions.parse(
+            model="gpt-4o-mini",
+            messages=messages,
+            response_format=BatchMemoryCategories,
+            temperature=0
+        )
+        parsed: BatchMemoryCategories = completion.choices[0].message.parsed
+    except Exception as e:
+        logging.error(f"[ERROR] Failed to get categories for {len(memories)} memories: {e}")
+        raise
+
+    results: List[List[str]] = [[] for _ in memories]
+    for item in parsed.memories:
+        if 0 <= item.index < len(memories):
+            results[item.index] = [cat.strip().lower() for cat in item.categories if cat.strip()]
+    return results
@@ -0,0 +1,200 @@
+"""Background, batched memory categorization.
+
+Memories are queued after their transaction commits and categorized by a
+single worker thread, many per LLM call, so creating or importing memories
+never waits on the model. Identical content is categorized once: duplicates
+already waiting in the queue are merged, and recent results are reused from
+an LRU cache keyed by content hash.
+"""
+
+import hashlib
+import logging
+import threading
+import time
+from collections import OrderedDict
+from typing import Callable, Dict, Hashable, List, Optional
+
+logger = logging.getLogger(__name__)
+
+
+def content_hash(content: str) -> str:
+    return hashlib.sha256(content.strip().encode("utf-8")).hexdigest()
+
+
+class _Pending:
+    __slots__ = ("content", "memory_ids", "enqueued_at")
+
+    def __init__(self, content: str, enqueued_at: float):
+        self.content = content
+        self.memory_ids: set = set()
+        self.enqueued_at = enqueued_at
+
+
+class CategorizationQueue:
+    """Coalesce categorization requests and process them in batches.
+
+    ``categorize`` maps a list of texts to one category list per text (one LLM
+    call per batch). ``write`` stores ``{memory_id: categories}``. Both run on
+    the worker thread. A batch is sent once ``batch_size`` distinct texts are
+    waiting or the oldest has waited ``max_wait`` seconds.
+    """
+
+    def __init__(
+        self,
+        categorize: Callable[[List[str]], List[List[str]]],
+        write: Callable[[Dict[Hashable, List[str]]], None],
+        batch_size: int = 20,
+        max_wait: float = 1.0,
+        max_pending: int = 10_000,
+        cache_size: int = 4096,
+    ):
+        self._categorize = categorize
+        self._write = write
+        self.batch_size = batch_size
+        self.max_wait = max_wait
+        self.max_pending = max_pending
+        self.cache_size = cache_size
+
+        self._cond = threading.Condition()
+        self._pending: "OrderedDict[str, _Pending]" = OrderedDict()
+        # Latest content hash per memory, so a memory edited while queued only
+        # gets the categories of its newest content.
+        self._latest: Dict[Hashable, str] = {}
+        self._cache: "OrderedDict[str, List[str]]" = OrderedDict()
+        self._in_flight = 0
+        self._thread: Optional[threading.Thread] = None
+
+        self._enqueued = 0
+        self._processed = 0
+        self._batches = 0
+        self._llm_calls = 0
+        self._dedup_hits = 0
+        self._cache_hits = 0
+        self._dropped = 0
+        self._failed = 0
+        self._last_lag = 0.0
+        self._max_lag = 0.0
+
+    def enqueue(self, memory_id: Hashable, content: Optional[str]) -> bool:
+        """Queue a memory for categorization. Never blocks; returns False if dropped."""
+        if not content:
+            return False
+        key = content_hash(content)
+        with self._cond:
+            self._enqueued += 1
+            entry = self._pending.get(key)
+            if entry is not None:
+                self._dedup_hits += 1
+            else:
+                if len(self._pending) >= self.max_pending:
+                    self._dropped += 1
+                    return False
+                entry = _Pending(content, time.monotonic())
+                self._pending[key] = entry
+            entry.memory_ids.add(memory_id)
+            self._latest[memory_id] = key
+            self._ensure_started()
+            self._cond.notify_all()
+        return True
+
+    def flush(self, timeout: float = 30.0) -> bool:
+        """Wait until everything queued so far has been written. Returns False on timeout."""
+        with self._cond:
+            self._cond.notify_all()
+            return self._cond.wait_for(lambda: not self._pending and self._in_flight == 0, timeout)
+
+    def stats(self) -> Dict[str, float]:
+        with self._cond:
+            oldest = next(iter(self._pending.values()), None)
+            return {
+                "depth": len(self._pending),
+                "pending_memories": sum(len(e.memory_ids) for e in self._pending.values()),
+                "in_flight": self._in_flight,
+                "oldest_age_seconds": time.monotonic() - oldest.enqueued_at if oldest else 0.0,
+                "last_batch_lag_seconds": self._last_lag,
+                "max_lag_seconds": self._max_lag,
+                "enqueued": self._enqueued,
+                "processed": self._processed,
+                "batches": self._batches,
+                "llm_calls": self._llm_calls,
+                "dedup_hits": self._dedup_hits,
+                "cache_hits": self._cache_hits,
+                "dropped": self._dropped,
+                "failed": self._failed,
+            }
+
+    def _ensure_started(self) -> None:
+        if self._thread is None:
+            self._thread = threading.Thread(target=self._run, name="categorization-queue", daemon=True)
+            self._thread.start()
+
+    def _run(self) -> None:
+        while True:
+            with self._cond:
+                self._cond.wait_for(lambda: self._pending)
+                oldest = next(iter(self._pending.values()))
+                deadline = oldest.enqueued_at + self.max_wait
+                while len(self._pending) < self.batch_size:
+                    remaining = deadline - time.monotonic()
+                    if remaining <= 0:
+                        break
+                    self._cond.wait(remaining)
+                batch = [self._pending.popitem(last=False) for _ in range(min(self.batch_size, len(self._pending)))]
+                self._in_flight += len(batch)
+            try:
+                self._process(batch)
+            except Exception:
+                logger.exception("Categorization batch failed")
+                with self._cond:
+                    self._failed += sum(len(entry.memory_ids) for _, entry in batch)
+                    for key, entry in batch:
+                        for memory_id in entry.memory_ids:
+                            if self._latest.get(memory_id) == key:
+                                del self._latest[memory_id]
+            finally:
+                with self._cond:
+                    self._in_flight -= len(batch)
+                    self._cond.notify_all()
+
+    def _process(self, batch) -> None:
+        results: Dict[str, List[str]] = {}
+        uncached = []
+        with self._cond:
+            for key, entry in batch:
+                if key in self._cache:
+                    self._cache.move_to_end(key)
+                    results[key] = self._cache[key]
+                    self._cache_hits += len(entry.memory_ids)
+                else:
+                    uncached.append((key, entry))
+
+        if uncached:
+            categories = self._categorize([entry.content for _, entry in uncached])
+            with self._cond:
+                self._llm_calls += 1
+                for (key, _), cats in zip(uncached, categories):
+                    results[key] = cats
+                    self._cache[key] = cats
+                    self._cache.move_to_end(key)
+                while len(self._cache) > self.cache_size:
+                    self._cache.popitem(last=False)
+
+        assignments: Dict[Hashable, List[str]] = {}
+        with self._cond:
+            for key, entry in batch:
+                for memory_id in entry.memory_ids:
+                    if self._latest.get(memory_id) != key:
+                        continue  # superseded by a newer edit still in the queue
+                    del self._latest[memory_id]
+                    if results.get(key):
+                        assignments[memory_id] = results[key]
+
+        if assignments:
+            self._write(assignments)
+
+        lag = time.monotonic() - min(entry.enqueued_at for _, entry in batch)
+        with self._cond:
+            self._batches += 1
+            self._processed += sum(len(entry.memory_ids) for _, entry in batch)
+            self._last_lag = lag
+            self._max_lag = max(self._max_lag, lag)
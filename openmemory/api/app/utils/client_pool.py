@@ -0,0 +1,259 @@
+"""Memory client instances keyed by config hash, built off the request path.
+
+Building a ``Memory`` connects to the vector store, creates the embedder and
+LLM clients and loads spaCy models, which can take seconds. The pool keeps
+built instances keyed by the hash of their resolved config and does all
+construction on one background thread:
+
+- ``refresh()`` (called at startup and whenever the stored config changes)
+  re-resolves the config, builds and warms the new instance, then swaps it
+  in atomically; requests keep using the previous instance until then.
+- ``get()`` only looks up a built instance. When none exists yet it queues
+  a build and returns ``None`` unless the caller chose to ``wait``. A config
+  whose build failed is queued again by a later ``get()`` once its backoff
+  has passed.
+"""
+
+import hashlib
+import json
+import logging
+import threading
+import time
+from collections import OrderedDict
+from typing import Any, Callable, Dict, Optional, Tuple
+
+logger = logging.getLogger(__name__)
+
+
+def config_hash(config: Dict[str, Any]) -> str:
+    return hashlib.md5(json.dumps(config, sort_keys=True).encode()).hexdigest()
+
+
+class ClientPool:
+    """Build, warm and hand out clients for the current config.
+
+    ``load_config`` resolves the base config (environment defaults plus the
+    stored overrides); ``factory`` builds a client from a config and
+    ``warmup`` prepares it for its first request. All three run on the
+    worker thread. ``max_instances`` bounds how many configs stay built; the
+    active one is never evicted. After a failed build the same config is not
+    retried for ``retry_seconds``, doubling per failure up to
+    ``max_retry_seconds``.
+    """
+
+    def __init__(
+        self,
+        load_config: Callable[[], Dict[str, Any]],
+        factory: Callable[[Dict[str, Any]], Any],
+        warmup: Optional[Callable[[Any], None]] = None,
+        max_instances: int = 2,
+        retry_seconds: float = 1.0,
+        max_retry_seconds: float = 60.0,
+    ):
+        self._load_config = load_config
+        self._factory = factory
+        self._warmup = warmup
+        self.max_instances = max_instances
+        self.retry_seconds = retry_seconds
+        self.max_retry_seconds = max_retry_seconds
+
+        self._cond = threading.Condition()
+        self._instances: "OrderedDict[str, Any]" = OrderedDict()
+        self._base_config: Optional[Dict[str, Any]] = None
+        self._base_key: Optional[str] = None
+        self._active_key: Optional[str] = None
+        # Configs waiting to be built (key -> config); a queued refresh
+        # re-resolves the base config first.
+        self._queued: "OrderedDict[str, Dict[str, Any]]" = OrderedDict()
+        self._refresh_queued = False
+        self._failed: Dict[str, str] = {}
+        # Failed key -> (consecutive failures, monotonic time of next retry).
+        self._retry: Dict[str, Tuple[int, float]] = {}
+        self._building: Optional[str] = None
+        self._busy = False
+        self._thread: Optional[threading.Thread] = None
+
+        self._created_at = time.monotonic()
+        self._startup_seconds: Optional[float] = None
+        self._last_build: Dict[str, Any] = {}
+        self._builds = 0
+        self._swaps = 0
+        self._failures = 0
+        self._misses = 0
+
+    def get(self, custom_instructions: Optional[str] = None, wait: float = 0.0) -> Any:
+        """The client for the current config, or None if it is not built yet.
+
+        ``custom_instructions`` selects a variant of the current config with
+        its own instance. ``wait`` bounds how long to block for a build that
+        is queued or running; the default never blocks.
+        """
+        deadline = time.monotonic() + wait
+        with self._cond:
+            while True:
+                key = self._request_locked(custom_instructions)
+                if key is not None and key in self._instances:
+                    self._instances.move_to_end(key)
+                    return self._instances[key]
+                pending = self._busy or self._refresh_queued or key in self._queued
+                remaining = deadline - time.monotonic()
+                if not pending or remaining <= 0:
+                    self._misses += 1
+                    return None
+                self._cond.wait(remaining)
+
+    def refresh(self) -> None:
+        """Re-resolve the config and swap in a client for it once warmed."""
+        with self._cond:
+            self._refresh_queued = True
+            self._ensure_started()
+            self._cond.notify_all()
+
+    def wait_ready(self, timeout: float = 30.0) -> bool:
+        """Block until no refresh or build is pending (for startup and tests)."""
+        with self._cond:
+            return self._cond.wait_for(
+                lambda: not (self._refresh_queued or self._queued or self._busy), timeout
+            )
+
+    def stats(self) -> Dict[str, Any]:
+        with self._cond:
+            return {
+                "ready": self._active_key in self._instances,
+                "active_config_hash": self._active_key,
+                "instances": len(self._instances),
+                "building": self._busy or bool(self._queued) or self._refresh_queued,
+                "startup_seconds": self._startup_seconds,
+                "last_build": dict(self._last_build),
+                "builds": self._builds,
+                "swaps": self._swaps,
+                "failures": self._failures,
+                "misses": self._misses,
+                "last_error": next(reversed(self._failed.values()), None),
+            }
+
+    def _request_locked(self, custom_instructions: Optional[str]) -> Optional[str]:
+        """Key of the instance a request needs, queueing its build if missing."""
+        if self._base_config is None:
+            if not self._refresh_queued and not self._busy:
+                self._refresh_queued = True
+                self._ensure_started()
+                self._cond.notify_all()
+            return None
+        if not custom_instructions:
+            if self._active_key in self._instances:
+                return self._active_key
+            # Nothing has been built yet, e.g. the first build failed.
+            if not self._refresh_queued:
+                self._queue_build_locked(self._base_key, self._base_config)
+            return self._base_key
+        config = dict(self._base_config, custom_fact_extraction_prompt=custom_instructions)
+        key = config_hash(config)
+        self._queue_build_locked(key, config)
+        return key
+
+    def _queue_build_locked(self, key: str, config: Dict[str, Any]) -> None:
+        """Queue a build of ``key`` unless it exists, is pending or is backing off."""
+        if key in self._instances or key in self._queued or key == self._building:
+            return
+        retry = self._retry.get(key)
+        if retry is not None and time.monotonic() < retry[1]:
+            return
+        self._queued[key] = config
+        self._ensure_started()
+        self._cond.notify_all()
+
+    def _ensure_started(self) -> None:
+        if self._thread is None:
+            self._thread = threading.Thread(target=self._run, name="memory-client-pool", daemon=True)
+            self._thread.start()
+
+    def _run(self) -> None:
+        while True:
+            with self._cond:
+                self._cond.wait_for(lambda: self._refresh_queued or self._queued)
+                self._busy = True
+                refresh = self._refresh_queued
+                self._refresh_queued = False
+                job = None if refresh else self._queued.popitem(last=False)
+                activate = job is not None and job[0] == self._base_key
+            try:
+                if refresh:
+                    self._do_refresh()
+                else:
+                    self._build(*job, activate=activate)
+            except Exception:
+                logger.exception("Memory client pool job failed")
+            finally:
+                with self._cond:
+                    self._busy = False
+                    self._building = None
+                    self._cond.notify_all()
+
+    def _do_refresh(self) -> None:
+        started = time.monotonic()
+        config = self._load_config()
+        key = config_hash(config)
+        with self._cond:
+            self._base_config = config
+            self._base_key = key
+            self._building = key
+            # Variants of the previous config are stale now.
+            self._queued.clear()
+            self._failed.clear()
+            self._retry.clear()
+            if key in self._instances:
+                self._activate_locked(key)
+                return
+        self._build(key, config, activate=True, started=started)
+
+    def _build(self, key: str, config: Dict[str, Any], activate: bool, started: Optional[float] = None) -> None:
+        started = started if started is not None else time.monotonic()
+        with self._cond:
+            self._building = key
+        try:
+            client = self._factory(config)
+            built = time.monotonic()
+            if self._warmup is not None:
+                self._warmup(client)
+        except Exception as e:
+            logger.warning(f"Failed to build memory client for config {key}: {e}")
+            with self._cond:
+                self._failures += 1
+                self._failed[key] = str(e)
+                attempts = self._retry.get(key, (0, 0.0))[0] + 1
+                delay = min(self.retry_seconds * 2 ** (attempts - 1), self.max_retry_seconds)
+                self._retry[key] = (attempts, time.monotonic() + delay)
+            return
+        warmed = time.monotonic()
+
+        with self._cond:
+            self._builds += 1
+            self._last_build = {
+                "config_hash": key,
+                "build_seconds": round(built - started, 3),
+                "warmup_seconds": round(warmed - built, 3),
+                "total_seconds": round(warmed - started, 3),
+            }
+            self._instances[key] = client
+            self._failed.pop(key, None)
+            self._retry.pop(key, None)
+            if activate:
+                self._activate_locked(key)
+            self._evict_locked()
+        logger.info(f"Memory client ready for config {key}: {self._last_build}")
+
+    def _activate_locked(self, key: str) -> None:
+        if self._active_key != key:
+            self._active_key = key
+            self._swaps += 1
+        self._instances.move_to_end(key)
+        if self._startup_seconds is None:
+            self._startup_seconds = round(time.monotonic() - self._created_at, 3)
+
+    def _evict_locked(self) -> None:
+        for key in list(self._instances):
+            if len(self._instances) <= self.max_instances:
+                break
+            if key != self._active_key:
+                del self._instances[key]
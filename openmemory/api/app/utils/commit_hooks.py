@@ -0,0 +1,54 @@
+"""Side effects that must wait for the transaction that caused them to commit.
+
+ORM events fire on flush, and a flushed change can still be rolled back.
+Modules register a kind of pending work once with :func:`register`. Event
+handlers add to it with :func:`defer`, which accumulates a value in the
+session's ``info``. After the session commits, the value is handed to the
+registered callback; after a rollback it is dropped. Objects that are not
+attached to a session apply their work immediately.
+"""
+
+from typing import Any, Callable, Dict, Optional, Tuple
+
+from sqlalchemy import event
+from sqlalchemy.orm import Session, object_session
+
+_registry: Dict[str, Tuple[Callable[[], Any], Callable[[Any], None]]] = {}
+
+
+def register(key: str, factory: Callable[[], Any], apply: Callable[[Any], None]) -> None:
+    """Declare pending work ``key``: ``factory`` builds an empty value, ``apply`` runs it after commit."""
+    _registry[key] = (factory, apply)
+
+
+def defer(target, key: str, update: Callable[[Any], None]) -> None:
+    """Add to ``key``'s pending value for ``target``'s session with ``update``."""
+    factory, apply = _registry[key]
+    session = object_session(target)
+    if session is None:
+        value = factory()
+        update(value)
+        apply(value)
+        return
+    if key not in session.info:
+        session.info[key] = factory()
+    update(session.info[key])
+
+
+def pending(session: Session, key: str) -> Optional[Any]:
+    """The value still waiting for ``session`` to commit, if any."""
+    return session.info.get(key)
+
+
+@event.listens_for(Session, 'after_commit')
+def _apply_committed(session):
+    for key, (_, apply) in _registry.items():
+        value = session.info.pop(key, None)
+        if value:
+            apply(value)
+
+
+@event.listens_for(Session, 'after_rollback')
+def _discard_rolled_back(session):
+    for key in _registry:
+        session.info.pop(key, None)
@@ -0,0 +1,136 @@
+"""Full-text search over memory content.
+
+The list and filter endpoints used ``content ILIKE '%query%'``, which no index
+can serve. Memories are now indexed with SQLite FTS5 (an external-content
+table kept in sync by triggers) or, on Postgres, a GIN index over
+``to_tsvector('simple', content)``. A search matches memories that contain
+every word of the query as a word prefix, so results follow the user while
+they type. Other databases, or SQLite builds without FTS5, keep the
+ILIKE scan.
+
+``memories`` has a UUID primary key, so its rowid is implicit and ``VACUUM``
+may renumber it. The SQLite index is therefore not keyed by that rowid: each
+memory id gets a stable integer in ``memories_fts_ids`` and the FTS table is
+keyed by it.
+"""
+
+import logging
+import re
+import weakref
+
+import sqlalchemy as sa
+from app.models import Memory
+
+logger = logging.getLogger(__name__)
+
+FTS_TABLE = "memories_fts"
+POSTGRES_INDEX = "idx_memories_content_fts"
+
+FTS_IDS_TABLE = "memories_fts_ids"
+
+_FTS_ROWID = f"(SELECT fts_rowid FROM {FTS_IDS_TABLE} WHERE memory_id = {{row}}.id)"
+
+_SQLITE_CREATE = [
+    f"""CREATE TABLE {FTS_IDS_TABLE} (
+        fts_rowid INTEGER PRIMARY KEY,
+        memory_id TEXT NOT NULL UNIQUE
+    )""",
+    f"CREATE VIRTUAL TABLE {FTS_TABLE} USING fts5(content)",
+    f"""CREATE TRIGGER {FTS_TABLE}_ai AFTER INSERT ON memories BEGIN
+        INSERT INTO {FTS_IDS_TABLE}(memory_id) VALUES (new.id);
+        INSERT INTO {FTS_TABLE}(rowid, content) VALUES ({_FTS_ROWID.format(row="new")}, new.content);
+    END""",
+    f"""CREATE TRIGGER {FTS_TABLE}_ad AFTER DELETE ON memories BEGIN
+        DELETE FROM {FTS_TABLE} WHERE rowid = {_FTS_ROWID.format(row="old")};
+        DELETE FROM {FTS_IDS_TABLE} WHERE memory_id = old.id;
+    END""",
+    f"""CREATE TRIGGER {FTS_TABLE}_au AFTER UPDATE OF content ON memories BEGIN
+        UPDATE {FTS_TABLE} SET content = new.content WHERE rowid = {_FTS_ROWID.format(row="new")};
+    END""",
+    f"INSERT INTO {FTS_IDS_TABLE}(memory_id) SELECT id FROM memories",
+    f"""INSERT INTO {FTS_TABLE}(rowid, content)
+        SELECT i.fts_rowid, m.content FROM {FTS_IDS_TABLE} i JOIN memories m ON m.id = i.memory_id""",
+]
+
+_SQLITE_DROP = [
+    f"DROP TRIGGER IF EXISTS {FTS_TABLE}_ai",
+    f"DROP TRIGGER IF EXISTS {FTS_TABLE}_ad",
+    f"DROP TRIGGER IF EXISTS {FTS_TABLE}_au",
+    f"DROP TABLE IF EXISTS {FTS_TABLE}",
+    f"DROP TABLE IF EXISTS {FTS_IDS_TABLE}",
+]
+
+# Engines whose SQLite database has the FTS table, checked once per engine.
+_sqlite_fts_available: "weakref.WeakKeyDictionary[sa.engine.Engine, bool]" = weakref.WeakKeyDictionary()
+
+
+def create_fulltext_index(connection) -> None:
+    """Create the full-text index for ``connection``'s database if it is missing."""
+    dialect = connection.dialect.name
+    if dialect == "postgresql":
+        connection.execute(sa.text(
+            f"CREATE INDEX IF NOT EXISTS {POSTGRES_INDEX} ON memories USING GIN (to_tsvector('simple', content))"
+        ))
+    elif dialect == "sqlite":
+        tables = {
+            row[0] for row in connection.execute(
+                sa.text("SELECT name FROM sqlite_master WHERE type = 'table' AND name IN (:fts, :ids)"),
+                {"fts": FTS_TABLE, "ids": FTS_IDS_TABLE},
+            )
+        }
+        if tables == {FTS_TABLE, FTS_IDS_TABLE}:
+            return
+        # An index from before memories_fts_ids existed is keyed by the
+        # unstable memories rowid; rebuild it.
+        drop_fulltext_index(connection)
+        try:
+            for statement in _SQLITE_CREATE:
+                connection.execute(sa.text(statement))
+        except sa.exc.OperationalError as e:
+            # SQLite compiled without FTS5: searches keep using ILIKE.
+            drop_fulltext_index(connection)
+            logger.warning(f"SQLite full-text index unavailable, falling back to ILIKE search: {e}")
+
+
+def drop_fulltext_index(connection) -> None:
+    dialect = connection.dialect.name
+    if dialect == "postgresql":
+        connection.execute(sa.text(f"DROP INDEX IF EXISTS {POSTGRES_INDEX}"))
+    elif dialect == "sqlite":
+        for statement in _SQLITE_DROP:
+            connection.execute(sa.text(statement))
+
+
+def _terms(search_query: str) -> list:
+    return re.findall(r"\w+", search_query.lower())
+
+
+def _has_sqlite_fts(engine) -> bool:
+    available = _sqlite_fts_available.get(engine)
+    if available is None:
+        with engine.connect() as connection:
+            available = connection.execute(
+                sa.text("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = :name"), {"name": FTS_TABLE}
+            ).first() is not None
+        _sqlite_fts_available[engine] = available
+    return available
+
+
+def memory_content_matches(db, search_query: str):
+    """SQL predicate on ``Memory`` for memories whose content matches ``search_query``."""
+    terms = _terms(search_query)
+    bind = db.get_bind()
+    dialect = bind.dialect.name
+    if terms and dialect == "postgresql":
+        tsquery = " & ".join(f"{term}:*" for term in terms)
+        return sa.func.to_tsvector(sa.literal_column("'simple'"), Memory.content).op("@@")(
+            sa.func.to_tsquery(sa.literal_column("'simple'"), tsquery)
+        )
+    if terms and dialect == "sqlite" and _has_sqlite_fts(bind.engine):
+        match = " ".join(f'"{term}"*' for term in terms)
+        matching_ids = sa.text(
+            f"SELECT i.memory_id FROM {FTS_TABLE} JOIN {FTS_IDS_TABLE} i ON i.fts_rowid = {FTS_TABLE}.rowid "
+            f"WHERE {FTS_TABLE} MATCH :fts_query"
+        ).bindparams(fts_query=match).columns(sa.column("memory_id"))
+        return sa.literal_column("memories.id").in_(matching_ids)
+    return Memory.content.ilike(f"%{search_query}%")
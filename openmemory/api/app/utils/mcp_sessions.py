@@ -0,0 +1,250 @@
+"""Long-lived MCP sessions for the Streamable HTTP transport.
+
+Stateless Streamable HTTP starts a transport, a task group and a server run
+for every request. A client that opens a session instead (``initialize``
+without an ``mcp-session-id`` header) gets one transport and one server task
+that serve all of its later requests; the session id is returned in the
+``mcp-session-id`` response header as the MCP spec describes.
+
+Sessions are bound to the (client_name, user_id) path they were opened on,
+closed after ``idle_timeout`` seconds without a request, and capped per
+client and in total (the least recently used idle session is closed to make
+room). Each client also has a bound on requests in flight; a request that
+cannot get a slot within ``queue_timeout`` is answered with 429.
+"""
+
+import asyncio
+import contextlib
+import logging
+import time
+import uuid
+from collections import OrderedDict
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+from mcp.server.streamable_http import StreamableHTTPServerTransport
+
+logger = logging.getLogger(__name__)
+
+ClientKey = Tuple[str, str]
+
+
+class McpSession:
+    __slots__ = ("id", "client", "transport", "task", "created_at", "last_active", "in_flight", "requests")
+
+    def __init__(self, session_id: str, client: ClientKey, transport: StreamableHTTPServerTransport):
+        self.id = session_id
+        self.client = client
+        self.transport = transport
+        self.task: Optional[asyncio.Task] = None
+        self.created_at = time.monotonic()
+        self.last_active = self.created_at
+        self.in_flight = 0
+        self.requests = 0
+
+
+class McpSessionRegistry:
+    """Open, route to, and evict persistent MCP server sessions.
+
+    ``run_server(read_stream, write_stream)`` runs the MCP server over a
+    session's streams until they close; it is started in a task that
+    inherits the caller's context, so context variables set for the opening
+    request (user id, client name) hold for the whole session.
+    """
+
+    def __init__(
+        self,
+        run_server: Callable[[Any, Any], Any],
+        idle_timeout: float = 1800.0,
+        max_sessions: int = 1000,
+        max_sessions_per_client: int = 8,
+        max_concurrent_per_client: int = 8,
+        queue_timeout: float = 5.0,
+    ):
+        self._run_server = run_server
+        self.idle_timeout = idle_timeout
+        self.max_sessions = max_sessions
+        self.max_sessions_per_client = max_sessions_per_client
+        self.max_concurrent_per_client = max_concurrent_per_client
+        self.queue_timeout = queue_timeout
+
+        # Least recently used first.
+        self._sessions: "OrderedDict[str, McpSession]" = OrderedDict()
+        self._limits: Dict[ClientKey, asyncio.Semaphore] = {}
+        self._waiting: Dict[ClientKey, int] = {}
+        self._sweeper: Optional[asyncio.Task] = None
+
+        self._opened = 0
+        self._closed_idle = 0
+        self._closed_evicted = 0
+        self._closed_by_client = 0
+        self._rejected_busy = 0
+        self._rejected_full = 0
+
+    def get(self, session_id: Optional[str], client: ClientKey) -> Optional[McpSession]:
+        """The open session with this id, if it belongs to ``client``."""
+        session = self._sessions.get(session_id) if session_id else None
+        if session is None or session.client != client or session.transport.is_terminated:
+            return None
+        return session
+
+    async def open(self, client: ClientKey) -> Optional[McpSession]:
+        """Start a session for ``client``; None if every slot is busy."""
+        self._ensure_sweeper()
+        if not await self._make_room(client):
+            self._rejected_full += 1
+            return None
+
+        session_id = uuid.uuid4().hex
+        transport = StreamableHTTPServerTransport(mcp_session_id=session_id, is_json_response_enabled=True)
+        session = McpSession(session_id, client, transport)
+        ready = asyncio.Event()
+
+        async def run():
+            try:
+                async with transport.connect() as (read_stream, write_stream):
+                    ready.set()
+                    await self._run_server(read_stream, write_stream)
+            except Exception:
+                logger.exception(f"MCP session {session_id} crashed")
+            finally:
+                ready.set()
+                self._sessions.pop(session_id, None)
+
+        # create_task copies the current context, binding the session to the
+        # opening request's user and client.
+        session.task = asyncio.create_task(run(), name=f"mcp-session-{session_id}")
+        await ready.wait()
+        self._sessions[session_id] = session
+        self._opened += 1
+        return session
+
+    @contextlib.asynccontextmanager
+    async def slot(self, client: ClientKey):
+        """Hold one of ``client``'s in-flight request slots; raises ClientBusy on timeout."""
+        limit = self._limits.get(client)
+        if limit is None:
+            limit = self._limits[client] = asyncio.Semaphore(self.max_concurrent_per_client)
+        # Requests holding or waiting for this client's slots; the semaphore is
+        # dropped when it reaches zero.
+        self._waiting[client] = self._waiting.get(client, 0) + 1
+        try:
+            try:
+                await asyncio.wait_for(limit.acquire(), self.queue_timeout)
+            except asyncio.TimeoutError:
+                self._rejected_busy += 1
+                raise ClientBusy()
+            try:
+                yield
+            finally:
+                limit.release()
+        finally:
+            self._waiting[client] -= 1
+            if not self._waiting[client]:
+                del self._waiting[client]
+                del self._limits[client]
+
+    async def handle(self, session: McpSession, scope, receive, send) -> None:
+        """Serve one request on ``session`` within its client's concurrency limit."""
+        async with self.slot(session.client):
+            session.in_flight += 1
+            session.requests += 1
+            self._sessions.move_to_end(session.id)
+            try:
+                await session.transport.handle_request(scope, receive, send)
+            finally:
+                session.in_flight -= 1
+                session.last_active = time.monotonic()
+        if session.transport.is_terminated:
+            # The client ended the session (DELETE).
+            self._closed_by_client += 1
+            await self._close(session)
+
+    async def discard(self, session: McpSession) -> None:
+        """Close a session whose opening request failed."""
+        await self._close(session)
+
+    async def close_idle(self) -> int:
+        """Close sessions idle for longer than ``idle_timeout``; returns how many."""
+        cutoff = time.monotonic() - self.idle_timeout
+        idle = [s for s in self._sessions.values() if s.in_flight == 0 and s.last_active < cutoff]
+        for session in idle:
+            self._closed_idle += 1
+            await self._close(session)
+        return len(idle)
+
+    async def close_all(self) -> None:
+        for session in list(self._sessions.values()):
+            await self._close(session)
+        if self._sweeper is not None:
+            self._sweeper.cancel()
+            self._sweeper = None
+
+    def stats(self) -> Dict[str, Any]:
+        now = time.monotonic()
+        clients: Dict[ClientKey, int] = {}
+        for session in self._sessions.values():
+            clients[session.client] = clients.get(session.client, 0) + 1
+        return {
+            "sessions": len(self._sessions),
+            "clients": len(clients),
+            "in_flight": sum(s.in_flight for s in self._sessions.values()),
+            "oldest_idle_seconds": max((now - s.last_active for s in self._sessions.values()), default=0.0),
+            "opened": self._opened,
+            "closed_idle": self._closed_idle,
+            "closed_evicted": self._closed_evicted,
+            "closed_by_client": self._closed_by_client,
+            "rejected_busy": self._rejected_busy,
+            "rejected_full": self._rejected_full,
+        }
+
+    async def _make_room(self, client: ClientKey) -> bool:
+        own = [s for s in self._sessions.values() if s.client == client]
+        if len(own) >= self.max_sessions_per_client:
+            if not await self._evict_one(own):
+                return False
+        if len(self._sessions) >= self.max_sessions:
+            return await self._evict_one(list(self._sessions.values()))
+        return True
+
+    async def _evict_one(self, candidates: List[McpSession]) -> bool:
+        # Candidates are in least-recently-used order.
+        for session in candidates:
+            if session.in_flight == 0:
+                self._closed_evicted += 1
+                await self._close(session)
+                return True
+        return False
+
+    async def _close(self, session: McpSession) -> None:
+        self._sessions.pop(session.id, None)
+        if not session.transport.is_terminated:
+            await session.transport.terminate()
+        if session.task is not None and not session.task.done():
+            session.task.cancel()
+
+    def _ensure_sweeper(self) -> None:
+        loop = asyncio.get_running_loop()
+        if self._sweeper is not None and not self._sweeper.done() and self._sweeper.get_loop() is loop:
+            return
+        if self._sweeper is not None and self._sweeper.get_loop() is not loop:
+            # The previous event loop is gone (tests, reloads); its sessions went with it.
+            self._sessions.clear()
+            self._limits.clear()
+            self._waiting.clear()
+        self._sweeper = loop.create_task(self._sweep(), name="mcp-session-sweeper")
+
+    async def _sweep(self) -> None:
+        interval = max(1.0, min(60.0, self.idle_timeout / 4))
+        while True:
+            await asyncio.sleep(interval)
+            try:
+                closed = await self.close_idle()
+                if closed:
+                    logger.info(f"Closed {closed} idle MCP sessions")
+            except Exception:
+                logger.exception("MCP session sweep failed")
+
+
+class ClientBusy(Exception):
+    """The client already has ``max_concurrent_per_client`` requests in flight."""
+
@@ -27,26 +27,15 @@ Example configuration that will be automatically adjusted:
 }
 """
 
-import hashlib
-import json
 import os
 import socket
 
 from app.database import SessionLocal
 from app.models import Config as ConfigModel
+from app.utils.client_pool import ClientPool
 
 from mem0 import Memory
 
-_memory_client = None
-_config_hash = None
-
-
-def _get_config_hash(config_dict):
-    """Generate a hash of the config to detect changes."""
-    config_str = json.dumps(config_dict, sort_keys=True)
-    return hashlib.md5(config_str.encode()).hexdigest()
-
-
 def _get_docker_host_url():
     """
     Determine the appropriate host URL to reach host machine from inside Docker container.
@@ -126,13 +115,6 @@ def _fix_ollama_urls(config_section):
     return config_section
 
 
-def reset_memory_client():
-    """Reset the global memory client to force reinitialization with new config."""
-    global _memory_client, _config_hash
-    _memory_client = None
-    _config_hash = None
-
-
 # --- LLM provider config factories ---
 
 def _build_ollama_llm_config(model, api_key, base_url, ollama_base_url):
@@ -401,103 +383,109 @@ def _parse_environment_variables(config_dict):
     return config_dict
 
 
-def get_memory_client(custom_instructions: str = None):
+def load_memory_config():
+    """
+    Resolve the Mem0 config: environment defaults, overridden by the config
+    stored in the database, with Ollama URLs fixed for Docker and env:
+    references expanded.
     """
-    Get or initialize the Mem0 client.
+    # Start with default configuration
+    config = get_default_memory_config()
 
-    Args:
-        custom_instructions: Optional instructions for the memory project.
+    # Load configuration from database
+    try:
+        db = SessionLocal()
+        db_config = db.query(ConfigModel).filter(ConfigModel.key == "main").first()
 
-    Returns:
-        Initialized Mem0 client instance or None if initialization fails.
+        if db_config:
+            json_config = db_config.value
 
-    Raises:
-        Exception: If required API keys are not set or critical configuration is missing.
-    """
-    global _memory_client, _config_hash
+            # Extract custom instructions from openmemory settings
+            if "openmemory" in json_config and json_config["openmemory"].get("custom_instructions"):
+                config["custom_fact_extraction_prompt"] = json_config["openmemory"]["custom_instructions"]
+
+            # Override defaults with configurations from the database
+            if "mem0" in json_config:
+                mem0_config = json_config["mem0"]
+
+                # Update LLM configuration if available
+                if "llm" in mem0_config and mem0_config["llm"] is not None:
+                    config["llm"] = mem0_config["llm"]
+
+                # Update Embedder configuration if available
+                if "embedder" in mem0_config and mem0_config["embedder"] is not None:
+                    config["embedder"] = mem0_config["embedder"]
+
+                if "vector_store" in mem0_config and mem0_config["vector_store"] is not None:
+                    config["vector_store"] = mem0_config["vector_store"]
+        else:
+            print("No configuration found in database, using defaults")
+
+        db.close()
 
-    try:
-        # Start with default configuration
-        config = get_default_memory_config()
-        
-        # Variable to track custom instructions
-        db_custom_instructions = None
-        
-        # Load configuration from database
-        try:
-            db = SessionLocal()
-            db_config = db.query(ConfigModel).filter(ConfigModel.key == "main").first()
-            
-            if db_config:
-                json_config = db_config.value
-                
-                # Extract custom instructions from openmemory settings
-                if "openmemory" in json_config and "custom_instructions" in json_config["openmemory"]:
-                    db_custom_instructions = json_config["openmemory"]["custom_instructions"]
-                
-                # Override defaults with configurations from the database
-                if "mem0" in json_config:
-                    mem0_config = json_config["mem0"]
-                    
-                    # Update LLM configuration if available
-                    if "llm" in mem0_config and mem0_config["llm"] is not None:
-                        config["llm"] = mem0_config["llm"]
-
-                    # Update Embedder configuration if available
-                    if "embedder" in mem0_config and mem0_config["embedder"] is not None:
-                        config["embedder"] = mem0_config["embedder"]
-
-                    if "vector_store" in mem0_config and mem0_config["vector_store"] is not None:
-                        config["vector_store"] = mem0_config["vector_store"]
-            else:
-                print("No configuration found in database, using defaults")
-                    
-            db.close()
-                            
-        except Exception as e:
-            print(f"Warning: Error loading configuration from database: {e}")
-            print("Using default configuration")
-            # Continue with default configuration if database config can't be loaded
-
-        # Use custom_instructions parameter first, then fall back to database value
-        instructions_to_use = custom_instructions or db_custom_instructions
-        if instructions_to_use:
-            config["custom_fact_extraction_prompt"] = instructions_to_use
-
-        # Fix Ollama URLs for Docker environment (applies to both env-var defaults and DB overrides)
-        if config.get("llm", {}).get("provider") == "ollama":
-            config["llm"] = _fix_ollama_urls(config["llm"])
-        if config.get("embedder", {}).get("provider") == "ollama":
-            config["embedder"] = _fix_ollama_urls(config["embedder"])
-
-        # ALWAYS parse environment variables in the final config
-        # This ensures that even default config values like "env:OPENAI_API_KEY" get parsed
-        print("Parsing environment variables in final config...")
-        config = _parse_environment_variables(config)
-
-        # Check if config has changed by comparing hashes
-        current_config_hash = _get_config_hash(config)
-        
-        # Only reinitialize if config changed or client doesn't exist
-        if _memory_client is None or _config_hash != current_config_hash:
-            print(f"Initializing memory client with config hash: {current_config_hash}")
-            try:
-                _memory_client = Memory.from_config(config_dict=config)
-                _config_hash = current_config_hash
-                print("Memory client initialized successfully")
-            except Exception as init_error:
-                print(f"Warning: Failed to initialize memory client: {init_error}")
-                print("Server will continue running with limited memory functionality")
-                _memory_client = None
-                _config_hash = None
-                return None
-        
-        return _memory_client
-        
     except Exception as e:
-        print(f"Warning: Exception occurred while initializing memory client: {e}")
-        print("Server will continue running with limited memory functionality")
-        return None
+        print(f"Warning: Error loading configuration from database: {e}")
+        print("Using default configuration")
+        # Continue with default configuration if database config can't be loaded
+
+    # Fix Ollama URLs for Docker environment (applies to both env-var defaults and DB overrides)
+    if config.get("llm", {}).get("provider") == "ollama":
+        config["llm"] = _fix_ollama_urls(config["llm"])
+    if config.get("embedder", {}).get("provider") == "ollama":
+        config["embedder"] = _fix_ollama_urls(config["embedder"])
+
+    # ALWAYS parse environment variables in the final config
+    # This ensures that even default config values like "env:OPENAI_API_KEY" get parsed
+    print("Parsing environment variables in final config...")
+    return _parse_environment_variables(config)
+
+
+def _warm_up_memory_client(client):
+    """Load what the first add/search would otherwise load on the request path."""
+    # spaCy models back entity extraction and BM25 lemmatization; both loaders
+    # cache process-wide and return None when spaCy is not installed.
+    from mem0.utils.spacy_models import get_nlp_full, get_nlp_lemma
+
+    get_nlp_lemma()
+    get_nlp_full()
+
+
+memory_client_pool = ClientPool(
+    load_config=load_memory_config,
+    factory=lambda config: Memory.from_config(config_dict=config),
+    warmup=_warm_up_memory_client,
+    max_instances=int(os.getenv("MEMORY_CLIENT_POOL_SIZE", "2")),
+)
+
+
+def reset_memory_client():
+    """Rebuild the memory client for the stored config in the background.
+
+    The current client keeps serving requests until the new one is built and
+    warmed, then the two are swapped atomically.
+    """
+    memory_client_pool.refresh()
+
+
+def get_memory_client(custom_instructions: str = None, wait: float = 0.0):
+    """
+    Get the Mem0 client for the current configuration.
+
+    Clients are built and warmed on a background thread (see
+    ``app.utils.client_pool``), so this never constructs one on the request
+    path.
+
+    Args:
+        custom_instructions: Optional instructions for the memory project;
+            they get their own client built from the current config.
+        wait: Seconds to wait for a client that is still being built. The
+            default returns immediately.
+
+    Returns:
+        Initialized Mem0 client instance, or None while it is being built or
+        if initialization failed (see ``memory_client_pool.stats()``).
+    """
+    return memory_client_pool.get(custom_instructions, wait=wait)
 
 
 def get_default_user_id():
@@ -1,8 +1,213 @@
-from typing import Optional
+"""Memory access checks for apps.
+
+The permission set of an app over a user's memories (app state, ACL allow
+list, and the user's paused or archived memories) is cached per (user, app) and
+dropped whenever a committed transaction touches an ``AccessControl`` row,
+the app, or the state of one of the user's memories. Searches push the set
+into the vector store query so the store returns ``top_k`` permitted hits
+directly instead of post-filtering a fixed page of results.
+"""
+
+import os
+import threading
+import time
+from dataclasses import dataclass
+from typing import Dict, FrozenSet, List, Optional, Set, Tuple
 from uuid import UUID
 
-from app.models import App, Memory, MemoryState
-from sqlalchemy.orm import Session
+import sqlalchemy as sa
+from app.models import AccessControl, App, Memory, MemoryState
+from app.utils import commit_hooks
+from sqlalchemy import event
+from sqlalchemy.orm import Session, aliased
+
+# Upper bound on how far a search over-fetches on stores without native id
+# filtering before giving up on filling top_k.
+MAX_OVERFETCH = 1000
+
+# Non-active states whose vectors stay in the store and must be filtered out
+# of searches. Deleting a memory also deletes its vector.
+BLOCKED_STATES = (MemoryState.paused, MemoryState.archived)
+
+
+@dataclass(frozen=True)
+class MemoryPermissions:
+    app_active: bool
+    # Memory ids the app's ACL allows; None means no ACL restriction.
+    allowed_ids: Optional[FrozenSet[str]]
+    # The user's paused and archived memories.
+    blocked_ids: FrozenSet[str]
+
+    @property
+    def denies_all(self) -> bool:
+        if not self.app_active:
+            return True
+        return self.allowed_ids is not None and not (self.allowed_ids - self.blocked_ids)
+
+    @property
+    def restricts(self) -> bool:
+        return self.allowed_ids is not None or bool(self.blocked_ids)
+
+    def permits(self, memory_id) -> bool:
+        if not self.app_active or memory_id is None:
+            return False
+        memory_id = str(memory_id)
+        if memory_id in self.blocked_ids:
+            return False
+        return self.allowed_ids is None or memory_id in self.allowed_ids
+
+
+class PermissionCache:
+    """Per (user, app) permission sets with commit-driven invalidation.
+
+    A lookup only stores its result if no invalidation happened while it was
+    reading, so a set computed from pre-commit rows is never cached after the
+    commit that changed them. ``ttl_seconds`` bounds staleness from writes
+    made by other processes.
+    """
+
+    def __init__(self, ttl_seconds: float = 30.0):
+        self.ttl_seconds = ttl_seconds
+        self._lock = threading.Lock()
+        self._entries: Dict[Tuple[UUID, UUID], Tuple[float, MemoryPermissions]] = {}
+        self._generation = 0
+        self._hits = 0
+        self._misses = 0
+
+    def get(self, db: Session, user_id: UUID, app_id: UUID) -> MemoryPermissions:
+        key = (user_id, app_id)
+        with self._lock:
+            entry = self._entries.get(key)
+            if entry is not None and entry[0] > time.monotonic():
+                self._hits += 1
+                return entry[1]
+            self._misses += 1
+            generation = self._generation
+
+        permissions = _load_permissions(db, user_id, app_id)
+        with self._lock:
+            if generation == self._generation and self.ttl_seconds > 0:
+                self._entries[key] = (time.monotonic() + self.ttl_seconds, permissions)
+        return permissions
+
+    def invalidate(self, user_ids=(), app_ids=(), everything: bool = False) -> None:
+        with self._lock:
+            self._generation += 1
+            if everything:
+                self._entries.clear()
+                return
+            users, apps = set(user_ids), set(app_ids)
+            for key in [k for k in self._entries if k[0] in users or k[1] in apps]:
+                del self._entries[key]
+
+    def stats(self) -> Dict[str, int]:
+        with self._lock:
+            return {"entries": len(self._entries), "hits": self._hits, "misses": self._misses}
+
+
+permission_cache = PermissionCache(ttl_seconds=float(os.getenv("PERMISSION_CACHE_TTL_SECONDS", "30")))
+
+
+def get_accessible_memory_ids(db: Session, app_id: UUID) -> Optional[Set[UUID]]:
+    """
+    Get the set of memory IDs that the app has access to based on app-level ACL rules.
+    Returns all memory IDs if no specific restrictions are found.
+    """
+    # Get app-level access controls
+    app_access = db.query(AccessControl).filter(
+        AccessControl.subject_type == "app",
+        AccessControl.subject_id == app_id,
+        AccessControl.object_type == "memory"
+    ).all()
+
+    # If no app-level rules exist, return None to indicate all memories are accessible
+    if not app_access:
+        return None
+
+    # Initialize sets for allowed and denied memory IDs. A blanket deny takes
+    # precedence over a blanket allow, matching memory_access_predicate().
+    allowed_memory_ids = set()
+    denied_memory_ids = set()
+    allow_all = deny_all = False
+
+    # Process app-level rules
+    for rule in app_access:
+        if rule.effect == "allow":
+            if rule.object_id:  # Specific memory access
+                allowed_memory_ids.add(rule.object_id)
+            else:  # All memories access
+                allow_all = True
+        elif rule.effect == "deny":
+            if rule.object_id:  # Specific memory denied
+                denied_memory_ids.add(rule.object_id)
+            else:  # All memories denied
+                deny_all = True
+
+    if deny_all:
+        return set()  # No memories accessible
+    if allow_all:
+        return None  # All memories allowed
+
+    # Remove denied memories from allowed set
+    return allowed_memory_ids - denied_memory_ids
+
+
+def memory_access_predicate(app_id: Optional[UUID] = None):
+    """
+    SQL predicate on ``Memory`` equivalent to check_memory_access_permissions().
+
+    Lets list queries filter by access in the database, so a page costs
+    O(page) instead of checking every memory of the user in Python. The ACL
+    rules are correlated EXISTS lookups served by the access_controls
+    subject/object indexes.
+    """
+    active = Memory.state == MemoryState.active
+    if not app_id:
+        return active
+
+    rules = aliased(AccessControl)
+
+    def rule_exists(effect: Optional[str] = None, *conditions):
+        clauses = [rules.subject_type == "app", rules.subject_id == app_id, rules.object_type == "memory"]
+        if effect:
+            clauses.append(rules.effect == effect)
+        return sa.exists().where(*clauses, *conditions)
+
+    app = aliased(App)
+    app_active = sa.exists().where(app.id == app_id, app.is_active.is_(True))
+    acl_allows = sa.or_(
+        ~rule_exists(),
+        sa.and_(
+            ~rule_exists("deny", rules.object_id.is_(None)),
+            sa.or_(
+                rule_exists("allow", rules.object_id.is_(None)),
+                sa.and_(
+                    rule_exists("allow", rules.object_id == Memory.id),
+                    ~rule_exists("deny", rules.object_id == Memory.id),
+                ),
+            ),
+        ),
+    )
+    return sa.and_(active, app_active, acl_allows)
+
+
+def _load_permissions(db: Session, user_id: UUID, app_id: UUID) -> MemoryPermissions:
+    app = db.query(App.is_active).filter(App.id == app_id).first()
+    if app is None or not app.is_active:
+        return MemoryPermissions(app_active=False, allowed_ids=frozenset(), blocked_ids=frozenset())
+
+    accessible = get_accessible_memory_ids(db, app_id)
+    blocked = db.query(Memory.id).filter(Memory.user_id == user_id, Memory.state.in_(BLOCKED_STATES)).all()
+    return MemoryPermissions(
+        app_active=True,
+        allowed_ids=None if accessible is None else frozenset(str(mid) for mid in accessible),
+        blocked_ids=frozenset(str(row.id) for row in blocked),
+    )
+
+
+def get_memory_permissions(db: Session, user_id: UUID, app_id: UUID) -> MemoryPermissions:
+    """Cached permission set of ``app_id`` over the memories of ``user_id``."""
+    return permission_cache.get(db, user_id, app_id)
 
 
 def check_memory_access_permissions(
@@ -32,22 +237,180 @@ def check_memory_access_permissions(
     if not app_id:
         return True
 
-    # Check if app exists and is active
-    app = db.query(App).filter(App.id == app_id).first()
-    if not app:
+    # App state and app-specific access controls come from the cached set;
+    # the memory's own state was checked above on the live row.
+    permissions = get_memory_permissions(db, memory.user_id, app_id)
+    if not permissions.app_active:
         return False
+    return permissions.allowed_ids is None or str(memory.id) in permissions.allowed_ids
 
-    # Check if app is paused/inactive
-    if not app.is_active:
-        return False
 
-    # Check app-specific access controls
-    from app.routers.memories import get_accessible_memory_ids
-    accessible_memory_ids = get_accessible_memory_ids(db, app_id)
+def search_permitted_memories(vector_store, query: str, vectors, filters: dict,
+                              permissions: MemoryPermissions, top_k: int) -> List:
+    """
+    Vector search returning up to ``top_k`` hits the app is permitted to see.
+
+    On Qdrant the permission set becomes a point-id condition of the query
+    filter. Other stores over-fetch and drop unpermitted hits: when only
+    blocked ids restrict access, fetching ``top_k + len(blocked)`` (at most
+    ``MAX_OVERFETCH``) is enough; an ACL allow list widens the fetch until
+    ``top_k`` hits are permitted or the store runs out.
+    """
+    if permissions.denies_all:
+        return []
+    if not permissions.restricts:
+        return vector_store.search(query=query, vectors=vectors, top_k=top_k, filters=filters)
+
+    native = _search_qdrant_with_ids(vector_store, vectors, filters, permissions, top_k)
+    if native is not None:
+        return native
+
+    limit = _first_fetch(permissions, top_k)
+    while True:
+        hits = vector_store.search(query=query, vectors=vectors, top_k=limit, filters=filters)
+        permitted = [hit for hit in hits if permissions.permits(hit.id)]
+        if len(permitted) >= top_k or len(hits) < limit or limit >= MAX_OVERFETCH:
+            return permitted[:top_k]
+        limit = min(limit * 4, MAX_OVERFETCH)
+
+
+def search_permitted_memories_batch(vector_store, queries: List[str], vectors_list: List, filters: dict,
+                                    permissions: MemoryPermissions, top_k: int) -> List[List]:
+    """
+    ``search_permitted_memories`` for several queries in one batched store query.
+
+    Returns one hit list per query. Over-fetch rounds re-query only the
+    queries that are still short of ``top_k`` permitted hits.
+    """
+    if permissions.denies_all:
+        return [[] for _ in queries]
+    if not permissions.restricts:
+        return vector_store.search_batch(queries, vectors_list, top_k=top_k, filters=filters)
+
+    native = _search_qdrant_batch_with_ids(vector_store, vectors_list, filters, permissions, top_k)
+    if native is not None:
+        return native
+
+    results: List[List] = [[] for _ in queries]
+    pending = list(range(len(queries)))
+    limit = _first_fetch(permissions, top_k)
+    while pending:
+        batch = vector_store.search_batch(
+            [queries[i] for i in pending], [vectors_list[i] for i in pending], top_k=limit, filters=filters
+        )
+        short = []
+        for i, hits in zip(pending, batch):
+            results[i] = [hit for hit in hits if permissions.permits(hit.id)][:top_k]
+            if len(results[i]) < top_k and len(hits) >= limit:
+                short.append(i)
+        if limit >= MAX_OVERFETCH:
+            break
+        pending = short
+        limit = min(limit * 4, MAX_OVERFETCH)
+    return results
+
+
+def _first_fetch(permissions: MemoryPermissions, top_k: int) -> int:
+    return max(top_k, min(top_k + len(permissions.blocked_ids), MAX_OVERFETCH))
+
+
+def _qdrant_permission_filter(vector_store, filters, permissions):
+    """Qdrant filter combining ``filters`` with the permission set, or None for other stores."""
+    try:
+        from mem0.vector_stores.qdrant import Qdrant
+        from qdrant_client.models import Filter, HasIdCondition
+    except ImportError:
+        return None
+    if not isinstance(vector_store, Qdrant):
+        return None
+
+    if permissions.allowed_ids is not None:
+        id_filter = Filter(must=[HasIdCondition(has_id=sorted(permissions.allowed_ids - permissions.blocked_ids))])
+    else:
+        id_filter = Filter(must_not=[HasIdCondition(has_id=sorted(permissions.blocked_ids))])
+    base = vector_store._create_filter(filters) if filters else None
+    return Filter(must=[f for f in (base, id_filter) if f is not None])
+
+
+def _search_qdrant_with_ids(vector_store, vectors, filters, permissions, top_k):
+    query_filter = _qdrant_permission_filter(vector_store, filters, permissions)
+    if query_filter is None:
+        return None
+    hits = vector_store.client.query_points(
+        collection_name=vector_store.collection_name,
+        query=vectors,
+        query_filter=query_filter,
+        limit=top_k,
+    )
+    return hits.points
+
+
+def _search_qdrant_batch_with_ids(vector_store, vectors_list, filters, permissions, top_k):
+    query_filter = _qdrant_permission_filter(vector_store, filters, permissions)
+    if query_filter is None:
+        return None
+    from qdrant_client.models import QueryRequest
+
+    results = vector_store.client.query_batch_points(
+        collection_name=vector_store.collection_name,
+        requests=[
+            QueryRequest(query=vectors, filter=query_filter, limit=top_k, with_payload=True)
+            for vectors in vectors_list
+        ],
+    )
+    return [r.points for r in results]
+
+
+# ---------------------------------------------------------------------------
+# Invalidation: record what a flush touched, drop it once the commit lands.
+# ---------------------------------------------------------------------------
+
+_PENDING_INVALIDATION = "pending_permission_invalidation"
+
+
+def _invalidate(pending: dict) -> None:
+    permission_cache.invalidate(user_ids=pending["users"], app_ids=pending["apps"], everything=pending["all"])
+
+
+commit_hooks.register(_PENDING_INVALIDATION, lambda: {"users": set(), "apps": set(), "all": False}, _invalidate)
+
+
+def _record(target, user_id=None, app_id=None, everything: bool = False) -> None:
+    def add(pending: dict) -> None:
+        if user_id:
+            pending["users"].add(user_id)
+        if app_id:
+            pending["apps"].add(app_id)
+        pending["all"] = pending["all"] or everything
+
+    commit_hooks.defer(target, _PENDING_INVALIDATION, add)
+
+
+@event.listens_for(AccessControl, 'after_insert')
+@event.listens_for(AccessControl, 'after_update')
+@event.listens_for(AccessControl, 'after_delete')
+def _access_control_changed(mapper, connection, target):
+    if target.subject_type == "app" and target.subject_id:
+        _record(target, app_id=target.subject_id)
+    else:
+        _record(target, everything=True)
+
+
+@event.listens_for(App, 'after_update')
+@event.listens_for(App, 'after_delete')
+def _app_changed(mapper, connection, target):
+    _record(target, app_id=target.id)
+
+
+@event.listens_for(Memory, 'after_insert')
+@event.listens_for(Memory, 'after_delete')
+def _memory_added_or_removed(mapper, connection, target):
+    # Only non-active rows are part of a permission set.
+    if target.state != MemoryState.active:
+        _record(target, user_id=target.user_id)
 
-    # If accessible_memory_ids is None, all memories are accessible
-    if accessible_memory_ids is None:
-        return True
 
-    # Check if memory is in the accessible set
-    return memory.id in accessible_memory_ids
+@event.listens_for(Memory, 'after_update')
+def _memory_state_changed(mapper, connection, target):
+    if sa.inspect(target).attrs.state.history.has_changes():
+        _record(target, user_id=target.user_id)
@@ -26,3 +26,11 @@ Guidelines:
 - If you cannot categorize the memory, return an empty list with key 'categories'.
 - Don't limit yourself to the categories listed above only. Feel free to create new categories based on the memory. Make sure that it is a single phrase.
 """
+
+# Same category list, with guidelines for categorizing many memories per call.
+BATCH_MEMORY_CATEGORIZATION_PROMPT = MEMORY_CATEGORIZATION_PROMPT.split("Guidelines:")[0] + """Guidelines:
+- The input is a JSON list of objects with 'index' and 'memory'. Categorize each memory independently.
+- Return one entry per input under the 'memories' key, each with the input's 'index' and its 'categories'.
+- If you cannot categorize a memory, return an empty 'categories' list for its index.
+- Don't limit yourself to the categories listed above only. Feel free to create new categories based on the memory. Make sure that it is a single phrase.
+"""
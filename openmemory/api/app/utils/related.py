@@ -0,0 +1,149 @@
+"""Related memories by vector similarity.
+
+A memory's neighbours are found with a nearest-neighbour query in the
+configured vector store, seeded with the memory's stored embedding (read back
+from Qdrant, re-embedded from content on stores that do not return vectors)
+and filtered to the owning user. Neighbour lists are cached per memory and
+stay valid until a committed change to one of the user's memories (insert,
+delete, content or state change) moves the user's generation on, since any
+such change can alter who the nearest neighbours are.
+"""
+
+import os
+import threading
+from collections import OrderedDict
+from typing import Dict, List, Optional, Tuple
+from uuid import UUID
+
+import sqlalchemy as sa
+from app.models import Memory
+from app.utils import commit_hooks
+from app.utils.vectors import fetch_stored_vectors
+from sqlalchemy import event
+
+Neighbours = List[Tuple[str, float]]
+
+
+class NeighbourCache:
+    """LRU of neighbour lists, each tagged with the owning user's generation."""
+
+    def __init__(self, max_entries: int = 2048):
+        self.max_entries = max_entries
+        self._lock = threading.Lock()
+        self._entries: "OrderedDict[Tuple[str, int], Tuple[UUID, int, Neighbours]]" = OrderedDict()
+        self._generations: Dict[UUID, int] = {}
+        self._hits = 0
+        self._misses = 0
+
+    def generation(self, user_id: UUID) -> int:
+        with self._lock:
+            return self._generations.get(user_id, 0)
+
+    def get(self, memory_id: str, user_id: UUID, limit: int) -> Optional[Neighbours]:
+        with self._lock:
+            entry = self._entries.get((memory_id, limit))
+            if entry is not None and entry[1] == self._generations.get(user_id, 0):
+                self._entries.move_to_end((memory_id, limit))
+                self._hits += 1
+                return entry[2]
+            self._misses += 1
+            return None
+
+    def put(self, memory_id: str, user_id: UUID, generation: int, limit: int, neighbours: Neighbours) -> None:
+        with self._lock:
+            # A list computed while the user's memories changed is already stale.
+            if generation != self._generations.get(user_id, 0):
+                return
+            self._entries[(memory_id, limit)] = (user_id, generation, neighbours)
+            self._entries.move_to_end((memory_id, limit))
+            while len(self._entries) > self.max_entries:
+                self._entries.popitem(last=False)
+
+    def invalidate_users(self, user_ids) -> None:
+        with self._lock:
+            for user_id in user_ids:
+                self._generations[user_id] = self._generations.get(user_id, 0) + 1
+            stale = [key for key, (user_id, _, _) in self._entries.items() if user_id in user_ids]
+            for key in stale:
+                del self._entries[key]
+
+    def stats(self) -> Dict[str, int]:
+        with self._lock:
+            return {"entries": len(self._entries), "hits": self._hits, "misses": self._misses}
+
+
+neighbour_cache = NeighbourCache(max_entries=int(os.getenv("RELATED_MEMORIES_CACHE_SIZE", "2048")))
+
+
+def _stored_embedding(memory_client, memory: Memory):
+    stored = fetch_stored_vectors(memory_client.vector_store, [str(memory.id)])
+    if stored:
+        return next(iter(stored.values()))
+    return memory_client.embedding_model.embed(memory.content, "search")
+
+
+def find_neighbours(memory_client, memory: Memory, user_id: str, limit: int) -> Neighbours:
+    """Up to ``limit`` nearest memories of the same user as (memory id, similarity), closest first."""
+    key = str(memory.id)
+    cached = neighbour_cache.get(key, memory.user_id, limit)
+    if cached is not None:
+        return cached
+
+    generation = neighbour_cache.generation(memory.user_id)
+    embedding = _stored_embedding(memory_client, memory)
+    if embedding is None:
+        return []
+    hits = memory_client.vector_store.search(
+        query=memory.content, vectors=embedding, top_k=limit + 1, filters={"user_id": user_id}
+    )
+    neighbours = [(str(hit.id), hit.score) for hit in hits if str(hit.id) != key][:limit]
+    neighbour_cache.put(key, memory.user_id, generation, limit, neighbours)
+    return neighbours
+
+
+def rank_related(
+    source: Memory, candidates: List[Memory], similarities: Dict[str, float], category_weight: float
+) -> List[Memory]:
+    """
+    Order candidates by similarity, optionally blended with category overlap.
+
+    The overlap is the share of the source memory's categories a candidate
+    has; ``category_weight`` in [0, 1] sets its weight against similarity.
+    """
+    source_categories = {category.id for category in source.categories}
+
+    def score(memory: Memory) -> float:
+        similarity = similarities.get(str(memory.id), 0.0)
+        if not category_weight or not source_categories:
+            return similarity
+        shared = source_categories & {category.id for category in memory.categories}
+        overlap = len(shared) / len(source_categories)
+        return (1 - category_weight) * similarity + category_weight * overlap
+
+    return sorted(candidates, key=score, reverse=True)
+
+
+# ---------------------------------------------------------------------------
+# Invalidation: any committed change to a user's memories moves their generation.
+# ---------------------------------------------------------------------------
+
+_PENDING_NEIGHBOURHOOD = "pending_neighbourhood_invalidation"
+
+commit_hooks.register(_PENDING_NEIGHBOURHOOD, set, neighbour_cache.invalidate_users)
+
+
+def _record(target: Memory) -> None:
+    commit_hooks.defer(target, _PENDING_NEIGHBOURHOOD, lambda user_ids: user_ids.add(target.user_id))
+
+
+@event.listens_for(Memory, 'after_insert')
+@event.listens_for(Memory, 'after_delete')
+def _memory_added_or_removed(mapper, connection, target):
+    _record(target)
+
+
+@event.listens_for(Memory, 'after_update')
+def _memory_changed(mapper, connection, target):
+    attrs = sa.inspect(target).attrs
+    if attrs.content.history.has_changes() or attrs.state.history.has_changes():
+        _record(target)
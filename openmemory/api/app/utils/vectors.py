@@ -0,0 +1,33 @@
+"""Read stored embeddings back from the vector store.
+
+mem0's vector store interface returns payloads and scores but not vectors,
+so this reaches into the providers that can return them natively. Callers
+treat a missing id as "no stored vector" and re-embed the content.
+"""
+
+from typing import Dict, List
+
+
+def fetch_stored_vectors(vector_store, ids: List[str]) -> Dict[str, List[float]]:
+    """Dense vectors for ``ids`` keyed by id; empty for stores that cannot return vectors."""
+    if not ids:
+        return {}
+    try:
+        from mem0.vector_stores.qdrant import Qdrant
+    except ImportError:
+        return {}
+    if not isinstance(vector_store, Qdrant):
+        return {}
+
+    records = vector_store.client.retrieve(
+        collection_name=vector_store.collection_name, ids=ids, with_vectors=True, with_payload=False
+    )
+    vectors = {}
+    for record in records:
+        vector = record.vector
+        # Collections with a BM25 slot store the dense vector under the "" name.
+        if isinstance(vector, dict):
+            vector = vector.get("")
+        if vector is not None:
+            vectors[str(record.id)] = vector
+    return vectors
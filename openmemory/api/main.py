@@ -3,9 +3,11 @@ from uuid import uuid4
 
 from app.config import DEFAULT_APP_ID, USER_ID
 from app.database import Base, SessionLocal, engine
-from app.mcp_server import setup_mcp_server
-from app.models import App, User
+from app.mcp_server import mcp_sessions, setup_mcp_server
+from app.models import App, User, access_log_sink
 from app.routers import apps_router, backup_router, config_router, memories_router, stats_router
+from app.utils.fulltext import create_fulltext_index
+from app.utils.memory import memory_client_pool
 from fastapi import FastAPI
 from fastapi.middleware.cors import CORSMiddleware
 from fastapi_pagination import add_pagination
@@ -23,6 +25,10 @@ app.add_middleware(
 # Create all tables
 Base.metadata.create_all(bind=engine)
 
+# Full-text index for memory search (FTS5 on SQLite, GIN on Postgres)
+with engine.begin() as connection:
+    create_fulltext_index(connection)
+
 # Check for USER_ID and create default user if needed
 def create_default_user():
     db = SessionLocal()
@@ -87,3 +93,22 @@ app.include_router(backup_router)
 
 # Add pagination support
 add_pagination(app)
+
+
+@app.on_event("startup")
+def warm_memory_client():
+    # Build and warm the memory client in the background so the first
+    # request does not pay for it.
+    memory_client_pool.refresh()
+
+
+@app.on_event("shutdown")
+def flush_access_logs():
+    # Write out access logs still buffered in memory before the process exits.
+    access_log_sink.flush()
+
+
+@app.on_event("shutdown")
+async def close_mcp_sessions():
+    # End persistent MCP sessions so their server tasks exit cleanly.
+    await mcp_sessions.close_all()
@@ -0,0 +1,157 @@
+"""Backup export/import throughput and peak memory.
+
+Seeds a temporary SQLite database with N memories for one user, streams an
+export (with synthetic embeddings standing in for the vector store) to a
+file, then imports it into a fresh database with a stub memory client. Prints
+memories/s for each phase and the process's peak RSS, which should stay flat
+as N grows.
+
+    python scripts/backup_benchmark.py [--memories 100000] [--dims 1536]
+"""
+
+import argparse
+import os
+import random
+import resource
+import sys
+import tempfile
+import time
+import uuid
+import zipfile
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+os.environ.setdefault("OPENAI_API_KEY", "benchmark")
+
+from sqlalchemy import create_engine, insert  # noqa: E402
+from sqlalchemy.orm import sessionmaker  # noqa: E402
+
+
+class _StubVectorStore:
+    def insert(self, vectors, payloads, ids):
+        pass
+
+
+class _StubEmbedder:
+    def __init__(self, dims):
+        self.dims = dims
+
+    def embed_batch(self, texts, memory_action="add"):
+        return [[0.0] * self.dims for _ in texts]
+
+
+class _StubMemoryClient:
+    def __init__(self, dims):
+        self.vector_store = _StubVectorStore()
+        self.embedding_model = _StubEmbedder(dims)
+
+
+def _seed_id():
+    # SQLite gives the UUID column numeric affinity, so an all-digit hex
+    # string (possibly with one "e") would be stored as a number; at a million
+    # rows that happens, so keep seeded ids unambiguous.
+    while True:
+        value = uuid.uuid4()
+        if any(c in "abcdf" for c in value.hex):
+            return value
+
+
+def _peak_rss_mb():
+    return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1024
+
+
+def _seed(session_factory, count):
+    from app.models import App, Memory, MemoryState, User
+
+    db = session_factory()
+    user = User(id=uuid.uuid4(), user_id="source")
+    app = App(id=uuid.uuid4(), name="openmemory", owner=user)
+    db.add_all([user, app])
+    db.commit()
+    user_pk, app_pk = user.id, app.id
+    for start in range(0, count, 10_000):
+        rows = [
+            {
+                "id": _seed_id(),
+                "user_id": user_pk,
+                "app_id": app_pk,
+                "content": f"memory {i}: prefers window seats on long flights",
+                "metadata_": {"n": i},
+                "state": MemoryState.active,
+            }
+            for i in range(start, min(count, start + 10_000))
+        ]
+        # Core inserts skip the categorization hooks.
+        db.execute(insert(Memory), rows)
+        db.commit()
+    db.close()
+    return user_pk
+
+
+def _database(path, base):
+    engine = create_engine(f"sqlite:///{path}")
+    base.metadata.create_all(engine)
+    return sessionmaker(bind=engine)
+
+
+def run(args):
+    from app import models
+    from app.database import Base
+    from app.models import User
+    from app.utils import backup
+
+    models.categorization_queue.enqueue = lambda memory_id, content: False
+    backup.BACKUP_BATCH_SIZE = args.batch_size
+    rng = random.Random(0)
+    vector = [rng.random() for _ in range(args.dims)]
+    backup.fetch_stored_vectors = lambda store, ids: {i: vector for i in ids}
+
+    with tempfile.TemporaryDirectory() as tmp:
+        session_factory = _database(os.path.join(tmp, "source.db"), Base)
+
+        started = time.perf_counter()
+        user_pk = _seed(session_factory, args.memories)
+        print(f"seeded {args.memories} memories in {time.perf_counter() - started:.1f}s, "
+              f"peak RSS {_peak_rss_mb():.0f} MB")
+
+        path = os.path.join(tmp, "export.zip")
+        options = backup.ExportOptions(include_vectors=not args.no_vectors)
+        started = time.perf_counter()
+        with open(path, "wb") as out:
+            for chunk in backup.stream_export(session_factory, user_pk, options, _StubVectorStore()):
+                out.write(chunk)
+        elapsed = time.perf_counter() - started
+        print(f"export: {args.memories / elapsed:8.0f} memories/s  {elapsed:6.1f}s  "
+              f"{os.path.getsize(path) / 1e6:.0f} MB zip  peak RSS {_peak_rss_mb():.0f} MB")
+
+        # Restore onto a fresh instance, as when migrating a user.
+        db = _database(os.path.join(tmp, "target.db"), Base)()
+        target = User(id=uuid.uuid4(), user_id="target")
+        db.add(target)
+        db.commit()
+        started = time.perf_counter()
+        with zipfile.ZipFile(path) as zf:
+            manifest, memories, history = backup.read_backup(zf)
+            importer = backup.BackupImporter(db, target, "target", "overwrite", _StubMemoryClient(args.dims))
+            importer.import_categories(manifest.get("categories", []))
+            for batch in backup.batched(memories, args.batch_size):
+                importer.import_memories(batch)
+            for batch in backup.batched(history, args.batch_size):
+                importer.import_history(batch)
+        elapsed = time.perf_counter() - started
+        print(f"import: {args.memories / elapsed:8.0f} memories/s  {elapsed:6.1f}s  "
+              f"peak RSS {_peak_rss_mb():.0f} MB  {importer.stats}")
+        db.close()
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--memories", type=int, default=100_000)
+    parser.add_argument("--dims", type=int, default=1536, help="Embedding dimensions written to the export.")
+    parser.add_argument("--batch-size", type=int, default=1000)
+    parser.add_argument("--no-vectors", action="store_true", help="Export without embeddings.")
+    run(parser.parse_args())
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
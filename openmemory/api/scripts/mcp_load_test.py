@@ -0,0 +1,106 @@
+"""Streamable HTTP MCP tool-call latency with and without a session.
+
+Drives the MCP router in process (httpx ASGI transport, no network) with a
+trivial tool so the numbers reflect transport and server overhead only.
+Stateless requests start a transport and server run each; session requests
+reuse the server run opened by ``initialize``. Prints p50/p99 per mode.
+
+    python scripts/mcp_load_test.py [--requests 2000] [--concurrency 8]
+"""
+
+import argparse
+import asyncio
+import logging
+import os
+import statistics
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+os.environ.setdefault("OPENAI_API_KEY", "benchmark")
+
+from fastapi import FastAPI  # noqa: E402
+from httpx import ASGITransport, AsyncClient  # noqa: E402
+
+from app.mcp_server import mcp, mcp_router, mcp_sessions  # noqa: E402
+
+HEADERS = {"Accept": "application/json, text/event-stream"}
+URL = "/mcp/load-test/http/bench"
+INITIALIZE = {
+    "jsonrpc": "2.0",
+    "id": 0,
+    "method": "initialize",
+    "params": {
+        "protocolVersion": "2025-03-26",
+        "capabilities": {},
+        "clientInfo": {"name": "load-test", "version": "0.1.0"},
+    },
+}
+
+
+@mcp.tool(name="_load_test_echo")
+async def _echo() -> str:
+    return "ok"
+
+
+def _call(req_id):
+    return {"jsonrpc": "2.0", "id": req_id, "method": "tools/call", "params": {"name": "_load_test_echo"}}
+
+
+async def _open_session(client):
+    resp = await client.post(URL, json=INITIALIZE, headers=HEADERS)
+    headers = {**HEADERS, "mcp-session-id": resp.headers["mcp-session-id"], "mcp-protocol-version": "2025-03-26"}
+    await client.post(URL, json={"jsonrpc": "2.0", "method": "notifications/initialized"}, headers=headers)
+    return headers
+
+
+async def _run(client, headers, requests, concurrency):
+    latencies = []
+    counter = iter(range(1, requests + 1))
+
+    async def worker():
+        for req_id in counter:
+            started = time.perf_counter()
+            resp = await client.post(URL, json=_call(req_id), headers=headers)
+            latencies.append(time.perf_counter() - started)
+            if resp.status_code != 200:
+                raise RuntimeError(f"request {req_id} failed: {resp.status_code} {resp.text}")
+
+    started = time.perf_counter()
+    await asyncio.gather(*(worker() for _ in range(concurrency)))
+    return latencies, time.perf_counter() - started
+
+
+def _report(mode, latencies, elapsed):
+    ordered = sorted(latencies)
+    p99 = ordered[min(len(ordered) - 1, int(len(ordered) * 0.99))]
+    print(
+        f"{mode:<10} {len(ordered) / elapsed:8.0f} req/s"
+        f"  p50 {statistics.median(ordered) * 1000:6.2f} ms  p99 {p99 * 1000:6.2f} ms"
+    )
+
+
+async def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--requests", type=int, default=2000)
+    parser.add_argument("--concurrency", type=int, default=8)
+    args = parser.parse_args()
+    # Per-request INFO logs from the MCP server would dominate the timings.
+    logging.disable(logging.INFO)
+    mcp_sessions.max_concurrent_per_client = max(mcp_sessions.max_concurrent_per_client, args.concurrency)
+
+    app = FastAPI()
+    app.include_router(mcp_router)
+    async with AsyncClient(transport=ASGITransport(app=app), base_url="http://bench") as client:
+        session_headers = await _open_session(client)
+        # Warm both paths before measuring.
+        await _run(client, HEADERS, 50, args.concurrency)
+        await _run(client, session_headers, 50, args.concurrency)
+
+        _report("stateless", *await _run(client, HEADERS, args.requests, args.concurrency))
+        _report("session", *await _run(client, session_headers, args.requests, args.concurrency))
+    await mcp_sessions.close_all()
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
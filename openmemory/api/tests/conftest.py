@@ -0,0 +1,44 @@
+"""Shared fixtures for the OpenMemory API tests."""
+
+import os
+
+# Set dummy keys before any imports that trigger client initialization
+os.environ.setdefault("OPENAI_API_KEY", "test-key")
+
+import pytest
+from sqlalchemy import create_engine
+from sqlalchemy.orm import sessionmaker
+
+from app.database import Base
+from app.utils.permissions import permission_cache
+
+
+@pytest.fixture
+def engine(tmp_path):
+    """A SQLite database with the OpenMemory schema.
+
+    File-backed rather than ``sqlite://`` so connections opened by worker
+    threads see the same tables.
+    """
+    engine = create_engine(f"sqlite:///{tmp_path / 'openmemory.db'}")
+    Base.metadata.create_all(engine)
+    yield engine
+    engine.dispose()
+
+
+@pytest.fixture
+def session_factory(engine):
+    return sessionmaker(bind=engine)
+
+
+@pytest.fixture
+def db(session_factory):
+    session = session_factory()
+    yield session
+    session.close()
+
+
+@pytest.fixture(autouse=True)
+def _fresh_permission_cache():
+    # The cache is process-wide; entries from another test's database must not leak.
+    permission_cache.invalidate(everything=True)
@@ -0,0 +1,121 @@
+"""Tests for the batched access-log sink.
+
+Reads only buffer access events; one worker thread writes them with a
+multi-row insert per batch, on size or on a timer, and a full buffer drops
+events according to the overflow policy instead of blocking.
+"""
+
+import threading
+import time
+import uuid
+
+import pytest
+from sqlalchemy import event
+
+from app.models import App, Memory, MemoryAccessLog, User
+from app.utils.access_log import AccessLogSink
+
+
+class Recorder:
+    def __init__(self):
+        self.batches = []
+
+    def write(self, rows):
+        self.batches.append(list(rows))
+
+
+def test_events_are_written_in_batches():
+    rec = Recorder()
+    sink = AccessLogSink(rec.write, batch_size=50, flush_interval=5)
+    for _ in range(100):
+        sink.record(uuid.uuid4(), uuid.uuid4(), "search", {"query": "q"})
+    assert sink.flush(timeout=5)
+
+    assert [len(b) for b in rec.batches] == [50, 50]
+    stats = sink.stats()
+    assert stats["written"] == 100
+    assert stats["batches"] == 2
+    assert stats["queued"] == 0
+
+
+def test_partial_batch_is_flushed_on_the_timer():
+    rec = Recorder()
+    sink = AccessLogSink(rec.write, batch_size=100, flush_interval=0.05)
+    sink.record(uuid.uuid4(), uuid.uuid4(), "list")
+    deadline = time.monotonic() + 5
+    while not rec.batches and time.monotonic() < deadline:
+        time.sleep(0.01)
+    assert len(rec.batches) == 1
+    assert rec.batches[0][0]["access_type"] == "list"
+
+
+@pytest.mark.parametrize("overflow, kept", [("drop_newest", ["a0", "a1"]), ("drop_oldest", ["a2", "a3"])])
+def test_full_buffer_applies_overflow_policy_without_blocking(overflow, kept):
+    release = threading.Event()
+    written = []
+
+    def blocked_write(rows):
+        release.wait(timeout=5)
+        written.extend(rows)
+
+    sink = AccessLogSink(blocked_write, max_queue=2, batch_size=1, flush_interval=0, overflow=overflow)
+    sink.record(uuid.uuid4(), None, "first")
+    while sink.stats()["in_flight"] == 0:
+        time.sleep(0.001)
+
+    start = time.monotonic()
+    for i in range(4):
+        sink.record(uuid.uuid4(), None, f"a{i}")
+    assert time.monotonic() - start < 0.5
+    release.set()
+    assert sink.flush(timeout=5)
+
+    assert [row["access_type"] for row in written] == ["first", *kept]
+    assert sink.stats()["dropped"] == 2
+
+
+def test_unknown_overflow_policy_is_rejected():
+    with pytest.raises(ValueError):
+        AccessLogSink(lambda rows: None, overflow="block")
+
+
+def test_bulk_insert_into_database_isolates_bad_rows(engine, session_factory):
+    @event.listens_for(engine, "connect")
+    def _enable_foreign_keys(dbapi_connection, _):
+        dbapi_connection.execute("PRAGMA foreign_keys=ON")
+
+    # Drop the connection pooled by create_all so every connection gets the pragma.
+    engine.dispose()
+    Session = session_factory
+    db = Session()
+    user = User(id=uuid.uuid4(), user_id="u1")
+    app = App(id=uuid.uuid4(), name="app", owner=user)
+    memory = Memory(id=uuid.uuid4(), user=user, app=app, content="I like tea")
+    db.add_all([user, app, memory])
+    db.commit()
+
+    statements = []
+    event.listen(engine, "before_cursor_execute", lambda *args: statements.append(args[2]))
+
+    def write(rows):
+        session = Session()
+        try:
+            session.execute(MemoryAccessLog.__table__.insert(), rows)
+            session.commit()
+        finally:
+            session.close()
+
+    sink = AccessLogSink(write, batch_size=10, flush_interval=5)
+    for _ in range(3):
+        sink.record(memory.id, app.id, "search", {"query": "tea"})
+    assert sink.flush(timeout=5)
+    assert db.query(MemoryAccessLog).count() == 3
+    assert sum("INSERT INTO memory_access_logs" in s for s in statements) == 1
+
+    # A hit with no memory row fails the batch; the valid rows still land.
+    sink.record(memory.id, app.id, "search")
+    sink.record(uuid.uuid4(), app.id, "search")
+    assert sink.flush(timeout=5)
+    assert db.query(MemoryAccessLog).count() == 4
+    assert sink.stats()["failed"] == 1
+    db.close()
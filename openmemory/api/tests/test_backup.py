@@ -0,0 +1,205 @@
+"""Tests for streaming backup export and batched import.
+
+Exports are written to an unseekable sink and yielded in chunks; imports
+process records in batches, restore stored embeddings without re-embedding,
+and still accept version 1 backups.
+"""
+
+import io
+import json
+import uuid
+import zipfile
+from unittest.mock import MagicMock
+
+import pytest
+from app import models
+from app.models import App, Category, Memory, MemoryState, MemoryStatusHistory, User
+from app.utils import backup
+from app.utils.backup import BackupImporter, ExportOptions, batched, read_backup, stream_export
+
+
+@pytest.fixture
+def session_factory(session_factory, monkeypatch):
+    enqueued = []
+    monkeypatch.setattr(models.categorization_queue, "enqueue", lambda mid, content: enqueued.append(mid))
+    session_factory.enqueued = enqueued
+    return session_factory
+
+
+@pytest.fixture
+def seeded(session_factory):
+    db = session_factory()
+    user = User(id=uuid.uuid4(), user_id="alice")
+    app = App(id=uuid.uuid4(), name="cursor", owner=user)
+    food = Category(id=uuid.uuid4(), name="food")
+    memories = [
+        Memory(id=uuid.uuid4(), user=user, app=app, content=f"fact {i}", metadata_={"i": i}) for i in range(7)
+    ]
+    memories[0].categories.append(food)
+    memories[1].state = MemoryState.archived
+    db.add_all([user, app, food, *memories])
+    db.flush()
+    db.add(MemoryStatusHistory(
+        id=uuid.uuid4(), memory_id=memories[1].id, changed_by=user.id,
+        old_state=MemoryState.active, new_state=MemoryState.archived,
+    ))
+    db.commit()
+    ids = [m.id for m in memories]
+    user_pk = user.id
+    db.close()
+    return user_pk, ids
+
+
+def _export(session_factory, user_pk, vectors=None, monkeypatch=None, **options):
+    if vectors is not None:
+        monkeypatch.setattr(backup, "fetch_stored_vectors", lambda store, ids: {i: vectors[i] for i in ids})
+    chunks = list(stream_export(session_factory, user_pk, ExportOptions(**options), MagicMock()))
+    return chunks, zipfile.ZipFile(io.BytesIO(b"".join(chunks)))
+
+
+def test_export_streams_a_v2_zip_in_keyset_batches(session_factory, seeded, monkeypatch):
+    user_pk, ids = seeded
+    monkeypatch.setattr(backup, "BACKUP_BATCH_SIZE", 3)
+    monkeypatch.setattr(backup, "EXPORT_CHUNK_SIZE", 1)
+    vectors = {str(i): [0.5, -1.25, 3.0] for i in ids}
+
+    chunks, zf = _export(session_factory, user_pk, vectors, monkeypatch)
+    assert len(chunks) > 2
+
+    manifest, memories, history = read_backup(zf)
+    assert manifest["version"] == "2"
+    assert [c["name"] for c in manifest["categories"]] == ["food"]
+    records = list(memories)
+    assert sorted(r["id"] for r in records) == sorted(str(i) for i in ids)
+    by_id = {r["id"]: r for r in records}
+    assert by_id[str(ids[0])]["categories"] == ["food"]
+    assert by_id[str(ids[1])]["state"] == "archived"
+    assert all(r["app"] == "cursor" for r in records)
+    assert backup._decode_vector(records[0]["embedding"]) == [0.5, -1.25, 3.0]
+    assert [h["new_state"] for h in history] == ["archived"]
+
+
+def test_export_without_vectors_leaves_out_embeddings(session_factory, seeded, monkeypatch):
+    user_pk, _ = seeded
+    monkeypatch.setattr(backup, "fetch_stored_vectors", MagicMock(side_effect=AssertionError))
+    _, zf = _export(session_factory, user_pk, include_vectors=False)
+    _, memories, _ = read_backup(zf)
+    assert all("embedding" not in r for r in memories)
+
+
+def _target_user(session_factory, user_id="bob"):
+    db = session_factory()
+    user = User(id=uuid.uuid4(), user_id=user_id)
+    db.add(user)
+    db.commit()
+    return db, user
+
+
+def _memory_client(dims=3):
+    client = MagicMock()
+    client.embedding_model.embed_batch.side_effect = lambda texts, action: [[1.0] * dims for _ in texts]
+    return client
+
+
+def test_import_restores_embeddings_and_embeds_only_missing_ones(session_factory, seeded, monkeypatch):
+    user_pk, ids = seeded
+    vectors = {str(i): [0.25, 0.5, 0.75] for i in ids[:4]}
+    monkeypatch.setattr(
+        backup, "fetch_stored_vectors", lambda store, batch: {i: vectors[i] for i in batch if i in vectors}
+    )
+    _, zf = _export(session_factory, user_pk)
+    manifest, memories, history = read_backup(zf)
+
+    db, user = _target_user(session_factory)
+    user_pk = user.id
+    session_factory.enqueued.clear()
+    client = _memory_client()
+    importer = BackupImporter(db, user, "bob", "overwrite", client)
+    importer.import_categories(manifest["categories"])
+    for batch in batched(memories, 3):
+        importer.import_memories(batch)
+    for batch in batched(history, 3):
+        importer.import_history(batch)
+
+    # Cross-user collisions get new ids; categories and history follow them.
+    imported = db.query(Memory).filter(Memory.user_id == user_pk).all()
+    assert len(imported) == 7 and not {m.id for m in imported} & set(ids)
+    categorized = [m for m in imported if m.categories]
+    assert [c.name for c in categorized[0].categories] == ["food"]
+    history_rows = db.query(MemoryStatusHistory).filter(MemoryStatusHistory.memory_id.in_([m.id for m in imported]))
+    assert history_rows.count() == 1
+    # Restored categories are not sent back to the LLM.
+    assert categorized[0].id not in session_factory.enqueued
+    assert len(session_factory.enqueued) == 6
+
+    assert importer.stats["memories_imported"] == 7
+    assert importer.stats["embeddings_restored"] == 4
+    assert importer.stats["embeddings_computed"] == 3
+    assert client.vector_store.insert.call_count == 3  # one upsert per batch
+    inserted = [v for call in client.vector_store.insert.call_args_list for v in call.kwargs["vectors"]]
+    assert inserted.count([0.25, 0.5, 0.75]) == 4
+
+
+def test_import_reembeds_batch_when_stored_vectors_are_rejected(session_factory, seeded, monkeypatch):
+    user_pk, ids = seeded
+    monkeypatch.setattr(backup, "fetch_stored_vectors", lambda store, batch: {i: [0.1, 0.2] for i in batch})
+    _, zf = _export(session_factory, user_pk)
+    _, memories, _ = read_backup(zf)
+
+    db, user = _target_user(session_factory)
+    client = _memory_client()
+    client.vector_store.insert.side_effect = [ValueError("dimension mismatch"), None]
+    importer = BackupImporter(db, user, "bob", "overwrite", client)
+    importer.import_memories(list(memories))
+
+    assert client.vector_store.insert.call_count == 2
+    assert all(len(v) == 3 for v in client.vector_store.insert.call_args.kwargs["vectors"])
+    assert importer.stats["embeddings_computed"] == 7
+    assert importer.stats["vector_failures"] == 0
+
+
+def test_import_skip_mode_keeps_existing_rows(session_factory, seeded):
+    user_pk, ids = seeded
+    _, zf = _export(session_factory, user_pk, include_vectors=False)
+    _, memories, _ = read_backup(zf)
+    records = list(memories)
+    next(r for r in records if r["id"] == str(ids[0]))["content"] = "changed"
+
+    db = session_factory()
+    owner = db.get(User, user_pk)
+    importer = BackupImporter(db, owner, "alice", "skip", None)
+    importer.import_memories(records)
+    assert importer.stats["memories_skipped"] == 7
+    assert db.get(Memory, ids[0]).content == "fact 0"
+
+    importer = BackupImporter(db, db.get(User, user_pk), "alice", "overwrite", None)
+    importer.import_memories(records)
+    assert db.get(Memory, ids[0]).content == "changed"
+
+
+def test_reads_version_1_backups():
+    memory_id, category_id = str(uuid.uuid4()), str(uuid.uuid4())
+    legacy = {
+        "categories": [{"id": category_id, "name": "food"}],
+        "memories": [{"id": memory_id, "content": "likes tea", "state": "active"}],
+        "memory_categories": [{"memory_id": memory_id, "category_id": category_id}],
+        "status_history": [],
+    }
+    buf = io.BytesIO()
+    with zipfile.ZipFile(buf, "w") as zf:
+        zf.writestr("memories.json", json.dumps(legacy))
+
+    manifest, memories, history = read_backup(zipfile.ZipFile(buf))
+    assert manifest["categories"][0]["name"] == "food"
+    assert [(m["id"], m["category_ids"]) for m in memories] == [(memory_id, [category_id])]
+    assert list(history) == []
+
+    with pytest.raises(ValueError):
+        read_backup(zipfile.ZipFile(io.BytesIO(_zip_with("other.txt"))))
+
+
+def _zip_with(name):
+    buf = io.BytesIO()
+    with zipfile.ZipFile(buf, "w") as zf:
+        zf.writestr(name, "x")
+    return buf.getvalue()
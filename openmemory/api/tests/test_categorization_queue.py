@@ -0,0 +1,120 @@
+"""Tests for the background categorization queue.
+
+Memories are categorized off the write path, many per LLM call, with
+identical content categorized once, and only after the inserting
+transaction commits.
+"""
+
+import threading
+import time
+import uuid
+from unittest.mock import patch
+
+from app.models import App, Memory, User
+from app.utils.categorization_queue import CategorizationQueue
+
+
+class Recorder:
+    def __init__(self):
+        self.calls = []
+        self.writes = {}
+
+    def categorize(self, texts):
+        self.calls.append(list(texts))
+        return [[f"cat-{t}"] for t in texts]
+
+    def write(self, assignments):
+        self.writes.update(assignments)
+
+
+def test_batches_many_memories_into_one_call():
+    rec = Recorder()
+    queue = CategorizationQueue(rec.categorize, rec.write, batch_size=10, max_wait=0.2)
+    for i in range(10):
+        queue.enqueue(f"m{i}", f"text {i}")
+    assert queue.flush(timeout=5)
+
+    assert len(rec.calls) == 1
+    assert sorted(rec.calls[0]) == sorted(f"text {i}" for i in range(10))
+    assert rec.writes["m3"] == ["cat-text 3"]
+    stats = queue.stats()
+    assert stats["depth"] == 0
+    assert stats["processed"] == 10
+    assert stats["llm_calls"] == 1
+    assert stats["last_batch_lag_seconds"] > 0
+
+
+def test_identical_content_is_categorized_once():
+    rec = Recorder()
+    queue = CategorizationQueue(rec.categorize, rec.write, batch_size=10, max_wait=0.2)
+    queue.enqueue("a", "I like tea")
+    queue.enqueue("b", "I like tea ")
+    assert queue.flush(timeout=5)
+    queue.enqueue("c", "I like tea")
+    assert queue.flush(timeout=5)
+
+    assert rec.calls == [["I like tea"]]
+    assert rec.writes == {"a": ["cat-I like tea"], "b": ["cat-I like tea"], "c": ["cat-I like tea"]}
+    stats = queue.stats()
+    assert stats["dedup_hits"] == 1
+    assert stats["cache_hits"] == 1
+
+
+def test_queued_edit_supersedes_older_content():
+    rec = Recorder()
+    queue = CategorizationQueue(rec.categorize, rec.write, batch_size=10, max_wait=0.2)
+    queue.enqueue("m1", "old text")
+    queue.enqueue("m1", "new text")
+    assert queue.flush(timeout=5)
+    assert rec.writes == {"m1": ["cat-new text"]}
+
+
+def test_full_queue_drops_and_failures_are_counted():
+    release = threading.Event()
+
+    def slow_categorize(texts):
+        release.wait(timeout=5)
+        raise RuntimeError("llm down")
+
+    queue = CategorizationQueue(slow_categorize, lambda a: None, batch_size=1, max_wait=0, max_pending=1)
+    assert queue.enqueue("m1", "one")
+    while queue.stats()["in_flight"] == 0:
+        time.sleep(0.001)
+    assert queue.enqueue("m2", "two")
+    assert not queue.enqueue("m3", "three")
+    release.set()
+    assert queue.flush(timeout=5)
+    stats = queue.stats()
+    assert stats["dropped"] == 1
+    assert stats["failed"] == 2
+
+
+def test_memories_are_queued_only_after_commit(session_factory):
+    db = session_factory()
+    user = User(id=uuid.uuid4(), user_id="u1")
+    app = App(id=uuid.uuid4(), name="app", owner=user)
+    db.add_all([user, app])
+    db.commit()
+
+    with patch("app.models.categorization_queue") as queue:
+        memory = Memory(id=uuid.uuid4(), user=user, app=app, content="I like tea")
+        db.add(memory)
+        db.flush()
+        queue.enqueue.assert_not_called()
+        db.commit()
+        queue.enqueue.assert_called_once_with(memory.id, "I like tea")
+
+        # Edits that leave the content alone do not re-categorize.
+        memory.metadata_ = {"source": "test"}
+        db.commit()
+        assert queue.enqueue.call_count == 1
+        memory.content = "I like coffee"
+        db.commit()
+        queue.enqueue.assert_called_with(memory.id, "I like coffee")
+
+        db.add(Memory(id=uuid.uuid4(), user=user, app=app, content="rolled back"))
+        db.flush()
+        db.rollback()
+        db.commit()
+        assert queue.enqueue.call_count == 2
+    db.close()
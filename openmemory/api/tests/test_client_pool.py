@@ -0,0 +1,178 @@
+"""Tests for the memory client pool.
+
+Clients are built and warmed on a background thread and swapped in
+atomically when the config changes; ``get`` never constructs a client on the
+caller's thread.
+"""
+
+import threading
+import time
+
+from app.utils.client_pool import ClientPool, config_hash
+
+
+class _Factory:
+    def __init__(self):
+        self.calls = []
+        self.release = threading.Event()
+        self.release.set()
+        self.threads = set()
+
+    def __call__(self, config):
+        self.threads.add(threading.current_thread().name)
+        self.release.wait(5)
+        if config.get("broken"):
+            raise RuntimeError("cannot connect")
+        self.calls.append(config)
+        return {"client": dict(config)}
+
+
+def _pool(configs, factory, **kwargs):
+    return ClientPool(load_config=lambda: dict(configs[-1]), factory=factory, **kwargs)
+
+
+def test_get_never_builds_on_the_caller_thread():
+    factory = _Factory()
+    factory.release.clear()
+    pool = _pool([{"v": 1}], factory)
+
+    assert pool.get() is None  # queues the first build instead of running it
+    assert pool.stats()["building"]
+    factory.release.set()
+    assert pool.get(wait=5) == {"client": {"v": 1}}
+    assert factory.threads == {"memory-client-pool"}
+    assert pool.stats()["misses"] == 1
+
+
+def test_refresh_keeps_serving_the_old_client_until_the_new_one_is_warm():
+    configs = [{"v": 1}]
+    factory = _Factory()
+    warmed = []
+    pool = _pool(configs, factory, warmup=warmed.append)
+    pool.refresh()
+    assert pool.wait_ready()
+    old = pool.get()
+
+    configs.append({"v": 2})
+    factory.release.clear()
+    pool.refresh()
+    assert pool.get() is old
+    factory.release.set()
+    assert pool.wait_ready()
+
+    assert pool.get() == {"client": {"v": 2}}
+    assert warmed == [old, pool.get()]
+    stats = pool.stats()
+    assert stats["ready"] and stats["swaps"] == 2 and stats["instances"] == 2
+    assert stats["active_config_hash"] == config_hash({"v": 2})
+    assert stats["startup_seconds"] is not None
+    assert set(stats["last_build"]) == {"config_hash", "build_seconds", "warmup_seconds", "total_seconds"}
+
+
+def test_unchanged_config_reuses_the_built_instance():
+    configs = [{"v": 1}]
+    factory = _Factory()
+    pool = _pool(configs, factory, max_instances=2)
+    pool.refresh()
+    pool.wait_ready()
+    configs.append({"v": 2})
+    pool.refresh()
+    pool.wait_ready()
+    configs.append({"v": 1})
+    pool.refresh()
+    pool.wait_ready()
+
+    # Switching back to an already-built config is a swap, not a rebuild.
+    assert len(factory.calls) == 2
+    assert pool.get() == {"client": {"v": 1}}
+    assert pool.stats()["swaps"] == 3
+
+
+def test_failed_build_keeps_previous_client_and_reports_error():
+    configs = [{"v": 1}]
+    pool = _pool(configs, _Factory())
+    pool.refresh()
+    pool.wait_ready()
+    old = pool.get()
+
+    configs.append({"broken": True})
+    pool.refresh()
+    pool.wait_ready()
+    assert pool.get() is old
+    stats = pool.stats()
+    assert stats["failures"] == 1 and stats["last_error"] == "cannot connect"
+
+
+def test_failed_first_build_returns_none_without_waiting():
+    pool = _pool([{"broken": True}], _Factory())
+    pool.refresh()
+    pool.wait_ready()
+    assert pool.get(wait=5) is None
+    assert not pool.stats()["ready"]
+
+
+def test_failed_first_build_is_retried_after_backoff():
+    attempts = []
+
+    def factory(config):
+        attempts.append(config)
+        if len(attempts) == 1:
+            raise RuntimeError("cannot connect")
+        return {"client": dict(config)}
+
+    pool = _pool([{"v": 1}], factory, retry_seconds=0.05)
+    pool.refresh()
+    pool.wait_ready()
+    assert pool.get() is None  # still backing off
+
+    # The vector store came back; no refresh() is needed to pick it up.
+    time.sleep(0.06)
+    assert pool.get(wait=5) == {"client": {"v": 1}}
+    stats = pool.stats()
+    assert stats["ready"] and stats["last_error"] is None and len(attempts) == 2
+
+
+def test_failed_variant_build_is_retried_with_growing_backoff():
+    attempts = []
+
+    def factory(config):
+        attempts.append(config)
+        if config.get("custom_fact_extraction_prompt") and len(attempts) < 4:
+            raise RuntimeError("cannot connect")
+        return {"client": dict(config)}
+
+    pool = _pool([{"v": 1}], factory, retry_seconds=0.2)
+    pool.refresh()
+    pool.wait_ready()
+
+    assert pool.get("be brief", wait=5) is None
+    assert pool.get("be brief") is None  # backing off: no new build queued
+    pool.wait_ready()
+    assert len(attempts) == 2
+    time.sleep(0.25)
+    assert pool.get("be brief", wait=5) is None
+    time.sleep(0.25)
+    assert pool.get("be brief") is None  # second delay is twice the first
+    time.sleep(0.2)
+    client = pool.get("be brief", wait=5)
+    assert client["client"]["custom_fact_extraction_prompt"] == "be brief"
+    assert len(attempts) == 4
+
+
+def test_custom_instructions_get_their_own_instance_and_old_ones_are_evicted():
+    factory = _Factory()
+    pool = _pool([{"v": 1}], factory, max_instances=2)
+    pool.refresh()
+    pool.wait_ready()
+    base = pool.get()
+
+    a = pool.get("be brief", wait=5)
+    assert a["client"]["custom_fact_extraction_prompt"] == "be brief"
+    assert pool.get("be brief") is a
+    b = pool.get("be thorough", wait=5)
+    assert b is not a
+
+    # The active instance survives eviction; the least recently used variant goes.
+    assert pool.get() is base
+    assert pool.stats()["instances"] == 2
+    assert pool.get("be brief") is None
@@ -0,0 +1,143 @@
+"""Tests for full-text memory search and the SQL access predicate.
+
+List and filter endpoints match search text through the FTS5 index (SQLite)
+instead of an ILIKE scan, and filter by app access in SQL instead of checking
+each row of a page in Python.
+"""
+
+import uuid
+
+import pytest
+from sqlalchemy import text
+
+from app.models import AccessControl, App, Memory, MemoryState, User
+from app.utils.fulltext import create_fulltext_index, drop_fulltext_index, memory_content_matches
+from app.utils.permissions import check_memory_access_permissions, memory_access_predicate
+
+
+@pytest.fixture(autouse=True)
+def _fulltext_index(engine):
+    with engine.begin() as connection:
+        create_fulltext_index(connection)
+
+
+@pytest.fixture
+def owner(db):
+    user = User(id=uuid.uuid4(), user_id="u1")
+    app = App(id=uuid.uuid4(), name="app", owner=user)
+    db.add_all([user, app])
+    db.commit()
+    return user, app
+
+
+def _add(db, owner, content, state=MemoryState.active):
+    user, app = owner
+    memory = Memory(id=uuid.uuid4(), user=user, app=app, content=content, state=state)
+    db.add(memory)
+    db.commit()
+    return memory
+
+
+def _search(db, query):
+    return sorted(m.content for m in db.query(Memory).filter(memory_content_matches(db, query)))
+
+
+def test_search_matches_words_and_prefixes_through_fts(db, owner):
+    _add(db, owner, "I like black coffee in the morning")
+    _add(db, owner, "Allergic to peanuts")
+    _add(db, owner, "Coffee shop on Main Street")
+
+    assert _search(db, "coffee") == ["Coffee shop on Main Street", "I like black coffee in the morning"]
+    assert _search(db, "coff") == ["Coffee shop on Main Street", "I like black coffee in the morning"]
+    assert _search(db, "black coff") == ["I like black coffee in the morning"]
+    assert _search(db, "peanut!") == ["Allergic to peanuts"]
+    assert _search(db, "tea") == []
+
+    compiled = str(db.query(Memory).filter(memory_content_matches(db, "coffee")).statement)
+    assert "MATCH" in compiled and "LIKE" not in compiled
+
+
+def test_index_follows_inserts_updates_and_deletes(db, owner):
+    memory = _add(db, owner, "Lives in Berlin")
+    assert _search(db, "berlin") == ["Lives in Berlin"]
+
+    memory.content = "Moved to Lisbon"
+    db.commit()
+    assert _search(db, "berlin") == []
+    assert _search(db, "lisbon") == ["Moved to Lisbon"]
+
+    db.delete(memory)
+    db.commit()
+    assert _search(db, "lisbon") == []
+
+
+def test_index_is_built_for_existing_rows_and_can_be_dropped(db, owner):
+    bind = db.get_bind()
+    with bind.begin() as connection:
+        drop_fulltext_index(connection)
+    _add(db, owner, "Plays the cello")
+    with bind.begin() as connection:
+        create_fulltext_index(connection)
+        rows = connection.execute(text("SELECT rowid FROM memories_fts WHERE memories_fts MATCH 'cello'")).all()
+    assert len(rows) == 1
+
+
+def test_search_survives_renumbered_memory_rowids(db, owner):
+    memories = [_add(db, owner, f"note {word}") for word in ("alpha", "bravo", "charlie", "delta")]
+    for memory in memories[::2]:
+        db.delete(memory)
+    db.commit()
+    # What VACUUM may do to a table without an integer primary key.
+    with db.get_bind().begin() as connection:
+        connection.execute(text("UPDATE memories SET rowid = rowid + 100"))
+
+    assert _search(db, "bravo") == ["note bravo"]
+    assert _search(db, "delta") == ["note delta"]
+
+
+def test_rowid_keyed_index_from_older_installs_is_rebuilt(db, owner):
+    bind = db.get_bind()
+    with bind.begin() as connection:
+        drop_fulltext_index(connection)
+        connection.execute(text("CREATE VIRTUAL TABLE memories_fts USING fts5(content, content='memories')"))
+    _add(db, owner, "Plays the cello")
+    with bind.begin() as connection:
+        create_fulltext_index(connection)
+    assert _search(db, "cello") == ["Plays the cello"]
+
+
+def test_punctuation_only_query_falls_back_to_ilike(db, owner):
+    _add(db, owner, "C++ developer")
+    assert _search(db, "++") == ["C++ developer"]
+
+
+@pytest.mark.parametrize(
+    "rules",
+    [
+        [],
+        [("allow", 0)],
+        [("allow", 0), ("deny", 0)],
+        [("deny", 1)],
+        [("allow", None)],
+        [("allow", None), ("deny", None)],
+        [("deny", None), ("allow", 2)],
+        [("allow", 1), ("allow", 2), ("deny", 2)],
+    ],
+)
+def test_sql_access_predicate_matches_python_check(db, owner, rules):
+    _, app = owner
+    memories = [_add(db, owner, f"memory {i}") for i in range(3)]
+    memories.append(_add(db, owner, "paused", state=MemoryState.paused))
+    for effect, index in rules:
+        db.add(AccessControl(subject_type="app", subject_id=app.id, object_type="memory",
+                             object_id=memories[index].id if index is not None else None, effect=effect))
+    db.commit()
+
+    in_sql = {m.id for m in db.query(Memory).filter(memory_access_predicate(app.id))}
+    in_python = {m.id for m in memories if check_memory_access_permissions(db, m, app.id)}
+    assert in_sql == in_python
+
+    app.is_active = False
+    db.commit()
+    assert db.query(Memory).filter(memory_access_predicate(app.id)).count() == 0
+    assert {m.id for m in db.query(Memory).filter(memory_access_predicate(None))} == {m.id for m in memories[:3]}
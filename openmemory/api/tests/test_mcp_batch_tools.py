@@ -0,0 +1,188 @@
+"""Tests for the batch MCP tools.
+
+``search_memories_batch`` and ``add_memories_batch`` resolve the user, app and
+permissions once per call, embed all items together, and return one result
+per item in input order.
+"""
+
+import json
+import threading
+import uuid
+from types import SimpleNamespace
+from unittest.mock import MagicMock
+
+import pytest
+from app import mcp_server, models
+from app.mcp_server import add_memories_batch, client_name_var, search_memories_batch, user_id_var
+from app.models import App, Memory, MemoryState, User
+
+
+class FakeStore:
+    def __init__(self, hits):
+        self.hits = hits
+        self.batch_calls = []
+
+    def search(self, query, vectors, top_k=5, filters=None):
+        raise AssertionError("batch tools must not search one query at a time")
+
+    def search_batch(self, queries, vectors_list, top_k=1, filters=None):
+        self.batch_calls.append((list(queries), top_k, filters))
+        return [self.hits[int(v[0])][:top_k] for v in vectors_list]
+
+
+class FakeClient:
+    def __init__(self, store=None, fail_on=()):
+        self.vector_store = store
+        self.embedding_model = MagicMock()
+        self.embedding_model.embed_batch.side_effect = lambda texts, action: [[float(i)] for i in range(len(texts))]
+        self.fail_on = set(fail_on)
+        self.add_calls = []
+
+    def add(self, messages, user_id, metadata, infer):
+        self.add_calls.append((messages, infer))
+        if isinstance(messages, str):
+            if messages in self.fail_on:
+                raise RuntimeError("llm unavailable")
+            messages = [{"role": "user", "content": messages}]
+        return {"results": [{"id": str(uuid.uuid4()), "memory": m["content"], "event": "ADD"} for m in messages]}
+
+
+@pytest.fixture
+def db_factory(session_factory, monkeypatch):
+    factory = session_factory
+    monkeypatch.setattr(mcp_server, "SessionLocal", factory)
+    monkeypatch.setattr(models.categorization_queue, "enqueue", lambda mid, content: None)
+    monkeypatch.setattr(mcp_server.access_log_sink, "record", MagicMock())
+    user_token = user_id_var.set("alice")
+    client_token = client_name_var.set("cursor")
+    yield factory
+    user_id_var.reset(user_token)
+    client_name_var.reset(client_token)
+
+
+def _use(monkeypatch, client):
+    monkeypatch.setattr(mcp_server, "get_memory_client_safe", lambda: client)
+
+
+def _hit(memory_id, text):
+    return SimpleNamespace(id=str(memory_id), score=0.9, payload={"data": text, "hash": "h"})
+
+
+@pytest.mark.asyncio
+async def test_search_batch_embeds_and_queries_once(db_factory, monkeypatch):
+    db = db_factory()
+    user = User(id=uuid.uuid4(), user_id="alice")
+    app = App(id=uuid.uuid4(), name="cursor", owner=user)
+    archived = Memory(id=uuid.uuid4(), user=user, app=app, content="old", state=MemoryState.archived)
+    ids = [uuid.uuid4() for _ in range(3)]
+    db.add_all([user, app, archived])
+    db.commit()
+    archived_id = archived.id
+    db.close()
+
+    store = FakeStore([
+        [_hit(ids[0], "likes tea"), _hit(archived_id, "old")],
+        [_hit(ids[1], "lives in Paris"), _hit(ids[2], "has a cat")],
+    ])
+    client = FakeClient(store)
+    _use(monkeypatch, client)
+
+    response = json.loads(await search_memories_batch(["drinks", "home"]))
+
+    assert [r["query"] for r in response["results"]] == ["drinks", "home"]
+    assert [m["memory"] for m in response["results"][0]["results"]] == ["likes tea"]
+    assert [m["memory"] for m in response["results"][1]["results"]] == ["lives in Paris", "has a cat"]
+    client.embedding_model.embed_batch.assert_called_once_with(["drinks", "home"], "search")
+    assert len(store.batch_calls) == 1
+    assert mcp_server.access_log_sink.record.call_count == 3
+
+
+@pytest.mark.asyncio
+async def test_verbatim_add_batch_is_one_add_call_with_per_item_results(db_factory, monkeypatch):
+    client = FakeClient()
+    _use(monkeypatch, client)
+
+    response = json.loads(await add_memories_batch(["likes tea", "  ", "lives in Paris"], infer=False))
+
+    assert len(client.add_calls) == 1
+    messages, infer = client.add_calls[0]
+    assert [m["content"] for m in messages] == ["likes tea", "lives in Paris"] and infer is False
+    items = response["results"]
+    assert [item["index"] for item in items] == [0, 1, 2]
+    assert [[r["memory"] for r in item["results"]] for item in items] == [["likes tea"], [], ["lives in Paris"]]
+
+    db = db_factory()
+    assert sorted(m.content for m in db.query(Memory).all()) == ["likes tea", "lives in Paris"]
+    db.close()
+
+
+@pytest.mark.asyncio
+async def test_inferring_add_batch_reports_failures_per_item(db_factory, monkeypatch):
+    client = FakeClient(fail_on={"broken"})
+    _use(monkeypatch, client)
+
+    response = json.loads(await add_memories_batch(["likes tea", "broken", "has a cat"]))
+
+    items = response["results"]
+    assert items[1]["error"] == "llm unavailable" and "results" not in items[1]
+    assert [r["memory"] for r in items[0]["results"]] == ["likes tea"]
+    assert [r["memory"] for r in items[2]["results"]] == ["has a cat"]
+    assert sorted(text for text, infer in client.add_calls) == ["broken", "has a cat", "likes tea"]
+
+    db = db_factory()
+    assert db.query(Memory).count() == 2
+    db.close()
+
+
+class TrackingClient(FakeClient):
+    """Records how many inferring adds overlap; ``barrier`` makes two of them wait for each other."""
+
+    def __init__(self, barrier=None):
+        super().__init__()
+        self.barrier = barrier
+        self.lock = threading.Lock()
+        self.active = 0
+        self.max_active = 0
+
+    def add(self, messages, user_id, metadata, infer):
+        with self.lock:
+            self.active += 1
+            self.max_active = max(self.max_active, self.active)
+        try:
+            if self.barrier is not None:
+                self.barrier.wait()
+            return super().add(messages, user_id, metadata, infer)
+        finally:
+            with self.lock:
+                self.active -= 1
+
+
+@pytest.mark.asyncio
+async def test_inferring_add_batch_runs_items_in_order_by_default(db_factory, monkeypatch):
+    client = TrackingClient()
+    _use(monkeypatch, client)
+
+    await add_memories_batch(["likes tea", "likes green tea", "has a cat"])
+
+    # Each extraction sees what the previous one stored, like add_memories calls.
+    assert [text for text, _ in client.add_calls] == ["likes tea", "likes green tea", "has a cat"]
+    assert client.max_active == 1
+
+
+@pytest.mark.asyncio
+async def test_inferring_add_batch_runs_concurrently_when_opted_in(db_factory, monkeypatch):
+    client = TrackingClient(barrier=threading.Barrier(2, timeout=5))
+    _use(monkeypatch, client)
+
+    response = json.loads(await add_memories_batch(["likes tea", "has a cat"], parallel=True))
+
+    assert all("error" not in item for item in response["results"])
+    assert client.max_active == 2
+
+
+@pytest.mark.asyncio
+async def test_batches_over_the_limit_are_rejected(db_factory, monkeypatch):
+    monkeypatch.setattr(mcp_server, "MAX_BATCH_ITEMS", 2)
+    _use(monkeypatch, FakeClient())
+    assert (await search_memories_batch(["a", "b", "c"])).startswith("Error")
+    assert (await add_memories_batch(["a", "b", "c"])).startswith("Error")
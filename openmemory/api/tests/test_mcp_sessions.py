@@ -0,0 +1,169 @@
+"""Tests for persistent Streamable HTTP MCP sessions.
+
+An ``initialize`` without a session id opens a long-lived session whose id
+comes back in the ``mcp-session-id`` header; later requests carrying it are
+served by the same server run. Sessions are bound to their client path,
+evicted when idle or over the per-client cap, and each client has a bound on
+requests in flight.
+"""
+
+import asyncio
+
+import pytest
+import pytest_asyncio
+from httpx import ASGITransport, AsyncClient
+
+from app.mcp_server import client_name_var, mcp, mcp_router, mcp_sessions, user_id_var
+from app.utils.mcp_sessions import ClientBusy
+
+MCP_HEADERS = {"Accept": "application/json, text/event-stream"}
+URL = "/mcp/cursor/http/alice"
+
+_INITIALIZE = {
+    "jsonrpc": "2.0",
+    "id": 1,
+    "method": "initialize",
+    "params": {
+        "protocolVersion": "2025-03-26",
+        "capabilities": {},
+        "clientInfo": {"name": "test-client", "version": "0.1.0"},
+    },
+}
+
+
+@pytest.fixture(autouse=True)
+def _limits(monkeypatch):
+    monkeypatch.setattr(mcp_sessions, "max_sessions_per_client", 2)
+    monkeypatch.setattr(mcp_sessions, "max_concurrent_per_client", 1)
+    monkeypatch.setattr(mcp_sessions, "queue_timeout", 0.05)
+
+
+@pytest_asyncio.fixture
+async def client():
+    from fastapi import FastAPI
+
+    app = FastAPI()
+    app.include_router(mcp_router)
+    async with AsyncClient(transport=ASGITransport(app=app), base_url="http://test") as ac:
+        yield ac
+    await mcp_sessions.close_all()
+
+
+async def _open(client, url=URL):
+    resp = await client.post(url, json=_INITIALIZE, headers=MCP_HEADERS)
+    assert resp.status_code == 200
+    session_id = resp.headers["mcp-session-id"]
+    headers = {**MCP_HEADERS, "mcp-session-id": session_id, "mcp-protocol-version": "2025-03-26"}
+    await client.post(url, json={"jsonrpc": "2.0", "method": "notifications/initialized"}, headers=headers)
+    return headers
+
+
+def _call(name, req_id=2):
+    return {"jsonrpc": "2.0", "id": req_id, "method": "tools/call", "params": {"name": name, "arguments": {}}}
+
+
+@pytest.fixture
+def whoami():
+    @mcp.tool(name="_test_session_whoami")
+    async def _whoami() -> str:
+        return f"{client_name_var.get(None)}/{user_id_var.get(None)}"
+
+    yield "_test_session_whoami"
+    mcp._tool_manager._tools.pop("_test_session_whoami", None)
+
+
+@pytest.mark.asyncio
+async def test_requests_reuse_the_session_opened_by_initialize(client, whoami):
+    headers = await _open(client)
+    opened = mcp_sessions.stats()["opened"]
+
+    for i in range(3):
+        resp = await client.post(URL, json=_call(whoami, req_id=10 + i), headers=headers)
+        assert resp.status_code == 200
+        assert resp.json()["result"]["content"][0]["text"] == "cursor/alice"
+
+    stats = mcp_sessions.stats()
+    assert stats["opened"] == opened and stats["sessions"] == 1
+
+
+@pytest.mark.asyncio
+async def test_session_is_bound_to_its_client_path(client):
+    headers = await _open(client)
+    resp = await client.post("/mcp/cursor/http/mallory", json=_call("list_memories"), headers=headers)
+    assert resp.status_code == 404
+
+    resp = await client.post(URL, json=_call("list_memories"), headers={**headers, "mcp-session-id": "unknown"})
+    assert resp.status_code == 404
+
+
+@pytest.mark.asyncio
+async def test_delete_ends_the_session(client):
+    headers = await _open(client)
+    resp = await client.delete(URL, headers=headers)
+    assert resp.status_code == 200
+    assert mcp_sessions.stats()["sessions"] == 0
+
+    resp = await client.post(URL, json=_call("list_memories"), headers=headers)
+    assert resp.status_code == 404
+
+
+@pytest.mark.asyncio
+async def test_idle_sessions_are_closed(client, monkeypatch):
+    headers = await _open(client)
+    monkeypatch.setattr(mcp_sessions, "idle_timeout", 0.0)
+    assert await mcp_sessions.close_idle() == 1
+
+    resp = await client.post(URL, json=_call("list_memories"), headers=headers)
+    assert resp.status_code == 404
+
+
+@pytest.mark.asyncio
+async def test_per_client_cap_evicts_the_least_recently_used_session(client):
+    first = await _open(client)
+    await _open(client)
+    await _open(client, "/mcp/cursor/http/bob")  # another client's sessions don't count
+    evicted = mcp_sessions.stats()["closed_evicted"]
+    await _open(client)
+
+    assert mcp_sessions.stats()["closed_evicted"] == evicted + 1
+    resp = await client.post(URL, json=_call("list_memories"), headers=first)
+    assert resp.status_code == 404
+
+
+@pytest.mark.asyncio
+async def test_requests_over_the_client_concurrency_limit_get_429(client):
+    headers = await _open(client)
+    release = asyncio.Event()
+
+    @mcp.tool(name="_test_session_block")
+    async def _block() -> str:
+        await release.wait()
+        return "done"
+
+    try:
+        slow = asyncio.create_task(client.post(URL, json=_call("_test_session_block"), headers=headers))
+        await asyncio.sleep(0.05)
+        rejected = mcp_sessions.stats()["rejected_busy"]
+        resp = await client.post(URL, json=_call("list_memories", req_id=3), headers=headers)
+        assert resp.status_code == 429
+        assert mcp_sessions.stats()["rejected_busy"] == rejected + 1
+        # The limit applies to stateless requests from the same client too.
+        resp = await client.post(URL, json=_call("list_memories", req_id=4), headers=MCP_HEADERS)
+        assert resp.status_code == 429
+
+        release.set()
+        assert (await slow).status_code == 200
+    finally:
+        mcp._tool_manager._tools.pop("_test_session_block", None)
+
+
+@pytest.mark.asyncio
+async def test_slot_is_released_after_a_timeout():
+    key = ("cursor", "carol")
+    async with mcp_sessions.slot(key):
+        with pytest.raises(ClientBusy):
+            async with mcp_sessions.slot(key):
+                pass
+    async with mcp_sessions.slot(key):
+        pass
+    assert key not in mcp_sessions._limits
@@ -0,0 +1,228 @@
+"""Tests for cached app permissions and permission-aware vector search.
+
+The permission set of an app over a user's memories is computed once per
+(user, app), invalidated when a commit touches access controls, the app, or
+memory states, and pushed into the vector search so the store returns top_k
+permitted hits.
+"""
+
+import uuid
+from types import SimpleNamespace
+from unittest.mock import MagicMock
+
+import pytest
+from app.models import AccessControl, App, Memory, MemoryState, User
+from app.utils.permissions import (
+    MAX_OVERFETCH,
+    MemoryPermissions,
+    PermissionCache,
+    check_memory_access_permissions,
+    permission_cache,
+    search_permitted_memories,
+    search_permitted_memories_batch,
+)
+
+
+@pytest.fixture
+def setup(db):
+    user = User(id=uuid.uuid4(), user_id="u1")
+    app = App(id=uuid.uuid4(), name="app", owner=user)
+    memories = [Memory(id=uuid.uuid4(), user=user, app=app, content=f"m{i}") for i in range(3)]
+    db.add_all([user, app, *memories])
+    db.commit()
+    return user, app, memories
+
+
+def test_permission_set_is_cached_until_a_commit_changes_it(db, setup):
+    user, app, memories = setup
+    cache = permission_cache
+
+    first = cache.get(db, user.id, app.id)
+    assert first.allowed_ids is None and not first.blocked_ids
+    assert cache.get(db, user.id, app.id) is first
+    assert cache.stats()["hits"] >= 1
+
+    # Uncommitted changes leave the cached set alone.
+    db.add(AccessControl(subject_type="app", subject_id=app.id, object_type="memory",
+                         object_id=memories[0].id, effect="allow"))
+    db.flush()
+    assert cache.get(db, user.id, app.id) is first
+    db.commit()
+    assert cache.get(db, user.id, app.id).allowed_ids == {str(memories[0].id)}
+
+    memories[0].state = MemoryState.archived
+    db.commit()
+    restricted = cache.get(db, user.id, app.id)
+    assert restricted.blocked_ids == {str(memories[0].id)}
+    assert restricted.denies_all
+
+    app.is_active = False
+    db.commit()
+    assert not cache.get(db, user.id, app.id).app_active
+
+
+def test_check_memory_access_permissions_uses_one_lookup(db, setup):
+    user, app, memories = setup
+    db.add(AccessControl(subject_type="app", subject_id=app.id, object_type="memory",
+                         object_id=memories[1].id, effect="allow"))
+    db.commit()
+
+    cache = PermissionCache()
+    from app.utils import permissions
+    original, permissions.permission_cache = permissions.permission_cache, cache
+    try:
+        allowed = [m for m in memories if check_memory_access_permissions(db, m, app.id)]
+    finally:
+        permissions.permission_cache = original
+    assert allowed == [memories[1]]
+    assert cache.stats() == {"entries": 1, "hits": 2, "misses": 1}
+
+
+def test_read_racing_an_invalidation_is_not_cached(db, setup):
+    user, app, _ = setup
+    cache = PermissionCache()
+    from app.utils import permissions
+    original_load = permissions._load_permissions
+
+    def load_then_write(*args):
+        result = original_load(*args)
+        cache.invalidate(app_ids=[app.id])
+        return result
+
+    permissions._load_permissions = load_then_write
+    try:
+        cache.get(db, user.id, app.id)
+    finally:
+        permissions._load_permissions = original_load
+    assert cache.stats()["entries"] == 0
+
+
+def _hit(i):
+    return SimpleNamespace(id=f"id{i}", score=1.0 - i / 100, payload={"data": f"m{i}"})
+
+
+class FakeStore:
+    def __init__(self, count):
+        self.hits = [_hit(i) for i in range(count)]
+        self.limits = []
+
+        self.batches = []
+
+    def search(self, query, vectors, top_k=5, filters=None):
+        self.limits.append(top_k)
+        return self.hits[:top_k]
+
+    def search_batch(self, queries, vectors_list, top_k=1, filters=None):
+        self.batches.append((list(queries), top_k))
+        # Each query sees the hits from a different offset.
+        return [self.hits[v[0]:v[0] + top_k] for v in vectors_list]
+
+
+def test_unrestricted_search_is_a_single_plain_query():
+    store = FakeStore(20)
+    permissions = MemoryPermissions(app_active=True, allowed_ids=None, blocked_ids=frozenset())
+    hits = search_permitted_memories(store, "q", [0.1], {"user_id": "u1"}, permissions, top_k=10)
+    assert [h.id for h in hits] == [f"id{i}" for i in range(10)]
+    assert store.limits == [10]
+
+
+def test_blocked_ids_are_skipped_without_losing_top_k():
+    store = FakeStore(30)
+    blocked = frozenset(f"id{i}" for i in range(0, 10, 2))
+    permissions = MemoryPermissions(app_active=True, allowed_ids=None, blocked_ids=blocked)
+    hits = search_permitted_memories(store, "q", [0.1], {"user_id": "u1"}, permissions, top_k=10)
+    assert len(hits) == 10
+    assert not {h.id for h in hits} & blocked
+    assert store.limits == [15]
+
+
+def test_many_blocked_ids_cap_the_first_fetch():
+    store = FakeStore(2000)
+    blocked = frozenset(f"id{i}" for i in range(5000, 25000))
+    permissions = MemoryPermissions(app_active=True, allowed_ids=None, blocked_ids=blocked)
+
+    hits = search_permitted_memories(store, "q", [0.1], {"user_id": "u1"}, permissions, top_k=10)
+    assert len(hits) == 10 and store.limits == [MAX_OVERFETCH]
+    search_permitted_memories_batch(store, ["a", "b"], [[0], [5]], {"user_id": "u1"}, permissions, top_k=10)
+    assert store.batches == [(["a", "b"], MAX_OVERFETCH)]
+
+
+def test_deleted_memories_are_not_blocked(db, setup):
+    user, app, memories = setup
+    memories[0].state = MemoryState.deleted
+    memories[1].state = MemoryState.paused
+    db.commit()
+    # Deleting a memory removes its vector, so only paused/archived ones need filtering.
+    assert permission_cache.get(db, user.id, app.id).blocked_ids == {str(memories[1].id)}
+
+
+def test_allow_list_widens_the_fetch_until_top_k_are_permitted():
+    store = FakeStore(200)
+    allowed = frozenset(f"id{i}" for i in range(0, 200, 10))
+    permissions = MemoryPermissions(app_active=True, allowed_ids=allowed, blocked_ids=frozenset())
+    hits = search_permitted_memories(store, "q", [0.1], {"user_id": "u1"}, permissions, top_k=5)
+    assert [h.id for h in hits] == ["id0", "id10", "id20", "id30", "id40"]
+    assert store.limits == [5, 20, 80]
+
+
+def test_paused_app_or_empty_allow_list_skips_the_store():
+    store = MagicMock()
+    paused = MemoryPermissions(app_active=False, allowed_ids=frozenset(), blocked_ids=frozenset())
+    empty = MemoryPermissions(app_active=True, allowed_ids=frozenset({"a"}), blocked_ids=frozenset({"a"}))
+    assert search_permitted_memories(store, "q", [0.1], {}, paused, top_k=5) == []
+    assert search_permitted_memories(store, "q", [0.1], {}, empty, top_k=5) == []
+    store.search.assert_not_called()
+
+
+def test_batch_search_refetches_only_queries_short_of_top_k():
+    store = FakeStore(60)
+    allowed = frozenset(f"id{i}" for i in range(0, 10)) | frozenset(f"id{i}" for i in range(40, 60, 4))
+    permissions = MemoryPermissions(app_active=True, allowed_ids=allowed, blocked_ids=frozenset())
+    results = search_permitted_memories_batch(
+        store, ["dense", "sparse"], [[0], [30]], {"user_id": "u1"}, permissions, top_k=3
+    )
+    assert [h.id for h in results[0]] == ["id0", "id1", "id2"]
+    assert [h.id for h in results[1]] == ["id40", "id44", "id48"]
+    assert store.batches == [(["dense", "sparse"], 3), (["sparse"], 12), (["sparse"], 48)]
+    assert store.limits == []
+
+
+def test_unrestricted_batch_search_is_one_store_call():
+    store = FakeStore(20)
+    permissions = MemoryPermissions(app_active=True, allowed_ids=None, blocked_ids=frozenset())
+    results = search_permitted_memories_batch(store, ["a", "b"], [[0], [5]], {}, permissions, top_k=2)
+    assert [[h.id for h in hits] for hits in results] == [["id0", "id1"], ["id5", "id6"]]
+    assert store.batches == [(["a", "b"], 2)]
+
+    paused = MemoryPermissions(app_active=False, allowed_ids=frozenset(), blocked_ids=frozenset())
+    assert search_permitted_memories_batch(store, ["a", "b"], [[0], [5]], {}, paused, top_k=2) == [[], []]
+    assert len(store.batches) == 1
+
+
+def test_qdrant_applies_permissions_as_id_filter():
+    pytest.importorskip("qdrant_client")
+    from qdrant_client import QdrantClient
+
+    from mem0.vector_stores.qdrant import Qdrant
+
+    store = Qdrant(collection_name="acl", embedding_model_dims=2, client=QdrantClient(":memory:"))
+    ids = [str(uuid.uuid4()) for _ in range(6)]
+    store.insert(
+        vectors=[[1.0, i / 10] for i in range(6)],
+        payloads=[{"data": f"m{i}", "user_id": "u1"} for i in range(6)],
+        ids=ids,
+    )
+
+    allowed = MemoryPermissions(app_active=True, allowed_ids=frozenset(ids[3:]), blocked_ids=frozenset([ids[5]]))
+    hits = search_permitted_memories(store, "q", [1.0, 0.0], {"user_id": "u1"}, allowed, top_k=10)
+    assert sorted(str(h.id) for h in hits) == sorted(ids[3:5])
+
+    blocked = MemoryPermissions(app_active=True, allowed_ids=None, blocked_ids=frozenset(ids[:2]))
+    hits = search_permitted_memories(store, "q", [1.0, 0.0], {"user_id": "u1"}, blocked, top_k=3)
+    assert len(hits) == 3
+    assert not {str(h.id) for h in hits} & set(ids[:2])
+
+    batch = search_permitted_memories_batch(
+        store, ["q", "q"], [[1.0, 0.0], [0.0, 1.0]], {"user_id": "u1"}, allowed, top_k=10
+    )
+    assert [sorted(str(h.id) for h in hits) for hits in batch] == [sorted(ids[3:5])] * 2
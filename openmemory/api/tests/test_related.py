@@ -0,0 +1,95 @@
+"""Tests for vector-similarity related memories.
+
+Neighbours come from a nearest-neighbour query seeded with the memory's
+stored embedding, are cached per memory until the user's memories change,
+and can be blended with category overlap.
+"""
+
+import uuid
+from types import SimpleNamespace
+from unittest.mock import MagicMock
+
+import pytest
+from app.models import App, Category, Memory, MemoryState, User
+from app.utils.related import find_neighbours, neighbour_cache, rank_related
+
+
+@pytest.fixture
+def memories(db):
+    user = User(id=uuid.uuid4(), user_id="u1")
+    app = App(id=uuid.uuid4(), name="app", owner=user)
+    rows = [Memory(id=uuid.uuid4(), user=user, app=app, content=f"memory {i}") for i in range(4)]
+    db.add_all([user, app, *rows])
+    db.commit()
+    return rows
+
+
+def _client(hits):
+    client = MagicMock()
+    client.embedding_model.embed.return_value = [0.1, 0.2]
+    client.vector_store.search.return_value = [SimpleNamespace(id=str(mid), score=score) for mid, score in hits]
+    return client
+
+
+def test_neighbours_exclude_the_memory_and_are_cached_until_a_change(db, memories):
+    source, a, b, c = memories
+    client = _client([(source.id, 1.0), (a.id, 0.9), (b.id, 0.5)])
+
+    neighbours = find_neighbours(client, source, "u1", limit=2)
+    assert neighbours == [(str(a.id), 0.9), (str(b.id), 0.5)]
+    client.vector_store.search.assert_called_once_with(
+        query="memory 0", vectors=[0.1, 0.2], top_k=3, filters={"user_id": "u1"}
+    )
+
+    assert find_neighbours(client, source, "u1", limit=2) == neighbours
+    assert client.vector_store.search.call_count == 1
+
+    # Uncommitted edits do not drop the list; a committed one does.
+    c.content = "memory 0 again"
+    db.flush()
+    find_neighbours(client, source, "u1", limit=2)
+    assert client.vector_store.search.call_count == 1
+    db.commit()
+    find_neighbours(client, source, "u1", limit=2)
+    assert client.vector_store.search.call_count == 2
+
+    c.state = MemoryState.archived
+    db.commit()
+    find_neighbours(client, source, "u1", limit=2)
+    assert client.vector_store.search.call_count == 3
+
+    # A rolled-back edit is forgotten, not applied by the next commit.
+    a.content = "discarded"
+    db.flush()
+    db.rollback()
+    db.commit()
+    find_neighbours(client, source, "u1", limit=2)
+    assert client.vector_store.search.call_count == 3
+
+
+def test_change_during_lookup_is_not_cached(db, memories):
+    source, a, _, _ = memories
+    client = _client([(a.id, 0.9)])
+
+    def search_while_user_writes(**kwargs):
+        neighbour_cache.invalidate_users({source.user_id})
+        return [SimpleNamespace(id=str(a.id), score=0.9)]
+
+    client.vector_store.search.side_effect = search_while_user_writes
+    find_neighbours(client, source, "u1", limit=5)
+    find_neighbours(client, source, "u1", limit=5)
+    assert client.vector_store.search.call_count == 2
+
+
+def test_category_overlap_is_blended_into_similarity(db, memories):
+    source, a, b, c = memories
+    food, travel = Category(name="food"), Category(name="travel")
+    source.categories = [food, travel]
+    a.categories = []
+    b.categories = [food, travel]
+    c.categories = [food]
+    db.commit()
+    similarities = {str(a.id): 0.9, str(b.id): 0.6, str(c.id): 0.7}
+
+    assert rank_related(source, [a, b, c], similarities, 0.0) == [a, c, b]
+    assert rank_related(source, [a, b, c], similarities, 0.5) == [b, c, a]
@@ -0,0 +1,48 @@
+import asyncio
+from contextlib import asynccontextmanager
+from typing import AsyncIterator, Dict
+
+from fastapi import HTTPException
+
+
+class Bulkhead:
+    """Cap concurrent requests of one kind so they cannot starve the others.
+
+    A burst of ``add`` calls, each holding worker threads for a whole LLM
+    extraction, otherwise leaves searches queueing behind them. Requests beyond
+    ``limit`` wait up to ``timeout`` seconds for a slot and then get a 503 with
+    Retry-After, so clients back off instead of piling up.
+    """
+
+    def __init__(self, name: str, limit: int, timeout: float):
+        self.name = name
+        self.limit = limit
+        self.timeout = timeout
+        self._semaphore = asyncio.Semaphore(limit)
+        self._active = 0
+        self._waiting = 0
+        self._rejected = 0
+
+    @asynccontextmanager
+    async def slot(self) -> AsyncIterator[None]:
+        self._waiting += 1
+        try:
+            await asyncio.wait_for(self._semaphore.acquire(), self.timeout)
+        except asyncio.TimeoutError:
+            self._rejected += 1
+            raise HTTPException(
+                status_code=503,
+                detail=f"Too many concurrent {self.name} requests. Retry shortly.",
+                headers={"Retry-After": "1"},
+            )
+        finally:
+            self._waiting -= 1
+        self._active += 1
+        try:
+            yield
+        finally:
+            self._active -= 1
+            self._semaphore.release()
+
+    def stats(self) -> Dict[str, int]:
+        return {"limit": self.limit, "active": self._active, "waiting": self._waiting, "rejected": self._rejected}
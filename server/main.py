@@ -1,11 +1,17 @@
 import asyncio
+import hashlib
+import json
 import logging
 import os
 import time
+from concurrent.futures import ThreadPoolExecutor
+from contextlib import asynccontextmanager
+from datetime import datetime, timezone
 from typing import Any, Dict, List, Optional
 
 import telemetry
 from auth import ADMIN_API_KEY, AUTH_DISABLED, JWT_SECRET, require_admin, verify_auth
+from bulkhead import Bulkhead
 from db import SessionLocal
 from dotenv import load_dotenv
 from errors import (
@@ -18,17 +24,19 @@ from errors import (
 )
 from fastapi import Depends, FastAPI, HTTPException, Query, Request
 from fastapi.middleware.cors import CORSMiddleware
-from fastapi.responses import JSONResponse, RedirectResponse
+from fastapi.responses import JSONResponse, RedirectResponse, Response
 from mem0.exceptions import ValidationError as Mem0ValidationError
-from models import RequestLog, User
+from models import User
 from pydantic import BaseModel, Field
 from rate_limit import limiter
+from request_logs import RequestLogWriter
 from routers import api_keys as api_keys_router
 from routers import auth as auth_router
 from routers import entities as entities_router
 from routers import requests as requests_router
 from schemas import MessageResponse
 from server_state import (
+    get_config_fingerprint,
     get_current_config,
     get_memory_instance,
     initialize_state,
@@ -61,6 +69,15 @@ SKIPPED_REQUEST_LOG_PREFIXES = ("/requests",)
 BUNDLED_LLM_PROVIDERS = ("openai", "anthropic", "gemini")
 BUNDLED_EMBEDDER_PROVIDERS = ("openai", "gemini")
 
+# Separate concurrency limits for add (LLM extraction, seconds per call) and
+# read traffic (search/list/get, milliseconds), so add bursts cannot take every
+# worker thread that searches need. AsyncMemory runs provider calls on the
+# default executor, sized by MEM0_THREADPOOL_SIZE.
+ADD_CONCURRENCY = int(os.environ.get("MEM0_ADD_CONCURRENCY", "8"))
+SEARCH_CONCURRENCY = int(os.environ.get("MEM0_SEARCH_CONCURRENCY", "64"))
+BULKHEAD_TIMEOUT_SECONDS = float(os.environ.get("MEM0_BULKHEAD_TIMEOUT_SECONDS", "30"))
+THREADPOOL_SIZE = int(os.environ.get("MEM0_THREADPOOL_SIZE", "96"))
+
 
 def _warn_if_unconfigured() -> None:
     """Pre-auth deployments upgrading into this build will 401 everywhere until
@@ -141,6 +158,17 @@ DEFAULT_CONFIG = {
 set_session_factory(SessionLocal)
 initialize_state(DEFAULT_CONFIG)
 
+add_bulkhead = Bulkhead("add", ADD_CONCURRENCY, BULKHEAD_TIMEOUT_SECONDS)
+search_bulkhead = Bulkhead("search", SEARCH_CONCURRENCY, BULKHEAD_TIMEOUT_SECONDS)
+request_log_writer = RequestLogWriter(SessionLocal)
+
+
+@asynccontextmanager
+async def lifespan(_app: FastAPI):
+    asyncio.get_running_loop().set_default_executor(ThreadPoolExecutor(max_workers=THREADPOOL_SIZE))
+    yield
+    await asyncio.to_thread(request_log_writer.close)
+
 
 app = FastAPI(
     title="Mem0 REST APIs",
@@ -152,6 +180,7 @@ app = FastAPI(
     ),
     version="1.0.0",
     redirect_slashes=False,
+    lifespan=lifespan,
 )
 app.state.limiter = limiter
 app.add_exception_handler(RateLimitExceeded, _rate_limit_exceeded_handler)
@@ -267,27 +296,6 @@ def _should_log_request(request: Request) -> bool:
     return not path.startswith(SKIPPED_REQUEST_LOG_PREFIXES)
 
 
-def _persist_request_log(method: str, path: str, status_code: int, latency_ms: float, auth_type: str) -> None:
-    session = SessionLocal()
-
-    try:
-        session.add(
-            RequestLog(
-                method=method,
-                path=path,
-                status_code=status_code,
-                latency_ms=latency_ms,
-                auth_type=auth_type,
-            )
-        )
-        session.commit()
-    except Exception:
-        session.rollback()
-        logging.exception("Failed to persist request log")
-    finally:
-        session.close()
-
-
 @app.middleware("http")
 async def log_requests(request: Request, call_next):
     request.state.auth_type = getattr(request.state, "auth_type", "none")
@@ -307,9 +315,7 @@ async def log_requests(request: Request, call_next):
     finally:
         request_id_var.reset(token)
         if _should_log_request(request):
-            asyncio.get_running_loop().run_in_executor(
-                None,
-                _persist_request_log,
+            request_log_writer.submit(
                 request.method,
                 request.url.path,
                 status_code,
@@ -364,21 +370,24 @@ def generate_instructions(req: GenerateInstructionsRequest, _auth=Depends(verify
 
 
 @app.post("/memories", summary="Create memories")
-def add_memory(memory_create: MemoryCreate, _auth=Depends(verify_auth)):
+async def add_memory(memory_create: MemoryCreate, _auth=Depends(verify_auth)):
     """Store new memories."""
     if not any([memory_create.user_id, memory_create.agent_id, memory_create.run_id]):
         raise HTTPException(status_code=400, detail="At least one identifier (user_id, agent_id, run_id) is required.")
 
     params = {k: v for k, v in memory_create.model_dump().items() if v is not None and k != "messages"}
-    try:
-        response = get_memory_instance().add(messages=[m.model_dump() for m in memory_create.messages], **params)
-        if response.get("results"):
-            telemetry.log_dashboard_nudge_once(DASHBOARD_URL)
-        return JSONResponse(content=response)
-    except (ValueError, Mem0ValidationError) as e:
-        raise _client_error(e)
-    except Exception:
-        raise upstream_error()
+    async with add_bulkhead.slot():
+        try:
+            response = await get_memory_instance().add(
+                messages=[m.model_dump() for m in memory_create.messages], **params
+            )
+        except (ValueError, Mem0ValidationError) as e:
+            raise _client_error(e)
+        except Exception:
+            raise upstream_error()
+    if response.get("results"):
+        telemetry.log_dashboard_nudge_once(DASHBOARD_URL)
+    return JSONResponse(content=response)
 
 
 ALL_MEMORIES_LIMIT = 1000
@@ -407,9 +416,53 @@ def _list_all_memories(limit: int = ALL_MEMORIES_LIMIT) -> Dict[str, Any]:
     return {"results": [_serialize_memory(row) for row in rows]}
 
 
+# Conditional GETs: clients send back the ETag they were given in
+# If-None-Match and get a bodiless 304 while the data is unchanged. no-cache
+# makes browsers and proxies revalidate instead of serving a stale copy.
+ETAG_CACHE_CONTROL = "private, no-cache"
+
+
+def _etag(*parts: Any) -> str:
+    digest = hashlib.sha256(json.dumps(parts, sort_keys=True, default=str).encode()).hexdigest()
+    return f'"{digest[:32]}"'
+
+
+def _etag_matches(request: Request, etag: str) -> bool:
+    header = request.headers.get("if-none-match")
+    if not header:
+        return False
+    if header.strip() == "*":
+        return True
+    # If-None-Match uses weak comparison, so W/"x" matches "x".
+    return etag in {tag.strip().removeprefix("W/") for tag in header.split(",")}
+
+
+def _set_etag(response: Response, etag: str) -> None:
+    response.headers["ETag"] = etag
+    response.headers["Cache-Control"] = ETAG_CACHE_CONTROL
+
+
+def _not_modified(etag: str) -> Response:
+    return Response(status_code=304, headers={"ETag": etag, "Cache-Control": ETAG_CACHE_CONTROL})
+
+
+async def _scope_version(memory: Any, filters: Dict[str, Any]) -> Optional[int]:
+    """Write version of the scope, or None when the Memory instance cannot report one."""
+    get_version = getattr(memory, "get_scope_version", None)
+    if get_version is None:
+        return None
+    try:
+        version = await get_version(**filters)
+    except Exception:
+        logging.debug("Scope version unavailable; falling back to content ETags", exc_info=True)
+        return None
+    return version if isinstance(version, int) else None
+
+
 @app.get("/memories", summary="Get memories")
-def get_all_memories(
+async def get_all_memories(
     request: Request,
+    response: Response,
     user_id: Optional[str] = None,
     run_id: Optional[str] = None,
     agent_id: Optional[str] = None,
@@ -419,20 +472,45 @@ def get_all_memories(
 ):
     """Retrieve stored memories. Lists all memories when no identifier is provided (admin only)."""
     try:
-        if not any([user_id, run_id, agent_id]):
+        list_all = not any([user_id, run_id, agent_id])
+        if list_all:
             auth_type = getattr(request.state, "auth_type", "none")
             if _auth is not None and _auth.role != "admin" and auth_type not in {"admin_api_key", "disabled"}:
                 raise HTTPException(status_code=403, detail="Admin role required to list all memories.")
-            # Admin all-memory listing is intentionally raw; scoped get_all below applies expiry visibility.
-            return _list_all_memories(limit=top_k if top_k is not None else ALL_MEMORIES_LIMIT)
         filters = {
             k: v for k, v in {"user_id": user_id, "run_id": run_id, "agent_id": agent_id}.items() if v is not None
         }
-        params = {"filters": filters}
-        if top_k is not None:
-            params["top_k"] = top_k
-        params["show_expired"] = show_expired
-        return get_memory_instance().get_all(**params)
+        memory = get_memory_instance()
+        async with search_bulkhead.slot():
+            # The version is read before the query: a write racing with it can only
+            # make the ETag older than the body, which costs the client one extra
+            # full response but never hides a change. Expiry is day-granular, so
+            # the UTC date covers memories that expire without a write.
+            version = await _scope_version(memory, {} if list_all else filters)
+            etag = None
+            if version is not None:
+                today = None if show_expired or list_all else datetime.now(timezone.utc).date().isoformat()
+                etag = _etag("memories", get_config_fingerprint(), version, filters, top_k, show_expired, today)
+                if _etag_matches(request, etag):
+                    return _not_modified(etag)
+
+            if list_all:
+                # Admin all-memory listing is intentionally raw; scoped get_all below applies expiry visibility.
+                limit = top_k if top_k is not None else ALL_MEMORIES_LIMIT
+                result = await asyncio.to_thread(_list_all_memories, limit)
+            else:
+                params = {"filters": filters}
+                if top_k is not None:
+                    params["top_k"] = top_k
+                params["show_expired"] = show_expired
+                result = await memory.get_all(**params)
+
+        if etag is None:
+            etag = _etag("memories", result)
+            if _etag_matches(request, etag):
+                return _not_modified(etag)
+        _set_etag(response, etag)
+        return result
     except HTTPException:
         raise
     except Exception:
@@ -440,16 +518,31 @@ def get_all_memories(
 
 
 @app.get("/memories/{memory_id}", summary="Get a memory")
-def get_memory(memory_id: str, _auth=Depends(verify_auth)):
+async def get_memory(memory_id: str, request: Request, response: Response, _auth=Depends(verify_auth)):
     """Retrieve a specific memory by ID."""
-    try:
-        return get_memory_instance().get(memory_id)
-    except Exception:
-        raise upstream_error()
+    async with search_bulkhead.slot():
+        try:
+            memory = await get_memory_instance().get(memory_id)
+        except Exception:
+            raise upstream_error()
+    if isinstance(memory, dict):
+        # Every update rewrites hash or updated_at, so together they identify the revision.
+        etag = _etag(
+            "memory",
+            get_config_fingerprint(),
+            memory.get("id"),
+            memory.get("hash"),
+            memory.get("updated_at"),
+            memory.get("expiration_date"),
+        )
+        if _etag_matches(request, etag):
+            return _not_modified(etag)
+        _set_etag(response, etag)
+    return memory
 
 
 @app.post("/search", summary="Search memories")
-def search_memories(search_req: SearchRequest, _auth=Depends(verify_auth)):
+async def search_memories(search_req: SearchRequest, _auth=Depends(verify_auth)):
     """Search for memories based on a query."""
     try:
         filters = search_req.filters or {}
@@ -474,7 +567,8 @@ def search_memories(search_req: SearchRequest, _auth=Depends(verify_auth)):
             params["explain"] = search_req.explain
         if search_req.show_expired is not None:
             params["show_expired"] = search_req.show_expired
-        return get_memory_instance().search(query=search_req.query, filters=filters, **params)
+        async with search_bulkhead.slot():
+            return await get_memory_instance().search(query=search_req.query, filters=filters, **params)
     except ValueError as e:
         raise HTTPException(status_code=400, detail=str(e))
     except HTTPException:
@@ -484,38 +578,48 @@ def search_memories(search_req: SearchRequest, _auth=Depends(verify_auth)):
 
 
 @app.put("/memories/{memory_id}", summary="Update a memory")
-def update_memory(memory_id: str, updated_memory: MemoryUpdate, _auth=Depends(verify_auth)):
+async def update_memory(memory_id: str, updated_memory: MemoryUpdate, _auth=Depends(verify_auth)):
     """Update an existing memory."""
-    try:
-        fields_set = getattr(updated_memory, "model_fields_set", getattr(updated_memory, "__fields_set__", set()))
-        params = {"memory_id": memory_id}
-        if "text" in fields_set:
-            params["data"] = updated_memory.text
-        if "metadata" in fields_set:
-            params["metadata"] = updated_memory.metadata
-        if "expiration_date" in fields_set:
-            params["expiration_date"] = updated_memory.expiration_date
-        return get_memory_instance().update(**params)
-    except (ValueError, Mem0ValidationError) as e:
-        raise _client_error(e)
-    except Exception:
-        raise upstream_error()
+    fields_set = getattr(updated_memory, "model_fields_set", getattr(updated_memory, "__fields_set__", set()))
+    params = {"memory_id": memory_id}
+    if "text" in fields_set:
+        params["data"] = updated_memory.text
+    if "metadata" in fields_set:
+        params["metadata"] = updated_memory.metadata
+    if "expiration_date" in fields_set:
+        params["expiration_date"] = updated_memory.expiration_date
+    # Updates re-embed the text, so they share the add bulkhead.
+    async with add_bulkhead.slot():
+        try:
+            return await get_memory_instance().update(**params)
+        except (ValueError, Mem0ValidationError) as e:
+            raise _client_error(e)
+        except Exception:
+            raise upstream_error()
 
 
 @app.get("/memories/{memory_id}/history", summary="Get memory history")
-def memory_history(memory_id: str, _auth=Depends(verify_auth)):
+async def memory_history(memory_id: str, request: Request, response: Response, _auth=Depends(verify_auth)):
     """Retrieve memory history."""
-    try:
-        return get_memory_instance().history(memory_id=memory_id)
-    except Exception:
-        raise upstream_error()
+    async with search_bulkhead.slot():
+        try:
+            history = await get_memory_instance().history(memory_id=memory_id)
+        except Exception:
+            raise upstream_error()
+    # History rows are append-only, so their ids identify the response.
+    entry_ids = [entry.get("id") for entry in history or [] if isinstance(entry, dict)]
+    etag = _etag("history", get_config_fingerprint(), memory_id, entry_ids)
+    if _etag_matches(request, etag):
+        return _not_modified(etag)
+    _set_etag(response, etag)
+    return history
 
 
 @app.delete("/memories/{memory_id}", summary="Delete a memory", response_model=MessageResponse)
-def delete_memory(memory_id: str, _auth=Depends(verify_auth)):
+async def delete_memory(memory_id: str, _auth=Depends(verify_auth)):
     """Delete a specific memory by ID."""
     try:
-        get_memory_instance().delete(memory_id=memory_id)
+        await get_memory_instance().delete(memory_id=memory_id)
         return MessageResponse(message="Memory deleted successfully")
     except (ValueError, Mem0ValidationError) as e:
         raise _client_error(e)
@@ -524,7 +628,7 @@ def delete_memory(memory_id: str, _auth=Depends(verify_auth)):
 
 
 @app.delete("/memories", summary="Delete all memories", response_model=MessageResponse)
-def delete_all_memories(
+async def delete_all_memories(
     user_id: Optional[str] = None,
     run_id: Optional[str] = None,
     agent_id: Optional[str] = None,
@@ -537,17 +641,17 @@ def delete_all_memories(
         params = {
             k: v for k, v in {"user_id": user_id, "run_id": run_id, "agent_id": agent_id}.items() if v is not None
         }
-        get_memory_instance().delete_all(**params)
+        await get_memory_instance().delete_all(**params)
         return MessageResponse(message="All relevant memories deleted")
     except Exception:
         raise upstream_error()
 
 
 @app.post("/reset", summary="Reset all memories")
-def reset_memory(_auth=Depends(require_admin)):
+async def reset_memory(_auth=Depends(require_admin)):
     """Completely reset stored memories. Requires admin role."""
     try:
-        get_memory_instance().reset()
+        await get_memory_instance().reset()
         return {"message": "All memories reset"}
     except Exception:
         raise upstream_error()
@@ -0,0 +1,122 @@
+import logging
+import queue
+import threading
+from datetime import datetime, timezone
+from typing import Any, Callable, Dict, List
+
+from models import RequestLog
+
+logger = logging.getLogger(__name__)
+
+
+class RequestLogWriter:
+    """Persist request logs from one background thread, in batches.
+
+    The request middleware only enqueues a row, so logging never holds a request
+    (or a threadpool worker that AsyncMemory needs) on a database round trip.
+    When the queue is full, e.g. the app database is slow or down, new rows are
+    dropped and counted instead of pushing back on API traffic.
+    """
+
+    def __init__(
+        self,
+        session_factory: Callable,
+        max_queue: int = 10_000,
+        batch_size: int = 200,
+        flush_interval: float = 0.5,
+    ):
+        self._session_factory = session_factory
+        self._queue: "queue.Queue[Dict[str, Any]]" = queue.Queue(maxsize=max_queue)
+        self._batch_size = batch_size
+        self._flush_interval = flush_interval
+        self._lock = threading.Lock()
+        self._thread: threading.Thread | None = None
+        self._stopping = threading.Event()
+        self._written = 0
+        self._dropped = 0
+        self._failed = 0
+
+    def submit(self, method: str, path: str, status_code: int, latency_ms: float, auth_type: str) -> bool:
+        row = {
+            "method": method,
+            "path": path,
+            "status_code": status_code,
+            "latency_ms": latency_ms,
+            "auth_type": auth_type,
+            # Stamped here rather than by the column default so batching does not shift it.
+            "created_at": datetime.now(timezone.utc),
+        }
+        self._ensure_started()
+        try:
+            self._queue.put_nowait(row)
+            return True
+        except queue.Full:
+            with self._lock:
+                self._dropped += 1
+            return False
+
+    def flush(self, timeout: float = 5.0) -> bool:
+        """Block until every queued row has been written (or failed). Returns False on timeout."""
+        done = threading.Event()
+
+        def wait_for_drain():
+            self._queue.join()
+            done.set()
+
+        threading.Thread(target=wait_for_drain, daemon=True).start()
+        return done.wait(timeout)
+
+    def close(self, timeout: float = 5.0) -> None:
+        self.flush(timeout)
+        self._stopping.set()
+        if self._thread is not None:
+            self._thread.join(timeout)
+
+    def stats(self) -> Dict[str, int]:
+        with self._lock:
+            return {
+                "queued": self._queue.qsize(),
+                "written": self._written,
+                "dropped": self._dropped,
+                "failed": self._failed,
+            }
+
+    def _ensure_started(self) -> None:
+        if self._thread is not None:
+            return
+        with self._lock:
+            if self._thread is None:
+                self._thread = threading.Thread(target=self._run, name="request-log-writer", daemon=True)
+                self._thread.start()
+
+    def _run(self) -> None:
+        while not self._stopping.is_set():
+            try:
+                batch = [self._queue.get(timeout=self._flush_interval)]
+            except queue.Empty:
+                continue
+            while len(batch) < self._batch_size:
+                try:
+                    batch.append(self._queue.get_nowait())
+                except queue.Empty:
+                    break
+            try:
+                self._write(batch)
+            finally:
+                for _ in batch:
+                    self._queue.task_done()
+
+    def _write(self, rows: List[Dict[str, Any]]) -> None:
+        session = self._session_factory()
+        try:
+            session.add_all([RequestLog(**row) for row in rows])
+            session.commit()
+            with self._lock:
+                self._written += len(rows)
+        except Exception:
+            session.rollback()
+            with self._lock:
+                self._failed += len(rows)
+            logger.exception("Failed to persist %d request logs", len(rows))
+        finally:
+            session.close()
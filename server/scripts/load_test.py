@@ -0,0 +1,136 @@
+"""Search latency under add bursts, with and without the add bulkhead.
+
+Runs the FastAPI app in-process against a stub AsyncMemory whose ``add``
+holds a worker thread for ``--add-seconds`` (standing in for LLM extraction)
+and whose ``search`` takes a few milliseconds. Search p50/p99 is measured
+on its own, then again while a burst of concurrent adds is in flight: once
+with adds effectively unbounded and once behind the add bulkhead.
+
+    python scripts/load_test.py [--adds 200] [--searches 400] [--add-seconds 1.0]
+"""
+
+import argparse
+import asyncio
+import logging
+import os
+import statistics
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+from unittest.mock import patch
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+os.environ.setdefault("AUTH_DISABLED", "true")
+os.environ.setdefault("MEM0_TELEMETRY", "false")
+
+import httpx  # noqa: E402
+
+
+class StubAsyncMemory:
+    def __init__(self, add_seconds: float, search_seconds: float):
+        self.add_seconds = add_seconds
+        self.search_seconds = search_seconds
+
+    async def add(self, messages, **kwargs):
+        # AsyncMemory runs provider calls on the default executor, so a slow
+        # LLM occupies a thread for the whole extraction.
+        await asyncio.to_thread(time.sleep, self.add_seconds)
+        return {"results": []}
+
+    async def search(self, query, filters=None, **kwargs):
+        await asyncio.to_thread(time.sleep, self.search_seconds)
+        return {"results": [{"id": "m1", "memory": query, "score": 0.9}]}
+
+
+class _NullSession:
+    def add_all(self, rows):
+        pass
+
+    def commit(self):
+        pass
+
+    def rollback(self):
+        pass
+
+    def close(self):
+        pass
+
+
+def _percentile(samples, pct):
+    ordered = sorted(samples)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * pct / 100))]
+
+
+async def _searches(client, count, concurrency):
+    latencies = []
+    semaphore = asyncio.Semaphore(concurrency)
+
+    async def one(i):
+        async with semaphore:
+            start = time.perf_counter()
+            resp = await client.post("/search", json={"query": f"q{i}", "filters": {"user_id": "u1"}})
+            resp.raise_for_status()
+            latencies.append((time.perf_counter() - start) * 1000)
+
+    await asyncio.gather(*(one(i) for i in range(count)))
+    return latencies
+
+
+async def _adds(client, count):
+    async def one(i):
+        resp = await client.post(
+            "/memories", json={"messages": [{"role": "user", "content": f"fact {i}"}], "user_id": "u1"}
+        )
+        return resp.status_code
+
+    return await asyncio.gather(*(one(i) for i in range(count)))
+
+
+async def run(args):
+    from bulkhead import Bulkhead
+    from request_logs import RequestLogWriter
+
+    logging.getLogger("httpx").setLevel(logging.WARNING)
+    stub = StubAsyncMemory(args.add_seconds, args.search_seconds)
+    with patch("mem0.AsyncMemory.from_config", return_value=stub):
+        import main as server_main
+
+    server_main.request_log_writer = RequestLogWriter(_NullSession)
+    asyncio.get_running_loop().set_default_executor(ThreadPoolExecutor(max_workers=server_main.THREADPOOL_SIZE))
+
+    transport = httpx.ASGITransport(app=server_main.app)
+    async with httpx.AsyncClient(transport=transport, base_url="http://test", timeout=None) as client:
+        await _searches(client, 20, 4)  # warm up
+        baseline = await _searches(client, args.searches, args.search_concurrency)
+        _report("search, idle", baseline)
+
+        for label, limit in (("adds unbounded", args.adds), ("add bulkhead", server_main.ADD_CONCURRENCY)):
+            server_main.add_bulkhead = Bulkhead("add", limit, server_main.BULKHEAD_TIMEOUT_SECONDS)
+            add_task = asyncio.ensure_future(_adds(client, args.adds))
+            await asyncio.sleep(0.05)  # let the burst take its threads first
+            during = await _searches(client, args.searches, args.search_concurrency)
+            statuses = await add_task
+            _report(f"search, {label} (limit {limit})", during)
+            print(f"    adds: {statuses.count(200)} ok, {statuses.count(503)} rejected")
+
+
+def _report(label, latencies):
+    print(
+        f"{label:<40} p50={statistics.median(latencies):7.1f}ms "
+        f"p99={_percentile(latencies, 99):7.1f}ms n={len(latencies)}"
+    )
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--adds", type=int, default=200, help="Concurrent adds in each burst.")
+    parser.add_argument("--searches", type=int, default=400, help="Searches measured per phase.")
+    parser.add_argument("--search-concurrency", type=int, default=16)
+    parser.add_argument("--add-seconds", type=float, default=1.0, help="Simulated LLM time per add.")
+    parser.add_argument("--search-seconds", type=float, default=0.005, help="Simulated vector search time.")
+    asyncio.run(run(parser.parse_args()))
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -1,15 +1,17 @@
+import hashlib
 import json
 import logging
 import threading
 from copy import deepcopy
 from typing import Any, Callable, Dict
 
-from mem0 import Memory
+from mem0 import AsyncMemory
 
 _state_lock = threading.RLock()
 _current_config: Dict[str, Any] = {}
-_memory_instance: Memory | None = None
+_memory_instance: AsyncMemory | None = None
 _session_factory: Callable | None = None
+_config_fingerprint = ""
 
 
 def set_session_factory(factory: Callable) -> None:
@@ -73,22 +75,28 @@ def _merge_config(base: Dict[str, Any], updates: Dict[str, Any]) -> Dict[str, An
     return merged
 
 
+def _fingerprint(config: Dict[str, Any]) -> str:
+    return hashlib.sha256(json.dumps(config, sort_keys=True, default=str).encode()).hexdigest()
+
+
 def initialize_state(default_config: Dict[str, Any]) -> None:
-    global _current_config, _memory_instance
+    global _current_config, _memory_instance, _config_fingerprint
     with _state_lock:
         _current_config = deepcopy(default_config)
         overrides = _load_overrides()
         if overrides:
             _current_config = _merge_config(_current_config, overrides)
-        _memory_instance = Memory.from_config(_current_config)
+        _memory_instance = AsyncMemory.from_config(_current_config)
+        _config_fingerprint = _fingerprint(_current_config)
 
 
 def update_config(updates: Dict[str, Any]) -> Dict[str, Any]:
-    global _current_config, _memory_instance
+    global _current_config, _memory_instance, _config_fingerprint
     with _state_lock:
         next_config = _merge_config(_current_config, updates)
         _current_config = next_config
-        _memory_instance = Memory.from_config(next_config)
+        _memory_instance = AsyncMemory.from_config(next_config)
+        _config_fingerprint = _fingerprint(next_config)
         overrides = _load_overrides()
         overrides = _merge_config(overrides, updates)
         _save_overrides(overrides)
@@ -100,7 +108,13 @@ def get_current_config() -> Dict[str, Any]:
         return deepcopy(_current_config)
 
 
-def get_memory_instance() -> Memory:
+def get_config_fingerprint() -> str:
+    """Stable hash of the active config; changes whenever the Memory instance is rebuilt with new settings."""
+    with _state_lock:
+        return _config_fingerprint
+
+
+def get_memory_instance() -> AsyncMemory:
     with _state_lock:
         if _memory_instance is None:
             raise RuntimeError("Mem0 runtime has not been initialized.")
@@ -1,4 +1,5 @@
 import logging
+import threading
 import time
 from datetime import datetime, timezone
 from types import SimpleNamespace
@@ -441,6 +442,41 @@ def test_create_then_search_and_get_all_return_same_timestamps(mocker):
     assert get_all_item["updated_at"] is not None
 
 
+class _HybridStore:
+    """Store that serves semantic and keyword search in one request."""
+
+    def __init__(self, semantic, keyword):
+        self.semantic = semantic
+        self.keyword = keyword
+        self.calls = []
+
+    def hybrid_search(self, query, keyword_query, vectors, top_k=5, filters=None):
+        self.calls.append((query, keyword_query, top_k, filters))
+        return self.semantic, self.keyword
+
+    def search(self, *args, **kwargs):
+        raise AssertionError("hybrid stores must not be searched one side at a time")
+
+    keyword_search = search
+
+
+def test_search_uses_hybrid_search_when_the_store_provides_it(mocker):
+    memory = _build_memory_instance(mocker, Memory)
+    hit = SimpleNamespace(id="m1", score=0.8, payload={"data": "Likes pizza", "hash": "h"})
+    other = SimpleNamespace(id="m2", score=0.8, payload={"data": "Likes pasta", "hash": "h"})
+    memory.vector_store = _HybridStore([hit, other], [SimpleNamespace(id="m1", score=12.0, payload=hit.payload)])
+
+    results = memory._search_vector_store("pizza", filters={"user_id": "alice"}, limit=10)
+
+    assert len(memory.vector_store.calls) == 1
+    query, keyword_query, top_k, filters = memory.vector_store.calls[0]
+    assert (query, top_k, filters) == ("pizza", 60, {"user_id": "alice"})
+    assert keyword_query
+    # The keyword side's raw score still feeds hybrid scoring.
+    assert [r["id"] for r in results] == ["m1", "m2"]
+    assert results[0]["score"] > results[1]["score"]
+
+
 def test_update_preserves_created_at_and_updates_updated_at(mocker):
     """After an update, created_at must stay the same and updated_at must change."""
     memory = _build_memory_instance(mocker, Memory)
@@ -631,6 +667,23 @@ class TestMetadataNotMutated:
         assert second_payload["role"] == "assistant"
         assert second_payload["actor_id"] == "bot-1"
 
+    def test_add_to_vector_store_no_infer_embeds_messages_in_one_batch(self, mocker):
+        memory = _build_memory_instance(mocker, Memory)
+        memory.embedding_model.embed_batch.return_value = [[0.1, 0.2], [0.3, 0.4]]
+
+        messages = [
+            {"role": "user", "content": "likes tea"},
+            {"role": "user", "content": "lives in Paris"},
+            {"role": "user", "content": "likes tea"},
+        ]
+        result = memory._add_to_vector_store(messages, {"user_id": "test_user"}, filters={}, infer=False)
+
+        assert len(result) == 3
+        memory.embedding_model.embed_batch.assert_called_once_with(["likes tea", "lives in Paris"], "add")
+        memory.embedding_model.embed.assert_not_called()
+        inserted = [c.kwargs["vectors"][0] for c in memory.vector_store.insert.call_args_list]
+        assert inserted == [[0.1, 0.2], [0.3, 0.4], [0.1, 0.2]]
+
     @pytest.mark.asyncio
     async def test_async_create_memory_does_not_mutate_metadata(self, mocker):
         memory = _build_memory_instance(mocker, AsyncMemory)
@@ -1061,3 +1114,84 @@ class TestAddPipelineEntityEmbeddingCountGuard:
         assert any("padding/truncating" in r.message for r in caplog.records), (
             "expected count-mismatch warning was not emitted"
         )
+
+
+class TestScopeVersion:
+    @pytest.fixture
+    def memory(self, mocker):
+        _setup_mocks(mocker)
+        mocker.patch("mem0.memory.main.capture_event")
+        mocker.patch("mem0.utils.factory.VectorStoreFactory.reset", side_effect=lambda store: store)
+        from mem0.configs.base import MemoryConfig
+
+        return Memory(MemoryConfig(history_db_path=":memory:"))
+
+    def test_writes_bump_matching_scopes(self, memory):
+        payload = {"data": "old", "user_id": "u1", "agent_id": "a1", "created_at": "2024-01-01T00:00:00+00:00"}
+        memory.vector_store.get.return_value = SimpleNamespace(id="m1", payload=payload)
+        assert memory.get_scope_version(user_id="u1") == 0
+
+        memory.update("m1", "new")
+        assert memory.get_scope_version(user_id="u1") == 1
+        assert memory.get_scope_version(user_id="u1", agent_id="a1") == 1
+        assert memory.get_scope_version(user_id="u1", agent_id="a2") == 0
+        assert memory.get_scope_version(user_id="u2") == 0
+
+        memory.delete("m1")
+        assert memory.get_scope_version(user_id="u1") == 2
+
+    def test_failed_add_bumps_scope_without_masking_the_error(self, memory, mocker):
+        mocker.patch.object(memory, "_add_to_vector_store", side_effect=RuntimeError("store down"))
+        with pytest.raises(RuntimeError, match="store down"):
+            memory.add("hello", user_id="u1", infer=False)
+        assert memory.get_scope_version(user_id="u1") == 1
+
+        mocker.patch.object(memory.db, "bump_scope_version", side_effect=RuntimeError("db locked"))
+        with pytest.raises(RuntimeError, match="store down"):
+            memory.add("hello", user_id="u1", infer=False)
+
+    def test_reset_never_moves_versions_backwards(self, memory):
+        memory.vector_store.get.return_value = SimpleNamespace(id="m1", payload={"data": "x", "user_id": "u1"})
+        memory.delete("m1")
+        memory.delete("m1")
+        before = memory.get_scope_version(user_id="u2")
+
+        memory.reset()
+        assert memory.get_scope_version(user_id="u1") > 2
+        assert memory.get_scope_version(user_id="u2") > before
+
+    @pytest.mark.asyncio
+    async def test_async_reads_scope_version(self, mocker):
+        _setup_mocks(mocker)
+        mocker.patch("mem0.memory.main.capture_event")
+        from mem0.configs.base import MemoryConfig
+
+        memory = AsyncMemory(MemoryConfig(history_db_path=":memory:"))
+        memory.vector_store.get.return_value = SimpleNamespace(id="m1", payload={"data": "x", "run_id": "r1"})
+        await memory.delete("m1")
+        assert await memory.get_scope_version(run_id="r1") == 1
+        assert await memory.get_scope_version(run_id="r2") == 0
+
+    @pytest.mark.asyncio
+    async def test_async_writes_bump_off_the_event_loop(self, mocker):
+        _setup_mocks(mocker)
+        mocker.patch("mem0.memory.main.capture_event")
+        from mem0.configs.base import MemoryConfig
+
+        memory = AsyncMemory(MemoryConfig(history_db_path=":memory:"))
+        bump = memory.db.bump_scope_version
+        threads = []
+
+        def record_thread(*args, **kwargs):
+            threads.append(threading.current_thread())
+            return bump(*args, **kwargs)
+
+        mocker.patch.object(memory.db, "bump_scope_version", side_effect=record_thread)
+        mocker.patch.object(memory, "_add_to_vector_store", side_effect=RuntimeError("store down"))
+        memory.vector_store.get.return_value = SimpleNamespace(id="m1", payload={"data": "x", "user_id": "u1"})
+
+        await memory.delete("m1")
+        with pytest.raises(RuntimeError, match="store down"):
+            await memory.add("hello", user_id="u1", infer=False)
+        assert len(threads) == 2 and threading.main_thread() not in threads
+        assert await memory.get_scope_version(user_id="u1") == 2
@@ -38,6 +38,9 @@ def reset_notice_process_state():
     notices._scale_memory_count_adds_since_check = 0
     notices._scale_memory_count_checked_in_process = False
     notices._scale_memory_count_threshold_evaluated_in_process = False
+    notices._notice_config_cache = None
+    notices._persist_pending = False
+    notices._provider_counts.clear()
     yield
     notices._first_run_claimed_in_process = False
     notices._decay_usage_successful_delete_count_in_process = 0
@@ -49,6 +52,9 @@ def reset_notice_process_state():
     notices._scale_memory_count_adds_since_check = 0
     notices._scale_memory_count_checked_in_process = False
     notices._scale_memory_count_threshold_evaluated_in_process = False
+    notices._notice_config_cache = None
+    notices._persist_pending = False
+    notices._provider_counts.clear()
 
 
 @pytest.fixture
@@ -64,6 +70,8 @@ def notice_harness(monkeypatch):
 
     monkeypatch.setattr(notices, "_load_config", lambda: config)
     monkeypatch.setattr(notices, "_write_config", write_config)
+    # Persist synchronously so tests can read the written state right away.
+    monkeypatch.setattr(notices, "PERSIST_DEBOUNCE_SECONDS", 0)
     monkeypatch.setattr(notices.telemetry_module, "MEM0_TELEMETRY", True)
     monkeypatch.setattr(notices.telemetry_module, "_get_oss_telemetry", lambda: telemetry)
 
@@ -301,6 +309,7 @@ def test_async_notice_wrapper_uses_shared_helper(monkeypatch):
 
     memory = MagicMock()
     monkeypatch.setattr(notices, "display_first_run_notice", display)
+    monkeypatch.setattr(notices.telemetry_module, "MEM0_TELEMETRY", True)
 
     asyncio.run(notices.display_first_run_notice_async(memory, "async", "search"))
 
@@ -1477,6 +1486,7 @@ def test_async_scale_threshold_wrapper_uses_shared_helper(monkeypatch):
 
     memory = MagicMock()
     monkeypatch.setattr(notices, "display_scale_threshold_notice", display)
+    monkeypatch.setattr(notices.telemetry_module, "MEM0_TELEMETRY", True)
 
     asyncio.run(
         notices.display_scale_threshold_notice_async(
@@ -1549,3 +1559,89 @@ def test_notice_priority_scale_beats_first_run(monkeypatch):
     )
 
     assert calls == ["scale"]
+
+
+def test_notice_state_writes_are_debounced_and_flushed(monkeypatch, notice_harness):
+    config, telemetry = notice_harness
+    writes = []
+    monkeypatch.setattr(notices, "_write_config", lambda updated: writes.append(deepcopy(updated)))
+    monkeypatch.setattr(notices, "PERSIST_DEBOUNCE_SECONDS", 60)
+    timers = []
+
+    def timer(delay, fn):
+        timers.append(MagicMock(is_alive=lambda: True))
+        return timers[-1]
+
+    monkeypatch.setattr(notices, "_persist_timer", None)
+    monkeypatch.setattr(notices.threading, "Timer", timer)
+    configure_flag(telemetry, "displayed", scale_payload())
+
+    for _ in range(3):
+        notices.display_scale_threshold_notice(MagicMock(), "sync", "search", "top_k", "high_top_k", top_k=80)
+
+    assert writes == [] and len(timers) == 1
+    notices.flush_notice_state()
+    assert len(writes) == 1
+    assert len(writes[0]["notice_state"]["scale_threshold"]["events"]) == 3
+    notices.flush_notice_state()
+    assert len(writes) == 1
+
+
+def test_notice_state_is_read_from_disk_once(monkeypatch, notice_harness):
+    config, telemetry = notice_harness
+    load_config = MagicMock(return_value=config)
+    monkeypatch.setattr(notices, "_load_config", load_config)
+    configure_flag(telemetry, "holdout", temporal_usage_payload())
+
+    for _ in range(3):
+        notices.display_temporal_usage_notice(MagicMock(), "sync", "search", "query", "relative_phrase")
+
+    # One read to populate the in-memory state, one per synchronous write-back.
+    assert load_config.call_count == 1 + 3
+    monkeypatch.setattr(notices, "PERSIST_DEBOUNCE_SECONDS", 60)
+    monkeypatch.setattr(notices, "_persist_timer", MagicMock(is_alive=lambda: True))
+    load_config.reset_mock()
+    notices.display_temporal_usage_notice(MagicMock(), "sync", "search", "query", "relative_phrase")
+    load_config.assert_not_called()
+
+
+def test_provider_memory_count_is_cached_for_ttl(monkeypatch):
+    memory = MagicMock()
+    memory.vector_store.count.return_value = 10
+
+    assert notices._get_provider_memory_count(memory) == 10
+    assert notices._get_provider_memory_count(memory) == 10
+    memory.vector_store.count.assert_called_once()
+
+    monkeypatch.setattr(notices, "PROVIDER_COUNT_TTL_SECONDS", 0)
+    notices._provider_counts.clear()
+    notices._get_provider_memory_count(memory)
+    notices._get_provider_memory_count(memory)
+    assert memory.vector_store.count.call_count == 3
+
+
+def test_notices_config_switch_skips_evaluation(monkeypatch, notice_harness):
+    config, telemetry = notice_harness
+    memory = MagicMock()
+    memory.config.notices = False
+    memory.vector_store.count.return_value = notices.SCALE_MEMORY_COUNT_THRESHOLD
+    to_thread = MagicMock()
+    monkeypatch.setattr(notices.asyncio, "to_thread", to_thread)
+
+    notices.display_first_run_notice(memory, "sync", "search")
+    notices.display_scale_threshold_notice(memory, "sync", "search", "top_k", "high_top_k", top_k=80)
+    assert notices.detect_scale_threshold_from_add_result(memory, [{"event": "ADD"}]) is None
+    asyncio.run(notices.display_temporal_usage_notice_async(memory, "async", "search", "query", "relative_phrase"))
+    asyncio.run(notices.display_first_run_notice_async(memory, "async", "search"))
+
+    telemetry.posthog.evaluate_flags.assert_not_called()
+    memory.vector_store.count.assert_not_called()
+    to_thread.assert_not_called()
+    assert config == {}
+
+
+def test_memory_config_notices_switch_defaults_on():
+    from mem0.configs.base import MemoryConfig
+
+    assert MemoryConfig().notices is True
+    assert MemoryConfig(notices=False).notices is False
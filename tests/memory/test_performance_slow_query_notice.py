@@ -42,6 +42,8 @@ def notice_harness(monkeypatch):
 
     monkeypatch.setattr(notices, "_load_config", lambda: config)
     monkeypatch.setattr(notices, "_write_config", write_config)
+    monkeypatch.setattr(notices, "_notice_config_cache", None)
+    monkeypatch.setattr(notices, "PERSIST_DEBOUNCE_SECONDS", 0)
     monkeypatch.setattr(notices.telemetry_module, "MEM0_TELEMETRY", True)
     monkeypatch.setattr(notices.telemetry_module, "_get_oss_telemetry", lambda: telemetry)
     return config, telemetry
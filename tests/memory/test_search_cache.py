@@ -0,0 +1,209 @@
+import asyncio
+import threading
+import time
+from unittest.mock import MagicMock
+
+import pytest
+
+from mem0.configs.base import MemoryConfig, SearchCacheConfig
+from mem0.memory.main import AsyncMemory, Memory
+from mem0.memory.search_cache import SearchCoalescer, make_search_key
+
+
+class TestSearchCoalescer:
+    def test_concurrent_identical_calls_share_one_execution(self):
+        coalescer = SearchCoalescer(ttl_seconds=0)
+        calls = []
+        release = threading.Event()
+
+        def slow_search():
+            calls.append(1)
+            release.wait(timeout=5)
+            return [{"id": "m1"}]
+
+        results = []
+        threads = [
+            threading.Thread(target=lambda: results.append(coalescer.run("k", {"user_id": "u1"}, slow_search)))
+            for _ in range(5)
+        ]
+        for t in threads:
+            t.start()
+        while coalescer.stats()["requests"] < 5:
+            time.sleep(0.001)
+        release.set()
+        for t in threads:
+            t.join()
+
+        assert len(calls) == 1
+        assert results == [[{"id": "m1"}]] * 5
+        # Each caller gets its own copy.
+        assert len({id(r) for r in results}) == 5
+        stats = coalescer.stats()
+        assert stats["coalesced"] == 4
+        assert stats["dedup_rate"] == pytest.approx(0.8)
+
+    def test_ttl_cache_and_scope_invalidation(self):
+        coalescer = SearchCoalescer(ttl_seconds=60)
+        search = MagicMock(return_value=["r"])
+
+        coalescer.run("a", {"user_id": "u1"}, search)
+        coalescer.run("a", {"user_id": "u1"}, search)
+        coalescer.run("b", {"user_id": "u1", "agent_id": "x"}, search)
+        assert search.call_count == 2
+
+        # A write for another agent of the same user leaves agent x alone but
+        # drops the user-wide search.
+        coalescer.invalidate({"user_id": "u1", "agent_id": "y"})
+        coalescer.run("b", {"user_id": "u1", "agent_id": "x"}, search)
+        assert search.call_count == 2
+        coalescer.run("a", {"user_id": "u1"}, search)
+        assert search.call_count == 3
+
+        coalescer.invalidate({"user_id": "u2"})
+        coalescer.run("a", {"user_id": "u1"}, search)
+        assert search.call_count == 3
+        assert coalescer.stats()["cache_hits"] == 3
+
+    def test_operator_scopes_are_invalidated_by_any_matching_write(self):
+        coalescer = SearchCoalescer(ttl_seconds=60)
+        search = MagicMock(return_value=["r"])
+
+        coalescer.run("in", {"user_id": {"in": ["a", "b"]}}, search)
+        coalescer.invalidate({"user_id": "a"})
+        coalescer.run("in", {"user_id": {"in": ["a", "b"]}}, search)
+        assert search.call_count == 2
+
+    def test_wildcard_scopes_are_invalidated_by_any_matching_write(self):
+        coalescer = SearchCoalescer(ttl_seconds=60)
+        search = MagicMock(return_value=["r"])
+
+        coalescer.run("any", {"user_id": "u1", "agent_id": "*"}, search)
+        coalescer.invalidate({"user_id": "u1", "agent_id": "x"})
+        coalescer.run("any", {"user_id": "u1", "agent_id": "*"}, search)
+        assert search.call_count == 2
+
+    def test_write_during_flight_prevents_caching(self):
+        coalescer = SearchCoalescer(ttl_seconds=60)
+
+        def search_with_concurrent_write():
+            coalescer.invalidate({"user_id": "u1"})
+            return ["stale"]
+
+        coalescer.run("k", {"user_id": "u1"}, search_with_concurrent_write)
+        assert coalescer.stats()["cached_entries"] == 0
+
+    def test_errors_propagate_and_are_not_cached(self):
+        coalescer = SearchCoalescer(ttl_seconds=60)
+        with pytest.raises(RuntimeError):
+            coalescer.run("k", {}, MagicMock(side_effect=RuntimeError("boom")))
+        assert coalescer.run("k", {}, lambda: ["ok"]) == ["ok"]
+
+    @pytest.mark.asyncio
+    async def test_async_calls_coalesce(self):
+        coalescer = SearchCoalescer(ttl_seconds=0)
+        calls = []
+
+        async def search():
+            calls.append(1)
+            await asyncio.sleep(0.01)
+            return ["r"]
+
+        results = await asyncio.gather(*(coalescer.run_async("k", {"user_id": "u1"}, search) for _ in range(4)))
+        assert results == [["r"]] * 4
+        assert len(calls) == 1
+        assert coalescer.stats()["coalesced"] == 3
+
+    @pytest.mark.asyncio
+    async def test_async_cancelled_caller_does_not_cancel_others(self):
+        coalescer = SearchCoalescer(ttl_seconds=0)
+
+        async def search():
+            await asyncio.sleep(0.02)
+            return ["r"]
+
+        first = asyncio.ensure_future(coalescer.run_async("k", {}, search))
+        second = asyncio.ensure_future(coalescer.run_async("k", {}, search))
+        await asyncio.sleep(0)
+        first.cancel()
+        assert await second == ["r"]
+
+    def test_search_key_normalizes_filter_order(self):
+        assert make_search_key("q", {"a": 1, "b": 2}, 5) == make_search_key("q", {"b": 2, "a": 1}, 5)
+        assert make_search_key("q", {"a": 1}, 5) != make_search_key("q", {"a": 1}, 6)
+
+
+def _mock_factories(mocker):
+    mocker.patch("mem0.utils.factory.EmbedderFactory.create", MagicMock())
+    mocker.patch("mem0.utils.factory.VectorStoreFactory.create", MagicMock())
+    mocker.patch("mem0.utils.factory.LlmFactory.create", MagicMock())
+    mocker.patch("mem0.memory.main.SQLiteManager", MagicMock())
+    mocker.patch("mem0.memory.main.capture_event")
+
+
+class TestMemorySearchCache:
+    @pytest.fixture
+    def memory(self, mocker):
+        _mock_factories(mocker)
+        config = MemoryConfig(search_cache=SearchCacheConfig(enabled=True, ttl_seconds=60))
+        return Memory(config)
+
+    def test_disabled_by_default(self, mocker):
+        _mock_factories(mocker)
+        assert Memory().search_cache is None
+
+    def test_repeated_search_hits_cache_until_scope_write(self, memory, mocker):
+        memory._search_vector_store = MagicMock(return_value=[{"id": "m1", "memory": "x"}])
+
+        first = memory.search("coffee", filters={"user_id": "u1"})
+        second = memory.search("coffee", filters={"user_id": "u1"})
+        assert first == second
+        assert memory._search_vector_store.call_count == 1
+
+        memory.search("coffee", filters={"user_id": "u2"})
+        assert memory._search_vector_store.call_count == 2
+
+        memory.vector_store.get.return_value = MagicMock(id="m1", payload={"data": "x", "user_id": "u1"})
+        memory.delete("m1")
+        memory.search("coffee", filters={"user_id": "u1"})
+        memory.search("coffee", filters={"user_id": "u2"})
+        assert memory._search_vector_store.call_count == 3
+
+    def test_wildcard_search_sees_writes_to_a_concrete_id(self, memory):
+        memory._search_vector_store = MagicMock(return_value=[{"id": "m1", "memory": "x"}])
+        filters = {"user_id": "u1", "agent_id": "*"}
+
+        memory.search("coffee", filters=filters)
+        memory.vector_store.get.return_value = MagicMock(
+            id="m1", payload={"data": "x", "user_id": "u1", "agent_id": "x"}
+        )
+        memory.delete("m1")
+        memory.search("coffee", filters=filters)
+        assert memory._search_vector_store.call_count == 2
+
+    def test_different_params_are_not_merged(self, memory):
+        memory._search_vector_store = MagicMock(return_value=[])
+        memory.search("coffee", filters={"user_id": "u1"}, top_k=5)
+        memory.search("coffee", filters={"user_id": "u1"}, top_k=10)
+        memory.search("coffee", filters={"user_id": "u1"}, top_k=10, threshold=0.5)
+        assert memory._search_vector_store.call_count == 3
+
+
+class TestAsyncMemorySearchCache:
+    @pytest.mark.asyncio
+    async def test_concurrent_searches_coalesce(self, mocker):
+        _mock_factories(mocker)
+        memory = AsyncMemory(MemoryConfig(search_cache=SearchCacheConfig(enabled=True, ttl_seconds=0)))
+        calls = []
+
+        async def fake_search(*args, **kwargs):
+            calls.append(1)
+            await asyncio.sleep(0.01)
+            return [{"id": "m1"}]
+
+        memory._search_vector_store = fake_search
+        results = await asyncio.gather(
+            *(memory.search("coffee", filters={"user_id": "u1"}) for _ in range(3))
+        )
+        assert all(r == {"results": [{"id": "m1"}]} for r in results)
+        assert len(calls) == 1
+        assert memory.search_cache.stats()["dedup_rate"] == pytest.approx(2 / 3)
@@ -299,3 +299,42 @@ class TestSQLiteManager:
         assert msg_count == 0
         assert hist_count == 0
         mgr2.close()
+
+    # ========== Scope Version Tests ==========
+
+    def test_scope_version_starts_at_zero(self, memory_manager):
+        assert memory_manager.get_scope_version() == 0
+        assert memory_manager.get_scope_version(user_id="u1") == 0
+
+    def test_scope_version_matches_narrower_scopes(self, memory_manager):
+        memory_manager.bump_scope_version("u1")
+        memory_manager.bump_scope_version("u1", "a1")
+        memory_manager.bump_scope_version("u1", "a2", "r1")
+        memory_manager.bump_scope_version("u2")
+
+        assert memory_manager.get_scope_version(user_id="u1") == 3
+        assert memory_manager.get_scope_version(user_id="u1", agent_id="a1") == 1
+        assert memory_manager.get_scope_version(agent_id="a2") == 1
+        assert memory_manager.get_scope_version(run_id="r1") == 1
+        assert memory_manager.get_scope_version(user_id="u2") == 1
+        assert memory_manager.get_scope_version(user_id="u3") == 0
+        assert memory_manager.get_scope_version() == 4
+
+    def test_epoch_bump_applies_to_every_scope(self, memory_manager):
+        memory_manager.bump_scope_version("u1")
+        memory_manager.bump_scope_version(floor=10)
+        assert memory_manager.get_scope_version(user_id="u1") == 11
+        assert memory_manager.get_scope_version(user_id="u2") == 10
+        # floor never lowers a counter
+        memory_manager.bump_scope_version(floor=3)
+        assert memory_manager.get_scope_version(user_id="u2") == 11
+
+    def test_reset_keeps_scope_versions(self, temp_db_path):
+        mgr = SQLiteManager(temp_db_path)
+        mgr.bump_scope_version("u1")
+        mgr.reset()
+        mgr.close()
+
+        mgr2 = SQLiteManager(temp_db_path)
+        assert mgr2.get_scope_version(user_id="u1") == 1
+        mgr2.close()
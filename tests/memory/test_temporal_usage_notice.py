@@ -4,6 +4,7 @@ from unittest.mock import AsyncMock, MagicMock
 import pytest
 
 from mem0.memory import main as memory_main
+from mem0.memory import telemetry as telemetry_module
 from mem0.memory.main import AsyncMemory, Memory
 
 
@@ -164,13 +165,15 @@ async def test_async_add_runs_scale_detection_in_thread(monkeypatch):
 
     monkeypatch.setattr(memory_main, "detect_scale_threshold_from_add_result", scale_detector)
     monkeypatch.setattr(memory_main.asyncio, "to_thread", to_thread)
+    monkeypatch.setattr(telemetry_module, "MEM0_TELEMETRY", True)
     monkeypatch.setattr(memory_main, "display_scale_threshold_notice_async", scale_notice)
     monkeypatch.setattr(memory_main, "display_first_run_notice_async", first_run_notice)
 
     result = await AsyncMemory.add(memory, "The user likes tea.", user_id="u1", infer=False)
 
     assert result == {"results": []}
-    assert to_thread_calls == [(scale_detector, (memory, []), {})]
+    # The scope-version bump also runs in a thread; only the detector matters here.
+    assert [call for call in to_thread_calls if call[0] is scale_detector] == [(scale_detector, (memory, []), {})]
     scale_detector.assert_called_once_with(memory, [])
     scale_notice.assert_awaited_once_with(
         memory,
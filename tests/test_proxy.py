@@ -1,10 +1,12 @@
 import inspect
+import threading
 from unittest.mock import Mock, patch
 
 import pytest
 
 from mem0 import Memory, MemoryClient
 from mem0.proxy.main import Chat, Completions, Mem0
+from mem0.proxy.write_queue import MemoryWriteQueue, conversation_key
 
 
 @pytest.fixture
@@ -71,6 +73,7 @@ def test_completions_create(mock_memory_client, mock_litellm):
 
     response = completions.create(model="gpt-4.1-nano-2025-04-14", messages=messages, user_id="test_user", temperature=0.7)
 
+    assert completions.write_queue.flush(timeout=5)
     mock_memory_client.add.assert_called_once()
     mock_memory_client.search.assert_called_once()
 
@@ -138,3 +141,134 @@ def test_completions_create_messages_default_does_not_leak_between_calls(mock_me
         f"Completions.create(messages=...) must default to None to avoid the "
         f"B006 shared-default-list bug; got {messages_default!r}."
     )
+
+
+def _turns(*contents):
+    roles = ["user", "assistant"]
+    return [{"role": roles[i % 2], "content": c} for i, c in enumerate(contents)]
+
+
+def test_write_queue_sends_only_messages_not_yet_stored():
+    add = Mock()
+    queue = MemoryWriteQueue(add, workers=1)
+    key = conversation_key(user_id="alice")
+
+    queue.submit(key, _turns("hi", "hello!", "I like tea"), user_id="alice")
+    assert queue.flush(timeout=5)
+    queue.submit(key, _turns("hi", "hello!", "I like tea", "noted", "and coffee"), user_id="alice")
+    assert queue.flush(timeout=5)
+
+    # The reply "noted" goes out with the user turn it answers.
+    assert [c.args[0] for c in add.call_args_list] == [
+        _turns("hi", "hello!", "I like tea"),
+        _turns("hi", "hello!", "I like tea", "noted", "and coffee")[2:],
+    ]
+    stats = queue.stats()
+    assert stats["written"] == 2 and stats["messages_trimmed"] == 2
+
+
+def test_write_queue_keeps_the_user_turn_a_reply_answers():
+    add = Mock()
+    queue = MemoryWriteQueue(add, workers=1)
+    key = conversation_key(user_id="alice")
+    queue.submit(key, _turns("I like tea"))
+    assert queue.flush(timeout=5)
+    queue.submit(key, _turns("I like tea", "noted"))
+    assert queue.flush(timeout=5)
+    queue.submit(key, _turns("I like tea", "noted"))
+    assert queue.flush(timeout=5)
+
+    assert [c.args[0] for c in add.call_args_list] == [_turns("I like tea"), _turns("I like tea", "noted")]
+    assert queue.stats()["skipped"] == 1
+
+
+def test_conversation_key_tells_threads_of_one_user_apart():
+    tea = _turns("I like tea", "noted", "and coffee")
+    assert conversation_key("alice", messages=tea) == conversation_key("alice", messages=tea[:1])
+    assert conversation_key("alice", messages=tea) != conversation_key("alice", messages=_turns("book a flight"))
+
+
+def _blocking_add():
+    running, release, calls = threading.Event(), threading.Event(), []
+
+    def add(messages, **kwargs):
+        calls.append(messages)
+        running.set()
+        release.wait(5)
+
+    return add, running, release, calls
+
+
+def test_write_queue_coalesces_turns_queued_behind_a_running_write():
+    add, running, release, calls = _blocking_add()
+    queue = MemoryWriteQueue(add, workers=1)
+    key = conversation_key(user_id="alice")
+    queue.submit(key, _turns("a"))
+    assert running.wait(5)
+    queue.submit(key, _turns("a", "b", "c"))
+    queue.submit(key, _turns("a", "b", "c", "d", "e"))
+    release.set()
+    assert queue.flush(timeout=5)
+
+    # The first write was already running; the two later turns became one add.
+    assert calls == [_turns("a"), _turns("a", "b", "c", "d", "e")]
+    assert queue.stats()["coalesced"] == 1
+
+
+def test_write_queue_keeps_the_latest_history_when_it_diverges():
+    add, running, release, calls = _blocking_add()
+    queue = MemoryWriteQueue(add, workers=1)
+    key = conversation_key(user_id="alice")
+    queue.submit(key, _turns("x"))
+    assert running.wait(5)
+    queue.submit(key, _turns("a", "b", "c"))
+    # A regenerated reply: neither history is a prefix of the other.
+    queue.submit(key, _turns("a", "B", "C"))
+    release.set()
+    assert queue.flush(timeout=5)
+
+    assert calls == [_turns("x"), _turns("a", "B", "C")]
+
+
+def test_write_queue_drops_writes_when_full():
+    add, running, release, _ = _blocking_add()
+    queue = MemoryWriteQueue(add, max_pending=1, workers=1)
+    assert queue.submit(conversation_key(user_id="a"), _turns("x"))
+    assert running.wait(5)
+    assert queue.submit(conversation_key(user_id="b"), _turns("x"))
+    assert not queue.submit(conversation_key(user_id="c"), _turns("x"))
+    assert queue.stats()["depth"] == 1
+
+    release.set()
+    assert queue.flush(timeout=5)
+    stats = queue.stats()
+    assert stats["dropped"] == 1 and stats["written"] == 2 and stats["depth"] == 0
+
+
+def test_retrieval_runs_while_the_request_is_validated(mock_memory_client, mock_litellm):
+    completions = Completions(mock_memory_client)
+    searching = threading.Event()
+
+    def search(**kwargs):
+        searching.set()
+        return [{"memory": "likes tea"}]
+
+    def supports_function_calling(model):
+        # Retrieval was started before the model check returns.
+        assert searching.wait(5)
+        return True
+
+    mock_memory_client.search.side_effect = search
+    mock_litellm.supports_function_calling.side_effect = supports_function_calling
+    mock_litellm.completion.return_value = {"choices": []}
+    messages = [{"role": "user", "content": "What should I drink?"}]
+
+    completions.create(model="gpt-4.1-nano-2025-04-14", messages=messages, user_id="alice")
+
+    sent = mock_litellm.completion.call_args[1]["messages"]
+    assert "likes tea" in sent[-1]["content"]
+    # The caller's message is left as is, so the queued write stores the question.
+    assert messages[-1]["content"] == "What should I drink?"
+    assert completions.write_queue.flush(timeout=5)
+    assert mock_memory_client.add.call_args.kwargs["messages"] == messages
+    assert completions.stats()["writes"]["written"] == 1
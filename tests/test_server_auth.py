@@ -11,7 +11,7 @@ round-trip) covering:
 import importlib
 import logging
 import os
-from unittest.mock import MagicMock, patch
+from unittest.mock import AsyncMock, MagicMock, patch
 
 import pytest
 
@@ -26,8 +26,10 @@ from fastapi.testclient import TestClient
 
 @pytest.fixture
 def _mock_memory():
-    """Patch Memory.from_config so the server imports without a real backend."""
+    """Patch AsyncMemory.from_config so the server imports without a real backend."""
     mock_instance = MagicMock()
+    for method in ("add", "search", "get", "get_all", "update", "history", "delete", "delete_all", "reset"):
+        setattr(mock_instance, method, AsyncMock())
     # Set up return values so CRUD endpoints return realistic responses
     mock_instance.get.return_value = {"id": "mem-1", "memory": "test memory", "user_id": "alice"}
     mock_instance.get_all.return_value = [
@@ -42,7 +44,7 @@ def _mock_memory():
     mock_instance.reset.return_value = None
 
     with patch.dict(os.environ, {"OPENAI_API_KEY": "fake-key"}):
-        with patch("mem0.Memory.from_config", return_value=mock_instance):
+        with patch("mem0.AsyncMemory.from_config", return_value=mock_instance):
             yield mock_instance
 
 
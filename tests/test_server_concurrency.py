@@ -0,0 +1,113 @@
+"""Tests for the REST server's concurrency limits and request-log writer.
+
+Add and search traffic get separate bulkheads, so a saturated add pool
+rejects only adds (503 + Retry-After) while searches keep flowing. Request
+logs are written in batches from a background thread and dropped, not
+blocked on, when the queue is full.
+"""
+
+import asyncio
+import os
+import sys
+import threading
+from unittest.mock import MagicMock
+
+import pytest
+
+pytest.importorskip("fastapi", reason="fastapi not installed")
+
+from fastapi import HTTPException  # noqa: E402
+
+# server/ modules use bare imports (from auth import ...), so the server
+# directory itself must be importable, mirroring how it runs in Docker.
+_SERVER_DIR = os.path.join(os.path.dirname(os.path.dirname(__file__)), "server")
+if _SERVER_DIR not in sys.path:
+    sys.path.insert(0, _SERVER_DIR)
+
+from bulkhead import Bulkhead  # noqa: E402
+from request_logs import RequestLogWriter  # noqa: E402
+
+
+class TestBulkhead:
+    @pytest.mark.asyncio
+    async def test_limits_concurrency_and_rejects_after_timeout(self):
+        bulkhead = Bulkhead("add", limit=2, timeout=0.05)
+        release = asyncio.Event()
+        running = []
+
+        async def hold():
+            async with bulkhead.slot():
+                running.append(1)
+                await release.wait()
+
+        holders = [asyncio.ensure_future(hold()) for _ in range(2)]
+        await asyncio.sleep(0.01)
+        assert bulkhead.stats()["active"] == 2
+
+        with pytest.raises(HTTPException) as exc:
+            async with bulkhead.slot():
+                pass
+        assert exc.value.status_code == 503
+        assert exc.value.headers == {"Retry-After": "1"}
+        assert bulkhead.stats()["rejected"] == 1
+
+        release.set()
+        await asyncio.gather(*holders)
+        async with bulkhead.slot():
+            assert bulkhead.stats()["active"] == 1
+        assert bulkhead.stats() == {"limit": 2, "active": 0, "waiting": 0, "rejected": 1}
+
+    @pytest.mark.asyncio
+    async def test_separate_bulkheads_are_independent(self):
+        adds = Bulkhead("add", limit=1, timeout=0.05)
+        searches = Bulkhead("search", limit=1, timeout=0.05)
+        async with adds.slot():
+            async with searches.slot():
+                assert searches.stats()["active"] == 1
+
+
+class TestRequestLogWriter:
+    def test_rows_are_written_in_batches(self):
+        sessions = []
+
+        def session_factory():
+            session = MagicMock()
+            sessions.append(session)
+            return session
+
+        writer = RequestLogWriter(session_factory, batch_size=50, flush_interval=0.01)
+        for i in range(120):
+            assert writer.submit("GET", f"/memories/{i}", 200, 1.5, "api_key")
+        assert writer.flush(timeout=5)
+        writer.close()
+
+        rows = [row for s in sessions for call in s.add_all.call_args_list for row in call.args[0]]
+        assert len(rows) == 120
+        assert rows[0].path == "/memories/0"
+        assert rows[0].created_at is not None
+        assert len(sessions) <= 120 // 50 + 2
+        assert writer.stats()["written"] == 120
+
+    def test_full_queue_drops_instead_of_blocking(self):
+        gate = threading.Event()
+
+        def blocked_session():
+            gate.wait(timeout=5)
+            return MagicMock()
+
+        writer = RequestLogWriter(blocked_session, max_queue=2, batch_size=1, flush_interval=0.01)
+        results = [writer.submit("GET", "/memories", 200, 1.0, "none") for _ in range(10)]
+        assert results.count(False) >= 7
+        assert writer.stats()["dropped"] == results.count(False)
+        gate.set()
+        writer.close()
+
+    def test_write_failures_are_counted_not_raised(self):
+        session = MagicMock()
+        session.commit.side_effect = RuntimeError("db down")
+        writer = RequestLogWriter(lambda: session, flush_interval=0.01)
+        writer.submit("POST", "/memories", 200, 3.0, "none")
+        assert writer.flush(timeout=5)
+        writer.close()
+        assert writer.stats()["failed"] == 1
+        session.rollback.assert_called_once()
@@ -0,0 +1,101 @@
+"""Tests for conditional GET support on the REST memory endpoints.
+
+GET /memories, /memories/{id} and /memories/{id}/history return an ETag and
+answer If-None-Match with 304 while the underlying data is unchanged.
+"""
+
+import importlib
+import os
+from unittest.mock import AsyncMock, MagicMock, patch
+
+import pytest
+
+pytest.importorskip("fastapi", reason="fastapi not installed")
+
+from fastapi.testclient import TestClient
+
+
+@pytest.fixture
+def mock_memory():
+    mock_instance = MagicMock()
+    for method in ("add", "search", "get", "get_all", "update", "history", "delete", "delete_all", "reset"):
+        setattr(mock_instance, method, AsyncMock())
+    mock_instance.get_scope_version = AsyncMock(return_value=7)
+    mock_instance.get_all.return_value = {"results": [{"id": "mem-1", "memory": "test"}]}
+    mock_instance.get.return_value = {
+        "id": "mem-1",
+        "memory": "test",
+        "hash": "abc",
+        "updated_at": "2024-01-01T00:00:00+00:00",
+    }
+    mock_instance.history.return_value = [{"id": "h1", "memory_id": "mem-1", "event": "ADD"}]
+
+    with patch.dict(os.environ, {"OPENAI_API_KEY": "fake-key", "ADMIN_API_KEY": ""}):
+        with patch("mem0.AsyncMemory.from_config", return_value=mock_instance):
+            yield mock_instance
+
+
+@pytest.fixture
+def client(mock_memory):
+    import server.main as server_main
+
+    with patch.dict(os.environ, {"ADMIN_API_KEY": ""}):
+        importlib.reload(server_main)
+    return TestClient(server_main.app)
+
+
+class TestListMemoriesETag:
+    def test_unchanged_scope_returns_304_without_querying(self, client, mock_memory):
+        first = client.get("/memories", params={"user_id": "u1"})
+        assert first.status_code == 200
+        etag = first.headers["etag"]
+        assert first.headers["cache-control"] == "private, no-cache"
+        mock_memory.get_scope_version.assert_called_with(user_id="u1")
+
+        second = client.get("/memories", params={"user_id": "u1"}, headers={"If-None-Match": etag})
+        assert second.status_code == 304
+        assert second.content == b""
+        assert second.headers["etag"] == etag
+        assert mock_memory.get_all.call_count == 1
+
+    def test_scope_write_changes_etag(self, client, mock_memory):
+        etag = client.get("/memories", params={"user_id": "u1"}).headers["etag"]
+        mock_memory.get_scope_version.return_value = 8
+        resp = client.get("/memories", params={"user_id": "u1"}, headers={"If-None-Match": etag})
+        assert resp.status_code == 200
+        assert resp.headers["etag"] != etag
+
+    def test_query_params_are_part_of_etag(self, client):
+        base = client.get("/memories", params={"user_id": "u1"}).headers["etag"]
+        assert client.get("/memories", params={"user_id": "u2"}).headers["etag"] != base
+        assert client.get("/memories", params={"user_id": "u1", "top_k": 5}).headers["etag"] != base
+        assert client.get("/memories", params={"user_id": "u1", "show_expired": True}).headers["etag"] != base
+
+    def test_falls_back_to_content_etag_without_scope_versions(self, client, mock_memory):
+        del mock_memory.get_scope_version
+        etag = client.get("/memories", params={"user_id": "u1"}).headers["etag"]
+        resp = client.get("/memories", params={"user_id": "u1"}, headers={"If-None-Match": f'W/{etag}, "other"'})
+        assert resp.status_code == 304
+
+        mock_memory.get_all.return_value = {"results": []}
+        assert client.get("/memories", params={"user_id": "u1"}, headers={"If-None-Match": etag}).status_code == 200
+
+
+class TestMemoryETag:
+    def test_get_memory_revalidates_on_hash_and_updated_at(self, client, mock_memory):
+        etag = client.get("/memories/mem-1").headers["etag"]
+        assert client.get("/memories/mem-1", headers={"If-None-Match": etag}).status_code == 304
+
+        mock_memory.get.return_value = {**mock_memory.get.return_value, "updated_at": "2024-02-01T00:00:00+00:00"}
+        resp = client.get("/memories/mem-1", headers={"If-None-Match": etag})
+        assert resp.status_code == 200
+        assert resp.json()["updated_at"] == "2024-02-01T00:00:00+00:00"
+
+    def test_history_etag_changes_when_entries_are_added(self, client, mock_memory):
+        etag = client.get("/memories/mem-1/history").headers["etag"]
+        assert client.get("/memories/mem-1/history", headers={"If-None-Match": etag}).status_code == 304
+
+        mock_memory.history.return_value = mock_memory.history.return_value + [{"id": "h2", "event": "UPDATE"}]
+        resp = client.get("/memories/mem-1/history", headers={"If-None-Match": etag})
+        assert resp.status_code == 200
+        assert len(resp.json()) == 2
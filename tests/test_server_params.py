@@ -8,7 +8,7 @@ previously silently dropped by Pydantic v2's default extra='ignore' behavior.
 
 import importlib
 import os
-from unittest.mock import MagicMock, patch
+from unittest.mock import AsyncMock, MagicMock, patch
 
 import pytest
 
@@ -24,8 +24,10 @@ from fastapi.testclient import TestClient
 
 @pytest.fixture
 def _mock_memory():
-    """Patch Memory.from_config so the server imports without a real backend."""
+    """Patch AsyncMemory.from_config so the server imports without a real backend."""
     mock_instance = MagicMock()
+    for method in ("add", "search", "get", "get_all", "update", "history", "delete", "delete_all", "reset"):
+        setattr(mock_instance, method, AsyncMock())
     mock_instance.add.return_value = {"results": [{"id": "mem-1", "event": "ADD", "memory": "test"}]}
     mock_instance.search.return_value = [{"id": "mem-1", "memory": "test", "score": 0.9}]
     mock_instance.get.return_value = {"id": "mem-1", "memory": "test memory"}
@@ -37,7 +39,7 @@ def _mock_memory():
     mock_instance.reset.return_value = None
 
     with patch.dict(os.environ, {"OPENAI_API_KEY": "fake-key", "ADMIN_API_KEY": ""}):
-        with patch("mem0.Memory.from_config", return_value=mock_instance):
+        with patch("mem0.AsyncMemory.from_config", return_value=mock_instance):
             yield mock_instance
 
 
@@ -82,11 +82,13 @@ class TestTelemetryEnabled:
         with patch.object(telemetry_module, "MEM0_TELEMETRY", True):
             mock_at = MagicMock()
             with patch.object(telemetry_module, "_oss_telemetry_instance", mock_at):
-                mock_memory = MagicMock()
-                mock_memory.config.graph_store.config = None
-                mock_memory.api_version = "v1"
-                telemetry_module.capture_event("test.event", mock_memory)
-                mock_at.capture_event.assert_called_once()
+                with patch.object(telemetry_module, "MEM0_TELEMETRY_SAMPLE_RATE", 1.0):
+                    mock_memory = MagicMock()
+                    mock_memory.config.graph_store.config = None
+                    mock_memory.api_version = "v1"
+                    telemetry_module.capture_event("test.event", mock_memory)
+                    assert telemetry_module.flush_events()
+                    mock_at.capture_event.assert_called_once()
 
     def test_anonymous_capture_event_passes_flags_to_posthog(self):
         """capture_event() should use PostHog's event-first API and preserve flag snapshots."""
@@ -219,37 +221,39 @@ class TestTelemetrySingleton:
     def test_capture_event_does_not_create_new_instance_each_call(self):
         """capture_event() should not create a new AnonymousTelemetry per call."""
         with patch.object(telemetry_module, "MEM0_TELEMETRY", True):
-            with patch("mem0.memory.telemetry.Posthog"):
-                with patch("mem0.memory.telemetry.get_or_create_user_id", return_value="u"):
-                    with patch("atexit.register"):
-                        mock_memory = MagicMock()
-                        mock_memory.config.graph_store.config = None
-                        mock_memory.api_version = "v1"
+            with patch.object(telemetry_module, "MEM0_TELEMETRY_SAMPLE_RATE", 1.0):
+                with patch("mem0.memory.telemetry.Posthog"):
+                    with patch("mem0.memory.telemetry.get_or_create_user_id", return_value="u"):
+                        with patch("atexit.register"):
+                            mock_memory = MagicMock()
+                            mock_memory.config.graph_store.config = None
+                            mock_memory.api_version = "v1"
 
-                        telemetry_module.capture_event("e1", mock_memory)
-                        first = telemetry_module._oss_telemetry_instance
+                            telemetry_module.capture_event("e1", mock_memory)
+                            first = telemetry_module._oss_telemetry_instance
 
-                        telemetry_module.capture_event("e2", mock_memory)
-                        second = telemetry_module._oss_telemetry_instance
+                            telemetry_module.capture_event("e2", mock_memory)
+                            second = telemetry_module._oss_telemetry_instance
 
-                        assert first is second
+                            assert first is second
 
     def test_posthog_constructed_once_across_many_capture_event_calls(self):
         """The core leak fix: Posthog() should only be called once no matter how
         many times capture_event() is invoked."""
         with patch.object(telemetry_module, "MEM0_TELEMETRY", True):
-            with patch("mem0.memory.telemetry.Posthog") as mock_posthog_cls:
-                with patch("mem0.memory.telemetry.get_or_create_user_id", return_value="u"):
-                    with patch("atexit.register"):
-                        mock_memory = MagicMock()
-                        mock_memory.config.graph_store.config = None
-                        mock_memory.api_version = "v1"
-
-                        for i in range(50):
-                            telemetry_module.capture_event(f"event_{i}", mock_memory)
-
-                        # Only ONE Posthog client created, not 50
-                        assert mock_posthog_cls.call_count == 1
+            with patch.object(telemetry_module, "MEM0_TELEMETRY_SAMPLE_RATE", 1.0):
+                with patch("mem0.memory.telemetry.Posthog") as mock_posthog_cls:
+                    with patch("mem0.memory.telemetry.get_or_create_user_id", return_value="u"):
+                        with patch("atexit.register"):
+                            mock_memory = MagicMock()
+                            mock_memory.config.graph_store.config = None
+                            mock_memory.api_version = "v1"
+
+                            for i in range(50):
+                                telemetry_module.capture_event(f"event_{i}", mock_memory)
+
+                            # Only ONE Posthog client created, not 50
+                            assert mock_posthog_cls.call_count == 1
 
     def test_shutdown_clears_singleton(self):
         """_shutdown_oss_telemetry() should close and clear the singleton."""
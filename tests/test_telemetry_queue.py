@@ -0,0 +1,140 @@
+"""Tests for the OSS telemetry capture path.
+
+capture_event() decides sampling before doing any work and hands kept events
+to a bounded queue; a single background thread builds them and passes them to
+the sink. LocalTelemetrySink keeps events in memory so nothing is sent.
+"""
+
+import gc
+import time
+import weakref
+from types import SimpleNamespace
+from unittest.mock import MagicMock, patch
+
+import pytest
+
+import mem0.memory.telemetry as telemetry_module
+
+# Generous enough for slow CI machines; the measured cost is a few microseconds.
+CAPTURE_OVERHEAD_BUDGET_SECONDS = 50e-6
+
+
+def _memory():
+    memory = MagicMock()
+    memory.collection_name = "mem0"
+    memory.embedding_model.config.embedding_dims = 1536
+    memory.api_version = "v1.1"
+    return memory
+
+
+@pytest.fixture
+def sink():
+    local = telemetry_module.LocalTelemetrySink()
+    with patch.object(telemetry_module, "MEM0_TELEMETRY", True):
+        with patch.object(telemetry_module, "_oss_telemetry_instance", local):
+            with patch.object(telemetry_module, "_event_queue", telemetry_module._EventQueue()):
+                yield local
+                telemetry_module.flush_events()
+
+
+def test_sampled_out_events_do_no_work(sink):
+    memory = MagicMock()
+    with patch.object(telemetry_module, "MEM0_TELEMETRY_SAMPLE_RATE", 0.0):
+        with patch.object(telemetry_module, "_get_oss_telemetry") as get_telemetry:
+            telemetry_module.capture_event("mem0.search", memory, {"filters": telemetry_module.TelemetryFilters({})})
+
+    get_telemetry.assert_not_called()
+    assert memory.mock_calls == []
+    assert telemetry_module._event_queue._thread is None
+
+
+def test_kept_events_are_built_on_the_worker(sink):
+    with patch.object(telemetry_module, "MEM0_TELEMETRY_SAMPLE_RATE", 1.0):
+        telemetry_module.capture_event(
+            "mem0.search",
+            _memory(),
+            {"limit": 5, "filters": telemetry_module.TelemetryFilters({"user_id": "alice", "category": "x"})},
+        )
+    assert telemetry_module.flush_events()
+
+    [(name, props)] = sink.events
+    assert name == "mem0.search"
+    assert props["keys"] == ["user_id", "category"]
+    assert props["encoded_ids"] == {"user_id": "6384e2b2184bcbf58eccf10ca7a6563c"}
+    assert props["limit"] == 5 and props["sample_rate"] == 1.0
+    assert props["vector_size"] == 1536 and props["function"].endswith(".v1.1")
+    assert "filters" not in props and telemetry_module._PRESAMPLED_PROPERTY not in props
+
+
+def test_queued_events_do_not_keep_the_memory_alive(sink):
+    class Memory:
+        collection_name = "mem0"
+        api_version = "v1.1"
+        vector_store = llm = object()
+        embedding_model = SimpleNamespace(config=SimpleNamespace(embedding_dims=1536))
+
+    memory = Memory()
+    ref = weakref.ref(memory)
+    queue = telemetry_module._event_queue
+    queue._thread = MagicMock()  # keep the worker from draining
+    with patch.object(telemetry_module, "MEM0_TELEMETRY_SAMPLE_RATE", 1.0):
+        telemetry_module.capture_event("mem0.add", memory)
+    del memory
+    gc.collect()
+
+    assert ref() is None
+    [(_, _, snapshot, _, _)] = queue._events
+    assert snapshot["collection"] == "mem0" and snapshot["function"].endswith("Memory.v1.1")
+    queue._events.clear()
+    queue._thread = None
+
+
+def test_lifecycle_events_are_never_sampled(sink):
+    with patch.object(telemetry_module, "MEM0_TELEMETRY_SAMPLE_RATE", 0.0):
+        telemetry_module.capture_event("mem0.init", _memory(), {"sync_type": "sync"})
+    telemetry_module.flush_events()
+    assert [name for name, _ in sink.events] == ["mem0.init"]
+
+
+def test_presampled_events_are_not_sampled_again_by_posthog():
+    msg = {"event": "mem0.add", "properties": {"sample_rate": 0.1, telemetry_module._PRESAMPLED_PROPERTY: True}}
+    with patch("mem0.memory.telemetry.random.random", return_value=0.999):
+        result = telemetry_module._sampling_before_send(msg)
+    assert result["properties"] == {"sample_rate": 0.1}
+
+
+def test_full_queue_drops_new_events():
+    queue = telemetry_module._EventQueue(max_events=2)
+    queue._thread = MagicMock()  # keep the worker from draining
+    assert queue.put(("a",)) and queue.put(("b",))
+    assert not queue.put(("c",))
+    assert queue.dropped == 1 and len(queue._events) == 2
+
+
+def test_local_sink_is_selected_by_env(monkeypatch):
+    monkeypatch.setenv("MEM0_TELEMETRY_SINK", "local")
+    with patch.object(telemetry_module, "MEM0_TELEMETRY", True):
+        with patch.object(telemetry_module, "_oss_telemetry_instance", None):
+            with patch("mem0.memory.telemetry.Posthog") as posthog:
+                with patch("atexit.register"):
+                    telemetry = telemetry_module._get_oss_telemetry()
+    assert isinstance(telemetry, telemetry_module.LocalTelemetrySink)
+    posthog.assert_not_called()
+
+
+def test_capture_event_overhead_is_within_budget(sink):
+    """Microbenchmark: per-call cost on the request thread for kept events."""
+    memory = _memory()
+    calls = 2000
+    best = float("inf")
+    with patch.object(telemetry_module, "MEM0_TELEMETRY_SAMPLE_RATE", 1.0):
+        for _ in range(5):
+            started = time.perf_counter()
+            for _ in range(calls):
+                telemetry_module.capture_event(
+                    "mem0.search", memory, {"limit": 5, "filters": telemetry_module.TelemetryFilters({"user_id": "u"})}
+                )
+            best = min(best, (time.perf_counter() - started) / calls)
+            telemetry_module.flush_events()
+
+    assert best < CAPTURE_OVERHEAD_BUDGET_SECONDS, f"{best * 1e6:.1f}us per capture_event call"
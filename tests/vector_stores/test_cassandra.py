@@ -1,5 +1,6 @@
 import json
-from unittest.mock import Mock, patch
+from types import SimpleNamespace
+from unittest.mock import MagicMock, Mock, patch
 
 import pytest
 
@@ -10,7 +11,7 @@ from mem0.vector_stores.cassandra import CassandraDB, OutputData
 def mock_session():
     """Create a mock Cassandra session."""
     session = Mock()
-    session.execute = Mock(return_value=Mock())
+    session.execute = Mock(return_value=MagicMock())
     session.prepare = Mock(return_value=Mock())
     session.set_keyspace = Mock()
     return session
@@ -91,27 +92,186 @@ def test_insert(cassandra_instance):
     assert cassandra_instance.session.execute.called
 
 
+def _executed_queries(session):
+    queries = [getattr(c.args[0], "query_string", c.args[0]) for c in session.execute.call_args_list]
+    return [" ".join(str(q).split()) for q in queries]
+
+
+def test_create_col_uses_native_vector_and_sai_indexes(cassandra_instance):
+    cassandra_instance.session.execute.reset_mock()
+    cassandra_instance.create_col(name="new_collection", vector_size=256)
+
+    queries = _executed_queries(cassandra_instance.session)
+    assert "embedding vector<float, 256>" in queries[0]
+    assert all(f"{c} text" in queries[0] for c in ("user_id", "agent_id", "run_id"))
+    assert any("(embedding) USING 'StorageAttachedIndex'" in q and "'cosine'" in q for q in queries)
+    for column in ("user_id", "agent_id", "run_id"):
+        assert any(f"({column}) USING 'StorageAttachedIndex'" in q for q in queries)
+
+
+def _ann_row(row_id, score, payload):
+    return SimpleNamespace(id=row_id, score=score, payload=json.dumps(payload))
+
+
 def test_search(cassandra_instance):
     """Test vector search."""
-    # Mock the database response
-    mock_row1 = Mock()
-    mock_row1.id = 'id1'
-    mock_row1.vector = [0.1, 0.2, 0.3]
-    mock_row1.payload = json.dumps({"text": "test1"})
+    cassandra_instance.session.prepare = Mock(side_effect=lambda q: q)
+    cassandra_instance.session.execute = Mock(return_value=[
+        _ann_row("id1", 0.95, {"text": "test1", "user_id": "u1"}),
+        _ann_row("id2", 0.75, {"text": "test2", "user_id": "u1"}),
+    ])
 
-    mock_row2 = Mock()
-    mock_row2.id = 'id2'
-    mock_row2.vector = [0.4, 0.5, 0.6]
-    mock_row2.payload = json.dumps({"text": "test2"})
+    query_vector = [0.2, 0.3, 0.4]
+    results = cassandra_instance.search(query="test", vectors=query_vector, top_k=5, filters={"user_id": "u1"})
 
-    cassandra_instance.session.execute = Mock(return_value=[mock_row1, mock_row2])
+    assert [r.id for r in results] == ["id1", "id2"]
+    assert results[0].score == pytest.approx(0.9)
+    cql, params = cassandra_instance.session.execute.call_args.args
+    cql = " ".join(cql.split())
+    assert "WHERE user_id = ? ORDER BY embedding ANN OF ? LIMIT ?" in cql
+    assert params == (query_vector, "u1", query_vector, 5)
 
-    query_vector = [0.2, 0.3, 0.4]
-    results = cassandra_instance.search(query="test", vectors=query_vector, top_k=5)
 
-    assert isinstance(results, list)
-    assert len(results) <= 5
-    assert cassandra_instance.session.execute.called
+def test_search_with_filters(cassandra_instance):
+    """Non-entity filters are matched on the payload, widening the ANN limit."""
+    cassandra_instance.session.prepare = Mock(side_effect=lambda q: q)
+    rows = [_ann_row(f"id{i}", 1 - i / 100, {"category": "A" if i % 5 == 0 else "B"}) for i in range(40)]
+    cassandra_instance.session.execute = Mock(side_effect=lambda cql, params: rows[:params[-1]])
+
+    results = cassandra_instance.search(
+        query="test",
+        vectors=[0.2, 0.3, 0.4],
+        top_k=5,
+        filters={"category": "A"}
+    )
+
+    assert [r.id for r in results] == ["id0", "id5", "id10", "id15", "id20"]
+    assert [c.args[1][-1] for c in cassandra_instance.session.execute.call_args_list] == [20, 80]
+    cql = cassandra_instance.session.execute.call_args.args[0]
+    assert "WHERE" not in cql
+
+
+def test_migrates_legacy_list_column_table(mock_cluster, mock_session):
+    legacy_rows = [
+        SimpleNamespace(id="id1", vector=[0.1, 0.2], payload=json.dumps({"data": "a", "user_id": "u1"})),
+        SimpleNamespace(id="id2", vector=[0.3], payload=json.dumps({"data": "b"})),  # wrong dims
+    ]
+
+    def execute(query, params=None):
+        text = str(getattr(query, "query_string", query))
+        if "system_schema.columns" in text:
+            return [SimpleNamespace(column_name=n, type=t)
+                    for n, t in [("id", "text"), ("vector", "list<float>"), ("payload", "text")]]
+        if text.startswith("SELECT id, vector, payload"):
+            return legacy_rows
+        return MagicMock()
+
+    mock_session.execute = Mock(side_effect=execute)
+    mock_session.prepare = Mock(side_effect=lambda q: " ".join(q.split()))
+    with patch('mem0.vector_stores.cassandra.Cluster') as mock_cluster_class:
+        mock_cluster_class.return_value = mock_cluster
+        CassandraDB(contact_points=['127.0.0.1'], keyspace='ks', collection_name='mem', embedding_model_dims=2)
+
+    queries = _executed_queries(mock_session)
+    assert "ALTER TABLE ks.mem ADD embedding vector<float, 2>" in queries
+    assert "ALTER TABLE ks.mem ADD user_id text" in queries
+    updates = [c.args[1] for c in mock_session.execute.call_args_list if str(c.args[0]).startswith("UPDATE")]
+    assert updates == [([0.1, 0.2], "u1", None, None, None, "id1")]
+    assert any("(embedding) USING 'StorageAttachedIndex'" in q for q in queries)
+    assert queries[-1] == "ALTER TABLE ks.mem DROP vector"
+
+
+def test_backfills_text_column_of_pre_keyword_table(mock_cluster, mock_session):
+    columns = [("id", "text"), ("embedding", "vector<float, 2>"), ("user_id", "text"), ("agent_id", "text"),
+               ("run_id", "text"), ("payload", "text")]
+    rows = [SimpleNamespace(id="id1", payload=json.dumps({"data": "a", "text_lemmatized": "like tea"}))]
+
+    def execute(query, params=None):
+        text = str(getattr(query, "query_string", query))
+        if "system_schema.columns" in text:
+            return [SimpleNamespace(column_name=n, type=t) for n, t in columns]
+        if text.startswith("SELECT id, payload"):
+            return rows
+        return MagicMock()
+
+    mock_session.execute = Mock(side_effect=execute)
+    mock_session.prepare = Mock(side_effect=lambda q: " ".join(q.split()))
+    with patch('mem0.vector_stores.cassandra.Cluster') as mock_cluster_class:
+        mock_cluster_class.return_value = mock_cluster
+        CassandraDB(contact_points=['127.0.0.1'], keyspace='ks', collection_name='mem', embedding_model_dims=2)
+
+    queries = _executed_queries(mock_session)
+    assert "ALTER TABLE ks.mem ADD text_lemmatized text" in queries
+    assert not any("ADD embedding" in q or "DROP vector" in q for q in queries)
+    updates = [c.args[1] for c in mock_session.execute.call_args_list if str(c.args[0]).startswith("UPDATE")]
+    assert updates == [("like tea", "id1")]
+    assert any("(text_lemmatized) USING 'StorageAttachedIndex'" in q and "index_analyzer" in q for q in queries)
+
+
+def test_keyword_search_ranks_term_matches_with_bm25(cassandra_instance):
+    rows = {
+        "tea": [
+            SimpleNamespace(id="a", text_lemmatized="like green tea", payload=json.dumps({"data": "a"})),
+            SimpleNamespace(id="b", text_lemmatized="tea tea with milk", payload=json.dumps({"data": "b"})),
+            SimpleNamespace(id="c", text_lemmatized="tea", payload=json.dumps({"data": "c", "category": "x"})),
+        ],
+        "green": [
+            SimpleNamespace(id="a", text_lemmatized="like green tea", payload=json.dumps({"data": "a"})),
+        ],
+    }
+    counts = []
+
+    def execute(query, params):
+        if query.startswith("SELECT COUNT(*)"):
+            counts.append((query, params))
+            return Mock(one=Mock(return_value=SimpleNamespace(count=100)))
+        return rows[params[0]]
+
+    cassandra_instance.session.prepare = Mock(side_effect=lambda q: " ".join(q.split()))
+    cassandra_instance.session.execute = Mock(side_effect=execute)
+
+    results = cassandra_instance.keyword_search("green tea", top_k=2, filters={"user_id": "u1", "category": None})
+
+    assert [r.id for r in results] == ["a", "b"]
+    assert results[0].score > results[1].score > 0
+    searches = [c.args for c in cassandra_instance.session.execute.call_args_list if c.args[0] != counts[0][0]]
+    assert all("text_lemmatized : ?" in cql and "user_id = ?" in cql for cql, _ in searches)
+    assert [params[:2] for _, params in searches] == [("green", "u1"), ("tea", "u1")]
+    assert cassandra_instance.keyword_search("  ", top_k=2) == []
+
+    # "tea" matches every candidate but only 3 of the scope's 100 rows, so it
+    # still carries weight; the count is reused until it expires.
+    assert counts == [("SELECT COUNT(*) AS count FROM test_keyspace.test_collection WHERE user_id = ?", ("u1",))]
+    with patch("mem0.vector_stores.cassandra.bm25_rank", return_value=[]) as rank:
+        cassandra_instance.keyword_search("tea", filters={"user_id": "u1"})
+    assert rank.call_args.kwargs["total_docs"] == 100 and len(counts) == 1
+
+
+def test_keyword_search_without_a_scope_count_ranks_against_the_candidates(cassandra_instance):
+    row = SimpleNamespace(id="a", text_lemmatized="tea", payload="{}")
+    counts = []
+
+    def execute(query, params):
+        if query.startswith("SELECT COUNT(*)"):
+            counts.append(params)
+            raise RuntimeError("timed out")
+        return [row]
+
+    cassandra_instance.session.prepare = Mock(side_effect=lambda q: " ".join(q.split()))
+    cassandra_instance.session.execute = Mock(side_effect=execute)
+    with patch("mem0.vector_stores.cassandra.bm25_rank", return_value=[]) as rank:
+        cassandra_instance.keyword_search("tea", filters={"user_id": "u1"})
+        cassandra_instance.keyword_search("tea", filters={"user_id": "u1"})
+        # Without entity filters the count would scan the whole table.
+        cassandra_instance.keyword_search("tea")
+    assert [c.kwargs["total_docs"] for c in rank.call_args_list] == [1, 1, 1]
+    # The failed count is cached like a successful one.
+    assert counts == [("u1",)]
+
+
+def test_keyword_search_disabled_without_text_analyzers(cassandra_instance):
+    cassandra_instance._text_index = False
+    assert cassandra_instance.keyword_search("tea") is None
 
 
 def test_delete(cassandra_instance):
@@ -246,35 +406,6 @@ def test_astra_db_connection(mock_cluster, mock_session):
         assert instance.secure_connect_bundle == '/path/to/bundle.zip'
 
 
-def test_search_with_filters(cassandra_instance):
-    """Test vector search with filters."""
-    # Mock the database response
-    mock_row1 = Mock()
-    mock_row1.id = 'id1'
-    mock_row1.vector = [0.1, 0.2, 0.3]
-    mock_row1.payload = json.dumps({"text": "test1", "category": "A"})
-
-    mock_row2 = Mock()
-    mock_row2.id = 'id2'
-    mock_row2.vector = [0.4, 0.5, 0.6]
-    mock_row2.payload = json.dumps({"text": "test2", "category": "B"})
-
-    cassandra_instance.session.execute = Mock(return_value=[mock_row1, mock_row2])
-
-    query_vector = [0.2, 0.3, 0.4]
-    results = cassandra_instance.search(
-        query="test",
-        vectors=query_vector,
-        top_k=5,
-        filters={"category": "A"}
-    )
-
-    assert isinstance(results, list)
-    # Should only return filtered results
-    for result in results:
-        assert result.payload.get("category") == "A"
-
-
 def test_output_data_model():
     """Test OutputData model."""
     data = OutputData(
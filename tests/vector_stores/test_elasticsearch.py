@@ -208,7 +208,7 @@ class TestElasticsearchDB(unittest.TestCase):
         self.assertEqual(body["knn"]["field"], "vector")
         self.assertEqual(body["knn"]["query_vector"], vectors)
         self.assertEqual(body["knn"]["k"], 5)
-        self.assertEqual(body["knn"]["num_candidates"], 10)
+        self.assertEqual(body["knn"]["num_candidates"], 100)
 
         # Verify results
         self.assertEqual(len(results), 1)
@@ -216,6 +216,61 @@ class TestElasticsearchDB(unittest.TestCase):
         self.assertEqual(results[0].score, 0.8)
         self.assertEqual(results[0].payload, {"key1": "value1"})
 
+    def test_num_candidates_is_configurable(self):
+        self.client_mock.search.return_value = {"hits": {"hits": []}}
+        self.es_db.search(query="", vectors=[0.1] * 1536, top_k=60)
+        self.assertEqual(self.client_mock.search.call_args[1]["body"]["knn"]["num_candidates"], 240)
+
+        self.es_db.num_candidates = 500
+        self.es_db.search(query="", vectors=[0.1] * 1536, top_k=60)
+        self.assertEqual(self.client_mock.search.call_args[1]["body"]["knn"]["num_candidates"], 500)
+
+    def test_hybrid_search_is_one_msearch_with_both_raw_scores(self):
+        self.client_mock.msearch.return_value = {
+            "responses": [
+                {"hits": {"hits": [{"_id": "id1", "_score": 0.9, "_source": {"metadata": {"data": "tea"}}}]}},
+                {"hits": {"hits": [{"_id": "id2", "_score": 7.5, "_source": {"metadata": {"data": "coffee"}}}]}},
+            ]
+        }
+
+        semantic, keyword = self.es_db.hybrid_search(
+            query="What do I drink?", keyword_query="drink", vectors=[0.1] * 1536, top_k=5, filters={"user_id": "u1"}
+        )
+
+        self.client_mock.search.assert_not_called()
+        searches = self.client_mock.msearch.call_args[1]["body"]
+        self.assertEqual(searches[0], {"index": "test_collection"})
+        self.assertEqual(searches[1]["knn"]["filter"], {"bool": {"must": [{"term": {"metadata.user_id": "u1"}}]}})
+        self.assertEqual(searches[3]["query"]["bool"]["should"][0], {"match": {"metadata.data": "drink"}})
+        self.assertEqual([(r.id, r.score) for r in semantic], [("id1", 0.9)])
+        self.assertEqual([(r.id, r.score) for r in keyword], [("id2", 7.5)])
+
+    def test_hybrid_search_keeps_semantic_hits_when_keyword_side_fails(self):
+        self.client_mock.msearch.return_value = {
+            "responses": [
+                {"hits": {"hits": [{"_id": "id1", "_score": 0.9, "_source": {"metadata": {}}}]}},
+                {"error": {"type": "query_shard_exception"}},
+            ]
+        }
+        semantic, keyword = self.es_db.hybrid_search(query="q", keyword_query="q", vectors=[0.1] * 1536)
+        self.assertEqual([r.id for r in semantic], ["id1"])
+        self.assertIsNone(keyword)
+
+    def test_search_batch_uses_msearch(self):
+        self.client_mock.msearch.return_value = {
+            "responses": [
+                {"hits": {"hits": [{"_id": "id1", "_score": 0.9, "_source": {"metadata": {}}}]}},
+                {"hits": {"hits": []}},
+            ]
+        }
+        results = self.es_db.search_batch(["a", "b"], [[0.1] * 1536, [0.2] * 1536], top_k=3)
+
+        self.client_mock.msearch.assert_called_once()
+        searches = self.client_mock.msearch.call_args[1]["body"]
+        self.assertEqual(len(searches), 4)
+        self.assertEqual(searches[3]["knn"]["query_vector"], [0.2] * 1536)
+        self.assertEqual([[r.id for r in hits] for hits in results], [["id1"], []])
+
     def test_custom_search_query(self):
         # Mock custom search query
         self.es_db.custom_search_query = Mock()
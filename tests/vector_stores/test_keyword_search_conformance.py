@@ -0,0 +1,87 @@
+"""Shared contract for ``VectorStoreBase.keyword_search``.
+
+Memory fuses keyword hits into every search: a store that inherits the base
+``keyword_search`` silently loses the BM25 term. Stores with a text engine
+must override it and return raw, positive BM25-scale scores best first, at
+most ``top_k`` of them, restricted by ``filters``; a query without matches
+gives ``[]`` and ``None`` is reserved for "no text index available".
+
+The behavioural checks run against an in-process Chroma collection; the
+other stores need a server and are covered by their own mocked tests.
+"""
+
+import importlib
+import uuid
+
+import pytest
+
+from mem0.vector_stores.base import VectorStoreBase
+
+STORES = [
+    ("mem0.vector_stores.cassandra", "CassandraDB", "cassandra"),
+    ("mem0.vector_stores.chroma", "ChromaDB", "chromadb"),
+    ("mem0.vector_stores.elasticsearch", "ElasticsearchDB", "elasticsearch"),
+    ("mem0.vector_stores.opensearch", "OpenSearchDB", "opensearchpy"),
+    ("mem0.vector_stores.pgvector", "PGVector", "psycopg2"),
+    ("mem0.vector_stores.supabase", "Supabase", "vecs"),
+    ("mem0.vector_stores.turbopuffer", "TurbopufferDB", "turbopuffer"),
+    ("mem0.vector_stores.valkey", "ValkeyDB", "valkey"),
+]
+
+
+@pytest.mark.parametrize("module, cls, dependency", STORES, ids=[s[2] for s in STORES])
+def test_store_overrides_keyword_search(module, cls, dependency):
+    pytest.importorskip(dependency)
+    store = getattr(importlib.import_module(module), cls)
+    assert store.keyword_search is not VectorStoreBase.keyword_search
+
+
+DOCS = {
+    "a": ("like green tea", {"user_id": "u1"}),
+    "b": ("drink tea every morning with tea biscuit", {"user_id": "u1"}),
+    "c": ("live in paris", {"user_id": "u1"}),
+    "d": ("green tea is good", {"user_id": "u2"}),
+}
+
+
+@pytest.fixture
+def chroma_store():
+    chromadb = pytest.importorskip("chromadb")
+    from mem0.vector_stores.chroma import ChromaDB
+
+    store = ChromaDB(collection_name=f"kw_{uuid.uuid4().hex[:8]}", client=chromadb.EphemeralClient())
+    ids = list(DOCS)
+    store.insert(
+        vectors=[[float(i), 1.0, 0.0] for i in range(len(ids))],
+        payloads=[{"data": text, "text_lemmatized": text, **meta} for text, meta in DOCS.values()],
+        ids=ids,
+    )
+    yield store
+    store.delete_col()
+
+
+def test_scores_are_positive_and_best_first(chroma_store):
+    results = chroma_store.keyword_search("green tea", top_k=10)
+
+    assert {r.id for r in results} == {"a", "b", "d"}
+    scores = [r.score for r in results]
+    assert all(s > 0 for s in scores) and scores == sorted(scores, reverse=True)
+    assert results[-1].id == "b"  # matches only one of the two terms
+    assert results[0].payload["data"] in {"like green tea", "green tea is good"}
+
+
+def test_top_k_and_filters_are_respected(chroma_store):
+    assert len(chroma_store.keyword_search("tea", top_k=1)) == 1
+    results = chroma_store.keyword_search("green tea", top_k=10, filters={"user_id": "u2"})
+    assert [r.id for r in results] == ["d"]
+
+
+def test_queries_without_matches_return_an_empty_list(chroma_store):
+    assert chroma_store.keyword_search("coffee", top_k=5) == []
+    assert chroma_store.keyword_search("", top_k=5) == []
+
+
+def test_payload_updates_keep_the_text_searchable(chroma_store):
+    chroma_store.update("c", payload={"data": "moved", "text_lemmatized": "move to tokyo", "user_id": "u1"})
+    assert [r.id for r in chroma_store.keyword_search("tokyo")] == ["c"]
+    assert chroma_store.keyword_search("paris") == []
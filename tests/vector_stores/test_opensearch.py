@@ -296,6 +296,50 @@ class TestOpenSearchDB(unittest.TestCase):
         self.assertEqual(results[0].score, 0.8)
         self.assertEqual(results[0].payload, {"key1": "value1"})
 
+    def test_ef_search_is_passed_as_method_parameter(self):
+        self.client_mock.search.return_value = {"hits": {"hits": []}}
+        self.os_db.search(query="", vectors=[0.1] * 1536, top_k=5)
+        knn = self.client_mock.search.call_args[1]["body"]["query"]["knn"]["vector_field"]
+        self.assertNotIn("method_parameters", knn)
+
+        self.os_db.ef_search = 256
+        self.os_db.search(query="", vectors=[0.1] * 1536, top_k=5)
+        knn = self.client_mock.search.call_args[1]["body"]["query"]["knn"]["vector_field"]
+        self.assertEqual(knn["method_parameters"], {"ef_search": 256})
+
+    def test_hybrid_search_is_one_msearch_with_both_raw_scores(self):
+        self.client_mock.msearch.return_value = {
+            "responses": [
+                {"hits": {"hits": [{"_score": 0.9, "_source": {"id": "id1", "payload": {"data": "tea"}}}]}},
+                {"hits": {"hits": [{"_score": 7.5, "_source": {"id": "id2", "payload": {"data": "coffee"}}}]}},
+            ]
+        }
+
+        semantic, keyword = self.os_db.hybrid_search(
+            query="What do I drink?", keyword_query="drink", vectors=[0.1] * 1536, top_k=5, filters={"user_id": "u1"}
+        )
+
+        self.client_mock.search.assert_not_called()
+        searches = self.client_mock.msearch.call_args[1]["body"]
+        self.assertEqual(searches[0], {"index": "test_collection"})
+        self.assertEqual(searches[1]["query"]["bool"]["filter"], [{"term": {"payload.user_id.keyword": "u1"}}])
+        self.assertEqual(searches[3]["query"]["bool"]["should"][0], {"match": {"payload.data": "drink"}})
+        self.assertEqual([(r.id, r.score) for r in semantic], [("id1", 0.9)])
+        self.assertEqual([(r.id, r.score) for r in keyword], [("id2", 7.5)])
+
+    def test_search_batch_uses_msearch(self):
+        self.client_mock.msearch.return_value = {
+            "responses": [
+                {"hits": {"hits": [{"_score": 0.9, "_source": {"id": "id1", "payload": {}}}]}},
+                {"error": {"type": "search_phase_execution_exception"}},
+            ]
+        }
+        results = self.os_db.search_batch(["a", "b"], [[0.1] * 1536, [0.2] * 1536], top_k=3)
+
+        self.client_mock.msearch.assert_called_once()
+        self.assertEqual(len(self.client_mock.msearch.call_args[1]["body"]), 4)
+        self.assertEqual([[r.id for r in hits] for hits in results], [["id1"], []])
+
     def test_list_returns_nested_list(self):
         mock_response = {
             "hits": {
@@ -158,3 +158,27 @@ def test_preprocess_filters(supabase_instance):
 
     # Test None filters
     assert supabase_instance._preprocess_filters(None) is None
+
+
+def test_keyword_search_uses_postgres_full_text_search(supabase_instance, mock_collection):
+    from sqlalchemy import Column, MetaData, String, Table
+    from sqlalchemy.dialects import postgresql
+
+    mock_collection.table = Table(
+        "test_collection", MetaData(), Column("id", String), Column("metadata", postgresql.JSONB), schema="vecs"
+    )
+    session = supabase_instance.db.Session.return_value.__enter__.return_value
+    session.execute.return_value.fetchall.return_value = [("id1", 0.4, {"data": "likes tea"})]
+
+    results = supabase_instance.keyword_search("tea", top_k=3, filters={"user_id": "u1"})
+
+    sql = str(session.execute.call_args.args[0].compile(dialect=postgresql.dialect()))
+    assert "to_tsvector('simple', vecs.test_collection.metadata ->> %(metadata_1)s" in sql
+    assert "plainto_tsquery('simple'" in sql and "ts_rank_cd" in sql
+    assert "metadata @> " in sql and "LIMIT" in sql
+    assert [(r.id, r.score) for r in results] == [("id1", 0.4)]
+
+
+def test_keyword_search_failure_disables_bm25(supabase_instance):
+    supabase_instance.db.Session.side_effect = Exception("connection refused")
+    assert supabase_instance.keyword_search("tea") is None
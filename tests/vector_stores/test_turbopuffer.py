@@ -330,6 +330,41 @@ class TestSearch:
         assert results == []
 
 
+# ── keyword_search ───────────────────────────────────────────────────
+
+
+class TestKeywordSearch:
+    def test_keyword_search_ranks_by_bm25(self, db):
+        mock_response = MagicMock()
+        mock_response.rows = [
+            _make_row("id1", dist=7.5, data="likes green tea"),
+            _make_row("id2", dist=2.0, data="tea"),
+        ]
+        db.namespace.query.return_value = mock_response
+
+        results = db.keyword_search("green tea", top_k=2, filters={"user_id": "u1"})
+
+        db.namespace.query.assert_called_once_with(
+            rank_by=("text_lemmatized", "BM25", "green tea"),
+            top_k=2,
+            include_attributes=True,
+            filters=("user_id", "Eq", "u1"),
+        )
+        assert [r.id for r in results] == ["id1", "id2"]
+        assert results[0].score == pytest.approx(7.5)
+
+    def test_keyword_search_without_text_index_returns_none(self, db):
+        db.namespace.query.side_effect = Exception("attribute is not full-text indexed")
+        assert db.keyword_search("tea") is None
+
+    def test_writes_declare_the_text_index(self, db):
+        db.insert([[0.1, 0.2, 0.3, 0.4]], [{"data": "tea", "text_lemmatized": "tea"}], ["id1"])
+        db.update("id1", payload={"data": "tea", "text_lemmatized": "tea"})
+
+        for call in db.namespace.write.call_args_list:
+            assert call[1]["schema"]["text_lemmatized"]["full_text_search"] is True
+
+
 # ── delete ───────────────────────────────────────────────────────────
 
 
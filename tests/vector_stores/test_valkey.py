@@ -1066,3 +1066,27 @@ def test_escape_tag_value_normal_strings(valkey_db):
 def test_escape_tag_value_hyphenated_user_id(valkey_db):
     """Hyphenated user IDs must have the hyphen escaped for exact-match."""
     assert valkey_db._escape_tag_value("user-123") == r"user\-123"
+
+
+def test_keyword_search_queries_text_lemmatized_field(valkey_db, mock_valkey_client):
+    mock_doc = MagicMock()
+    mock_doc.memory_id = "id1"
+    mock_doc.hash = "h"
+    mock_doc.memory = "likes green tea"
+    mock_doc.created_at = str(int(datetime.now().timestamp()))
+    mock_doc.metadata = json.dumps({})
+    mock_doc.score = "3.5"
+    mock_ft = mock_valkey_client.ft.return_value
+    mock_ft.search.return_value = MagicMock(docs=[mock_doc])
+
+    results = valkey_db.keyword_search("green tea green", top_k=3, filters={"user_id": "u1"})
+
+    query = mock_ft.search.call_args.args[0]
+    assert query.query_string() == "@user_id:{u1} @text_lemmatized:(green | tea)"
+    assert [r.id for r in results] == ["id1"] and results[0].score == 3.5
+    assert valkey_db.keyword_search("  ") == []
+
+
+def test_keyword_search_on_index_without_text_field_returns_none(valkey_db, mock_valkey_client):
+    mock_valkey_client.ft.return_value.search.side_effect = ResponseError("Unknown field")
+    assert valkey_db.keyword_search("tea") is None